@@ -0,0 +1,154 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef COMMON_BIGFRACTION_HH
+#define COMMON_BIGFRACTION_HH
+
+#include <awali/common/bigint.hh>
+
+namespace awali {
+
+  /** Rational numbers whose numerator and denominator are z64_t.
+   *
+   * Like q_fraction_t, the fields are public; the results of the
+   * arithmetic operations are reduced (the gcd of num and den is 1) and
+   * the denominator is positive.
+   */
+  class q64_t {
+  public:
+    z64_t num;
+    z64_t den;
+
+    q64_t()
+      : num(0), den(1)
+    {}
+
+    q64_t(z64_t n, z64_t d = 1)
+      : num(std::move(n)), den(std::move(d))
+    {}
+
+    /// Make the denominator positive and divide by the gcd.
+    q64_t& reduce()
+    {
+      if (den.is_negative())
+        {
+          num = -num;
+          den = -den;
+        }
+      if (den != 1)
+        {
+          z64_t g = gcd(num, den);
+          if (g != 1 && g != 0)
+            {
+              num /= g;
+              den /= g;
+            }
+        }
+      return *this;
+    }
+
+    bool operator==(const q64_t& w) const
+    {
+      // Reduced values have a unique representation.
+      return num == w.num && den == w.den;
+    }
+
+    bool operator!=(const q64_t& w) const
+    {
+      return !(*this == w);
+    }
+
+    bool operator<(const q64_t& w) const
+    {
+      return num * w.den < w.num * den;
+    }
+
+    q64_t operator+(const q64_t& o) const
+    {
+      return add_(o.num, o.den);
+    }
+
+    q64_t operator-(const q64_t& o) const
+    {
+      return add_(-o.num, o.den);
+    }
+
+    q64_t operator*(const q64_t& o) const
+    {
+      if (den == 1 && o.den == 1)
+        return {num * o.num, 1};
+      // Cross reduction keeps the factors small.
+      z64_t g1 = gcd(num, o.den), g2 = gcd(o.num, den);
+      if (g1 == 0 || g2 == 0)
+        return {};
+      return {(num / g1) * (o.num / g2), (den / g2) * (o.den / g1)};
+    }
+
+    q64_t operator/(const q64_t& o) const
+    {
+      if (o.num == 0)
+        throw std::domain_error("q64_t: division by zero");
+      return *this * q64_t(o.den, o.num).reduce();
+    }
+
+    double to_double() const
+    {
+      return num.to_double() / den.to_double();
+    }
+
+  private:
+    /// *this + n/d, with d > 0 and gcd(n, d) = 1.
+    q64_t add_(const z64_t& n, const z64_t& d) const
+    {
+      if (den == 1 && d == 1)
+        return {num + n, 1};
+      if (den == d)
+        return q64_t(num + n, d).reduce();
+      // Knuth, TAOCP vol. 2, 4.5.1.
+      z64_t g = gcd(den, d);
+      if (g == 1)
+        return {num * d + n * den, den * d};
+      z64_t t = num * (d / g) + n * (den / g);
+      z64_t g2 = gcd(t, g);
+      return {t / g2, (den / g) * (d / g2)};
+    }
+  };
+
+  inline std::ostream& operator<<(std::ostream& o, const q64_t& v)
+  {
+    o << v.num;
+    if (v.den != 1)
+      o << '/' << v.den;
+    return o;
+  }
+
+}//end of ns awali
+
+namespace std {
+
+  template<>
+  struct hash<awali::q64_t> {
+    size_t operator()(const awali::q64_t& f) const {
+      size_t res = 0;
+      std::hash_combine(res, f.num.hash());
+      std::hash_combine(res, f.den.hash());
+      return res;
+    }
+  };
+
+}//end of ns std
+
+#endif
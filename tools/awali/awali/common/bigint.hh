@@ -0,0 +1,627 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef COMMON_BIGINT_HH
+#define COMMON_BIGINT_HH
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <awali/utils/hash.hh>
+
+namespace awali {
+
+  /** Arbitrary precision integers.
+   *
+   * The value is stored as a sign and a magnitude; the magnitude is a
+   * vector of 32-bit limbs, the least significant first, without
+   * leading zero limbs (hence zero has no limb).
+   *
+   * This class implements the slow path of z64_t, which should be used
+   * instead.
+   */
+  class big_int_t {
+  public:
+    using limb_t = uint32_t;
+
+    big_int_t() = default;
+
+    explicit big_int_t(long long v)
+      : big_int_t(v < 0 ? 0ull - (unsigned long long) v
+                        : (unsigned long long) v, v < 0)
+    {}
+
+    /// The integer of magnitude \p m, negative if \p neg.
+    big_int_t(unsigned long long m, bool neg)
+      : neg_(neg)
+    {
+      for (; m != 0; m >>= 32)
+        mag_.push_back((limb_t) m);
+      if (mag_.empty())
+        neg_ = false;
+    }
+
+    /// Parse an optional sign followed by decimal digits.
+    static big_int_t from_string(const std::string& s)
+    {
+      size_t i = 0;
+      bool neg = false;
+      if (i < s.size() && (s[i] == '-' || s[i] == '+'))
+        neg = s[i++] == '-';
+      if (i == s.size())
+        throw std::invalid_argument("big_int_t: no digit in \"" + s + "\"");
+      big_int_t res;
+      while (i < s.size())
+        {
+          // Chunks of at most 9 digits.
+          limb_t chunk = 0, scale = 1;
+          for (unsigned k = 0; k < 9 && i < s.size(); ++k, ++i)
+            {
+              if (!std::isdigit(static_cast<unsigned char>(s[i])))
+                throw std::invalid_argument("big_int_t: invalid digit in \""
+                                            + s + "\"");
+              chunk = chunk * 10 + (s[i] - '0');
+              scale *= 10;
+            }
+          res.mul_add_small_(scale, chunk);
+        }
+      res.neg_ = neg && !res.mag_.empty();
+      return res;
+    }
+
+    bool is_zero() const { return mag_.empty(); }
+    bool is_negative() const { return neg_; }
+
+    /// Whether the value lies in the range of long long.
+    bool fits_int64() const
+    {
+      if (mag_.size() > 2)
+        return false;
+      unsigned long long m = magnitude64_();
+      return neg_ ? m <= (1ull << 63) : m < (1ull << 63);
+    }
+
+    /// The value, which must fit in 64 bits.
+    long long to_int64() const
+    {
+      unsigned long long m = magnitude64_();
+      return neg_ ? (long long) (0ull - m) : (long long) m;
+    }
+
+    double to_double() const
+    {
+      double res = 0;
+      for (size_t i = mag_.size(); i-- > 0; )
+        res = res * 4294967296.0 + mag_[i];
+      return neg_ ? -res : res;
+    }
+
+    std::string to_string() const
+    {
+      if (mag_.empty())
+        return "0";
+      std::string res;
+      big_int_t q = *this;
+      while (!q.mag_.empty())
+        {
+          limb_t r = q.div_small_(1000000000u);
+          for (unsigned k = 0; k < 9; ++k, r /= 10)
+            {
+              res.push_back(char('0' + r % 10));
+              if (q.mag_.empty() && r < 10)
+                break;
+            }
+        }
+      if (neg_)
+        res.push_back('-');
+      std::reverse(res.begin(), res.end());
+      return res;
+    }
+
+    /// -1, 0 or 1 as *this is less than, equal to or greater than \p o.
+    int compare(const big_int_t& o) const
+    {
+      if (neg_ != o.neg_)
+        return neg_ ? -1 : 1;
+      int c = cmp_mag_(mag_, o.mag_);
+      return neg_ ? -c : c;
+    }
+
+    big_int_t operator-() const
+    {
+      big_int_t res = *this;
+      res.neg_ = !res.mag_.empty() && !neg_;
+      return res;
+    }
+
+    friend big_int_t operator+(const big_int_t& l, const big_int_t& r)
+    {
+      return add_(l, r, r.neg_);
+    }
+
+    friend big_int_t operator-(const big_int_t& l, const big_int_t& r)
+    {
+      return add_(l, r, !r.neg_);
+    }
+
+    friend big_int_t operator*(const big_int_t& l, const big_int_t& r)
+    {
+      big_int_t res;
+      if (l.mag_.empty() || r.mag_.empty())
+        return res;
+      res.mag_.assign(l.mag_.size() + r.mag_.size(), 0);
+      for (size_t i = 0; i < l.mag_.size(); ++i)
+        {
+          uint64_t carry = 0;
+          for (size_t j = 0; j < r.mag_.size(); ++j)
+            {
+              uint64_t t = (uint64_t) l.mag_[i] * r.mag_[j]
+                + res.mag_[i + j] + carry;
+              res.mag_[i + j] = (limb_t) t;
+              carry = t >> 32;
+            }
+          res.mag_[i + r.mag_.size()] = (limb_t) carry;
+        }
+      res.trim_();
+      res.neg_ = l.neg_ != r.neg_;
+      return res;
+    }
+
+    /// Truncated division: \p a = \p q * \p b + \p r, where \p r has
+    /// the sign of \p a and |r| < |b|.
+    static void divmod(const big_int_t& a, const big_int_t& b,
+                       big_int_t& q, big_int_t& r)
+    {
+      if (b.mag_.empty())
+        throw std::domain_error("big_int_t: division by zero");
+      divmod_mag_(a.mag_, b.mag_, q.mag_, r.mag_);
+      q.neg_ = !q.mag_.empty() && a.neg_ != b.neg_;
+      r.neg_ = !r.mag_.empty() && a.neg_;
+    }
+
+    /// The residue of *this modulo \p p, in [0, p).
+    limb_t mod(limb_t p) const
+    {
+      uint64_t r = 0;
+      for (size_t i = mag_.size(); i-- > 0; )
+        r = ((r << 32) | mag_[i]) % p;
+      return neg_ && r ? p - (limb_t) r : (limb_t) r;
+    }
+
+    size_t hash() const
+    {
+      size_t res = 0;
+      std::hash_combine(res, neg_);
+      for (auto l : mag_)
+        std::hash_combine(res, l);
+      return res;
+    }
+
+  private:
+    using mag_t = std::vector<limb_t>;
+
+    bool neg_ = false;
+    mag_t mag_;
+
+    unsigned long long magnitude64_() const
+    {
+      unsigned long long m = 0;
+      if (mag_.size() > 0)
+        m = mag_[0];
+      if (mag_.size() > 1)
+        m |= (unsigned long long) mag_[1] << 32;
+      return m;
+    }
+
+    void trim_()
+    {
+      while (!mag_.empty() && mag_.back() == 0)
+        mag_.pop_back();
+      if (mag_.empty())
+        neg_ = false;
+    }
+
+    /// *this = *this * m + a, on the magnitude.
+    void mul_add_small_(limb_t m, limb_t a)
+    {
+      uint64_t carry = a;
+      for (auto& l : mag_)
+        {
+          uint64_t t = (uint64_t) l * m + carry;
+          l = (limb_t) t;
+          carry = t >> 32;
+        }
+      if (carry)
+        mag_.push_back((limb_t) carry);
+    }
+
+    /// Divide the magnitude by \p d, return the remainder.
+    limb_t div_small_(limb_t d)
+    {
+      uint64_t r = 0;
+      for (size_t i = mag_.size(); i-- > 0; )
+        {
+          uint64_t t = (r << 32) | mag_[i];
+          mag_[i] = (limb_t) (t / d);
+          r = t % d;
+        }
+      trim_();
+      return (limb_t) r;
+    }
+
+    static int cmp_mag_(const mag_t& a, const mag_t& b)
+    {
+      if (a.size() != b.size())
+        return a.size() < b.size() ? -1 : 1;
+      for (size_t i = a.size(); i-- > 0; )
+        if (a[i] != b[i])
+          return a[i] < b[i] ? -1 : 1;
+      return 0;
+    }
+
+    /// l + r, where the sign of r is taken to be \p rneg.
+    static big_int_t add_(const big_int_t& l, const big_int_t& r, bool rneg)
+    {
+      big_int_t res;
+      if (l.neg_ == rneg)
+        {
+          const mag_t& a = l.mag_.size() >= r.mag_.size() ? l.mag_ : r.mag_;
+          const mag_t& b = l.mag_.size() >= r.mag_.size() ? r.mag_ : l.mag_;
+          res.mag_.resize(a.size() + 1);
+          uint64_t carry = 0;
+          for (size_t i = 0; i < a.size(); ++i)
+            {
+              uint64_t t = (uint64_t) a[i] + (i < b.size() ? b[i] : 0) + carry;
+              res.mag_[i] = (limb_t) t;
+              carry = t >> 32;
+            }
+          res.mag_[a.size()] = (limb_t) carry;
+          res.neg_ = rneg;
+        }
+      else
+        {
+          int c = cmp_mag_(l.mag_, r.mag_);
+          if (c == 0)
+            return res;
+          const mag_t& a = c > 0 ? l.mag_ : r.mag_;
+          const mag_t& b = c > 0 ? r.mag_ : l.mag_;
+          res.mag_.resize(a.size());
+          int64_t borrow = 0;
+          for (size_t i = 0; i < a.size(); ++i)
+            {
+              int64_t t = (int64_t) a[i] - (i < b.size() ? b[i] : 0) - borrow;
+              borrow = t < 0;
+              res.mag_[i] = (limb_t) (t + (borrow << 32));
+            }
+          res.neg_ = c > 0 ? l.neg_ : rneg;
+        }
+      res.trim_();
+      return res;
+    }
+
+    /// Division of magnitudes (Knuth, TAOCP vol. 2, algorithm D).
+    static void divmod_mag_(const mag_t& u, const mag_t& v, mag_t& q, mag_t& r)
+    {
+      if (cmp_mag_(u, v) < 0)
+        {
+          r = u;
+          q.clear();
+          return;
+        }
+      size_t n = v.size(), m = u.size();
+      if (n == 1)
+        {
+          big_int_t t;
+          t.mag_ = u;
+          r.assign(1, t.div_small_(v[0]));
+          q = std::move(t.mag_);
+          if (r[0] == 0)
+            r.clear();
+          return;
+        }
+      // Normalize, so that the leading limb of the divisor has its
+      // high bit set.
+      unsigned s = 0;
+      for (limb_t top = v[n - 1]; !(top & 0x80000000u); top <<= 1)
+        ++s;
+      mag_t vn(n), un(m + 1);
+      for (size_t i = n - 1; i > 0; --i)
+        vn[i] = (v[i] << s) | (s ? (limb_t) ((uint64_t) v[i - 1] >> (32 - s)) : 0);
+      vn[0] = v[0] << s;
+      un[m] = s ? (limb_t) ((uint64_t) u[m - 1] >> (32 - s)) : 0;
+      for (size_t i = m - 1; i > 0; --i)
+        un[i] = (u[i] << s) | (s ? (limb_t) ((uint64_t) u[i - 1] >> (32 - s)) : 0);
+      un[0] = u[0] << s;
+      const uint64_t base = 1ull << 32;
+      q.assign(m - n + 1, 0);
+      for (size_t j = m - n + 1; j-- > 0; )
+        {
+          uint64_t num = ((uint64_t) un[j + n] << 32) | un[j + n - 1];
+          uint64_t qhat = num / vn[n - 1];
+          uint64_t rhat = num % vn[n - 1];
+          while (qhat >= base
+                 || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2]))
+            {
+              --qhat;
+              rhat += vn[n - 1];
+              if (rhat >= base)
+                break;
+            }
+          // Multiply and subtract.
+          int64_t k = 0, t;
+          for (size_t i = 0; i < n; ++i)
+            {
+              uint64_t p = qhat * vn[i];
+              t = (int64_t) un[i + j] - k - (int64_t) (p & 0xffffffffu);
+              un[i + j] = (limb_t) t;
+              k = (int64_t) (p >> 32) - (t >> 32);
+            }
+          t = (int64_t) un[j + n] - k;
+          un[j + n] = (limb_t) t;
+          q[j] = (limb_t) qhat;
+          if (t < 0)
+            {
+              // Add back.
+              --q[j];
+              uint64_t c = 0;
+              for (size_t i = 0; i < n; ++i)
+                {
+                  uint64_t t2 = (uint64_t) un[i + j] + vn[i] + c;
+                  un[i + j] = (limb_t) t2;
+                  c = t2 >> 32;
+                }
+              un[j + n] = (limb_t) (un[j + n] + c);
+            }
+        }
+      r.resize(n);
+      for (size_t i = 0; i < n; ++i)
+        r[i] = (un[i] >> s)
+          | (s ? (limb_t) ((uint64_t) un[i + 1] << (32 - s)) : 0);
+      while (!q.empty() && q.back() == 0)
+        q.pop_back();
+      while (!r.empty() && r.back() == 0)
+        r.pop_back();
+    }
+  };
+
+
+  /** Integers with a 64-bit fast path.
+   *
+   * As long as it fits in a long long, the value is a machine integer
+   * and the arithmetic operations check the overflows with the compiler
+   * builtins; on overflow, the result is promoted to a big_int_t.  A
+   * value which fits in a long long is always stored as a machine
+   * integer, hence the comparisons of machine values are immediate.
+   *
+   * The operators have the semantics of the operators on int; in
+   * particular, the division is truncated.
+   */
+  class z64_t {
+  public:
+    z64_t(long long v = 0)
+      : small_(v)
+    {}
+
+    z64_t(const big_int_t& b)
+    {
+      if (b.fits_int64())
+        small_ = b.to_int64();
+      else
+        big_ = std::make_shared<const big_int_t>(b);
+    }
+
+    /// Parse an optional sign followed by decimal digits.
+    static z64_t from_string(const std::string& s)
+    {
+      return big_int_t::from_string(s);
+    }
+
+    /// Whether the value is a machine integer.
+    bool is_small() const { return !big_; }
+
+    /// The machine value; only valid if is_small().
+    long long small() const { return small_; }
+
+    big_int_t to_big() const
+    {
+      return big_ ? *big_ : big_int_t(small_);
+    }
+
+    bool is_negative() const
+    {
+      return big_ ? big_->is_negative() : small_ < 0;
+    }
+
+    double to_double() const
+    {
+      return big_ ? big_->to_double() : (double) small_;
+    }
+
+    std::string to_string() const
+    {
+      return big_ ? big_->to_string() : std::to_string(small_);
+    }
+
+    /// The residue modulo \p p, in [0, p).
+    uint32_t mod(uint32_t p) const
+    {
+      if (big_)
+        return big_->mod(p);
+      long long r = small_ % (long long) p;
+      return (uint32_t) (r < 0 ? r + p : r);
+    }
+
+    size_t hash() const
+    {
+      return big_ ? big_->hash() : utils::hash_value(small_);
+    }
+
+    friend z64_t operator+(const z64_t& l, const z64_t& r)
+    {
+      long long res;
+      if (!l.big_ && !r.big_ && !__builtin_add_overflow(l.small_, r.small_, &res))
+        return res;
+      return l.to_big() + r.to_big();
+    }
+
+    friend z64_t operator-(const z64_t& l, const z64_t& r)
+    {
+      long long res;
+      if (!l.big_ && !r.big_ && !__builtin_sub_overflow(l.small_, r.small_, &res))
+        return res;
+      return l.to_big() - r.to_big();
+    }
+
+    friend z64_t operator*(const z64_t& l, const z64_t& r)
+    {
+      long long res;
+      if (!l.big_ && !r.big_ && !__builtin_mul_overflow(l.small_, r.small_, &res))
+        return res;
+      return l.to_big() * r.to_big();
+    }
+
+    friend z64_t operator/(const z64_t& l, const z64_t& r)
+    {
+      if (!l.big_ && !r.big_ && r.small_ != 0
+          && !(r.small_ == -1 && l.small_ == std::numeric_limits<long long>::min()))
+        return l.small_ / r.small_;
+      big_int_t q, rem;
+      big_int_t::divmod(l.to_big(), r.to_big(), q, rem);
+      return q;
+    }
+
+    friend z64_t operator%(const z64_t& l, const z64_t& r)
+    {
+      if (!l.big_ && !r.big_ && r.small_ != 0)
+        return r.small_ == -1 ? 0 : l.small_ % r.small_;
+      big_int_t q, rem;
+      big_int_t::divmod(l.to_big(), r.to_big(), q, rem);
+      return rem;
+    }
+
+    z64_t operator-() const
+    {
+      return z64_t(0) - *this;
+    }
+
+    z64_t& operator+=(const z64_t& o) { return *this = *this + o; }
+    z64_t& operator-=(const z64_t& o) { return *this = *this - o; }
+    z64_t& operator*=(const z64_t& o) { return *this = *this * o; }
+    z64_t& operator/=(const z64_t& o) { return *this = *this / o; }
+    z64_t& operator%=(const z64_t& o) { return *this = *this % o; }
+
+    friend bool operator==(const z64_t& l, const z64_t& r)
+    {
+      if (!l.big_ && !r.big_)
+        return l.small_ == r.small_;
+      // A big value is never equal to a machine value.
+      return l.big_ && r.big_ && l.big_->compare(*r.big_) == 0;
+    }
+
+    friend bool operator<(const z64_t& l, const z64_t& r)
+    {
+      if (!l.big_ && !r.big_)
+        return l.small_ < r.small_;
+      return l.to_big().compare(r.to_big()) < 0;
+    }
+
+    friend bool operator!=(const z64_t& l, const z64_t& r) { return !(l == r); }
+    friend bool operator>(const z64_t& l, const z64_t& r) { return r < l; }
+    friend bool operator<=(const z64_t& l, const z64_t& r) { return !(r < l); }
+    friend bool operator>=(const z64_t& l, const z64_t& r) { return !(l < r); }
+
+    // abs and gcd are only found by argument-dependent lookup, so that
+    // they do not hide the functions on machine integers.
+
+    friend z64_t abs(const z64_t& v)
+    {
+      return v.is_negative() ? -v : v;
+    }
+
+    /// The non-negative gcd of \p a and \p b.
+    friend z64_t gcd(z64_t a, z64_t b)
+    {
+      if (!a.big_ && !b.big_)
+        {
+          unsigned long long x = a.small_ < 0 ? 0ull - a.small_ : a.small_;
+          unsigned long long y = b.small_ < 0 ? 0ull - b.small_ : b.small_;
+          while (y)
+            {
+              unsigned long long t = x % y;
+              x = y;
+              y = t;
+            }
+          if (x <= (unsigned long long) std::numeric_limits<long long>::max())
+            return (long long) x;
+          return big_int_t(x, false);
+        }
+      a = abs(a);
+      b = abs(b);
+      while (b != 0)
+        {
+          z64_t t = a % b;
+          a = b;
+          b = t;
+        }
+      return a;
+    }
+
+  private:
+    long long small_ = 0;
+    std::shared_ptr<const big_int_t> big_;
+  };
+
+  inline std::ostream& operator<<(std::ostream& o, const z64_t& v)
+  {
+    return o << v.to_string();
+  }
+
+  inline std::istream& operator>>(std::istream& i, z64_t& v)
+  {
+    std::string s;
+    if (i.peek() == '-' || i.peek() == '+')
+      s.push_back((char) i.get());
+    while (std::isdigit(i.peek()))
+      s.push_back((char) i.get());
+    if (s.empty() || !std::isdigit(static_cast<unsigned char>(s.back())))
+      i.setstate(std::ios::failbit);
+    else
+      v = z64_t::from_string(s);
+    return i;
+  }
+
+}//end of ns awali
+
+namespace std {
+
+  template<>
+  struct hash<awali::z64_t> {
+    size_t operator()(const awali::z64_t& v) const {
+      return v.hash();
+    }
+  };
+
+}//end of ns std
+
+#endif
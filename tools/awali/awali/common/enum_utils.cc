@@ -67,6 +67,7 @@ namespace internal {
 
     REGISTER_ENUM_VALUE(minim_algo_t, DETERMINIZE_QUOTIENT);
     REGISTER_ENUM_VALUE(minim_algo_t, BRZOZOWSKI);
+    REGISTER_ENUM_VALUE(minim_algo_t, INCREMENTAL);
 
     REGISTER_ENUM_VALUE(quotient_algo_t, MOORE);
     REGISTER_ENUM_VALUE(quotient_algo_t, HOPCROFT);
@@ -94,6 +95,8 @@ namespace internal {
 
     REGISTER_ENUM_VALUE(state_elim_order_t, MIN_INOUT_DEGREE);
     REGISTER_ENUM_VALUE(state_elim_order_t, MIN_ID);
+    REGISTER_ENUM_VALUE(state_elim_order_t, MIN_EXP_SIZE);
+    REGISTER_ENUM_VALUE(state_elim_order_t, SCC_MIN_INOUT_DEGREE);
     REGISTER_ENUM_VALUE(state_elim_order_t, ID_ORDER);
 
     REGISTER_ENUM_VALUE(star_status_t, STARRABLE);
@@ -101,6 +104,15 @@ namespace internal {
     REGISTER_ENUM_VALUE(star_status_t, TOPS);
     REGISTER_ENUM_VALUE(star_status_t, ABSVAL);
 
+    REGISTER_ENUM_VALUE(ambiguity_t, UNAMBIGUOUS);
+    REGISTER_ENUM_VALUE(ambiguity_t, FINITELY_AMBIGUOUS);
+    REGISTER_ENUM_VALUE(ambiguity_t, POLYNOMIALLY_AMBIGUOUS);
+    REGISTER_ENUM_VALUE(ambiguity_t, EXPONENTIALLY_AMBIGUOUS);
+
+    REGISTER_ENUM_VALUE(scc_algo_t, TARJAN_ITERATIVE);
+    REGISTER_ENUM_VALUE(scc_algo_t, TARJAN_RECURSIVE);
+    REGISTER_ENUM_VALUE(scc_algo_t, FORWARD_BACKWARD);
+
 #undef REGISTER_ENUM_VALUE
     return map;
   }
@@ -255,6 +267,21 @@ std::string name_of(state_elim_order_t val)
   return internal::string_of_enum("state_elim_order_t", val);
 }
 
+std::string name_of(ambiguity_t val)
+{
+  return internal::string_of_enum("ambiguity_t", val);
+}
+
+scc_algo_t make_scc_algo(const std::string& value)
+{
+  return (scc_algo_t) internal::enum_of_string("scc_algo_t", value);
+}
+
+std::string name_of(scc_algo_t val)
+{
+  return internal::string_of_enum("scc_algo_t", val);
+}
+
 std::string default_extension_of(io_format_t val)
 {
   switch (val) {
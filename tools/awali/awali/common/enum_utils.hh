@@ -120,6 +120,29 @@ namespace awali {
    */
   std::string name_of(state_elim_order_t val);
 
+
+  /** Return the canonical string reprensation of given
+   * {@link ambiguity_t}.
+   */
+  std::string name_of(ambiguity_t val);
+
+
+  /** Builds a {@link scc_algo_t} from a string describing its name.
+   *
+   * @param name String-representation of the enum value to return;
+   * case-insensitive; char `'-'` or `'_'` can be used indifferently.
+   *
+   * @throws std::domain_error if @pname{name} does not represent any value of
+   * {@link scc_algo_t}
+   */
+  scc_algo_t make_scc_algo(std::string const& name);
+
+
+  /** Return the canonical string reprensation of given
+   * {@link scc_algo_t}.
+   */
+  std::string name_of(scc_algo_t val);
+
   namespace internal {
     
     using enum_join_t=long;
@@ -164,6 +187,8 @@ namespace awali {
     GENERATE_MAKE_ENUM(5,io_format_t)
     GENERATE_MAKE_ENUM(6,state_elim_order_t)
     GENERATE_MAKE_ENUM(7,star_status_t)
+    GENERATE_MAKE_ENUM(8,ambiguity_t)
+    GENERATE_MAKE_ENUM(9,scc_algo_t)
 
 
 #undef GENERATE_MAKE_ENUM
@@ -56,7 +56,10 @@ namespace awali {
     /** Determinizes, then computes the minimal quotient (see {@link quotient_algo_t}). */
     DETERMINIZE_QUOTIENT,
     /** Transposes, then determinizes, then transposes, then determinizes. */
-    BRZOZOWSKI
+    BRZOZOWSKI,
+    /** Determinizes and merges equivalent states on the fly, without
+     * building the whole deterministic automaton. */
+    INCREMENTAL
   };
 
 
@@ -114,6 +117,16 @@ namespace awali {
      * order).
      */
     MIN_ID,
+    /** States are eliminated by increasing estimate of the growth of the
+     * expression, that is the size of the transitions created by the
+     * elimination minus the size of the transitions it deletes.
+     */
+    MIN_EXP_SIZE,
+    /** The states of the strongly connected components with several
+     * states are eliminated first, component by component, then the
+     * other states; within each group, by increasing in-out degree.
+     */
+    SCC_MIN_INOUT_DEGREE,
     /// Alias to {@link MIN_ID}
 	ID_ORDER=MIN_ID
   };
@@ -158,6 +171,20 @@ namespace awali {
 
 
 
+  /** The different algorithms for computing strongly connected components.
+   */
+  enum scc_algo_t {
+    /** Tarjan's algorithm, with an explicit stack. */
+    TARJAN_ITERATIVE,
+    /** Tarjan's algorithm, recursive; may overflow the stack on large
+     * automata. */
+    TARJAN_RECURSIVE,
+    /** Forward-backward algorithm with trimming, run in parallel on all
+     * cores; meant for very large automata. */
+    FORWARD_BACKWARD
+  };
+
+
   /** The different behaviours a weightset may have with respect to the star.
    */
   enum star_status_t {
@@ -169,6 +196,21 @@ namespace awali {
   };
 
 
+  /** The degrees of ambiguity of an automaton, that is, the growth of
+   * the number of accepting runs of a word with respect to its length.
+   */
+  enum ambiguity_t {
+    /// Every word has at most one accepting run.
+    UNAMBIGUOUS,
+    /// The number of accepting runs of a word is bounded.
+    FINITELY_AMBIGUOUS,
+    /// The number of accepting runs is polynomial in the length.
+    POLYNOMIALLY_AMBIGUOUS,
+    /// The number of accepting runs is exponential in the length.
+    EXPONENTIALLY_AMBIGUOUS
+  };
+
+
   /** @brief The different kinds of history.
    *
    * This class represents the different kinds of history a state may have.
@@ -76,7 +76,8 @@ exception:: exception(std::string const& message, std::string const& caller,
                       node_t const* node) 
 : message(message), caller(caller), node(node)  
 {
-  this->path_to_root = node->path_to_root();
+  if (node != nullptr)
+    this->path_to_root = node->path_to_root();
   std::stringstream what_stream;
   if (caller != "")
     what_stream << "[" << caller << "] ";
@@ -55,6 +55,13 @@ namespace awali {
     }
 
 
+    namespace {
+      bool is_letter_labelset(context_t ctx)
+      {
+        return ctx->labelset_name().compare(0, 4, "lal_") == 0;
+      }
+    }
+
     automaton_t exp_to_aut(ratexp_t ratexp, options_t opt)
     {
       switch (opt[EXP_TO_AUT_ALGO]) {
@@ -65,6 +72,9 @@ namespace awali {
       case COMPACT_THOMPSON:
         return internal::compact_thompson(ratexp);
       case DERIVED_TERM:
+        // Derived terms are only defined over free labelsets.
+        if (!is_letter_labelset(ratexp->get_context()))
+          return min_quotient(internal::standard(ratexp), opt);
         return internal::derived_term(ratexp, opt);
       case WEIGHTED_THOMPSON:
         return internal::weighted_thompson(ratexp);
@@ -15,7 +15,10 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdio.h>
+#include <atomic>
+#include <exception>
 #include <fstream>
+#include <thread>
 
 #include <awali/dyn/loading/locations.hh>
 
@@ -120,6 +123,77 @@ namespace awali { namespace dyn {
     return internal::load(s,b,opts[IO_FORMAT]);
   }
 
+  namespace {
+    // Calls f(i) for every i < n on num_threads threads; the exception
+    // raised for the smallest i, if any, is rethrown.
+    template <typename F>
+    void parallel_for(size_t n, unsigned num_threads, F f)
+    {
+      if (num_threads == 0)
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+      std::vector<std::exception_ptr> errors(n);
+      std::atomic<size_t> next{0};
+      auto work = [&] {
+        for (size_t i; (i = next++) < n; )
+          try {
+            f(i);
+          }
+          catch (...) {
+            errors[i] = std::current_exception();
+          }
+      };
+      std::vector<std::thread> workers;
+      for (unsigned t = 1; t < num_threads && t < n; ++t)
+        workers.emplace_back(work);
+      work();
+      for (auto& w : workers)
+        w.join();
+      for (auto& e : errors)
+        if (e)
+          std::rethrow_exception(e);
+    }
+  }
+
+  std::vector<automaton_t>
+  load_all(const std::vector<std::string>& paths, options_t opts,
+           unsigned num_threads)
+  {
+    size_t n = paths.size();
+    std::vector<automaton_t> res(n);
+    if (!is_true_json(opts[IO_FORMAT])) {
+      parallel_for(n, num_threads,
+                   [&](size_t i) { res[i] = load(paths[i], opts); });
+      return res;
+    }
+    // The examples are looked up once for all the files.
+    std::map<std::string,loading::file_loc_t> examples
+      = loading::examples({"automata","ratexps"}, true);
+    std::vector<json_ast_t> asts(n);
+    parallel_for(n, num_threads, [&](size_t i) {
+      auto it = examples.find(paths[i]);
+      if (it == examples.end())
+        asts[i] = json_ast::from_file(paths[i]);
+      else
+        asts[i] = json_ast::from_file(it->second.dir + "/" + it->second.name
+                                      + "." + it->second.ext);
+    });
+    // The modules are loaded, and compiled if necessary, by this thread.
+    std::vector<std::function<automaton_t()>> parsers;
+    for (size_t i = 0; i < n; ++i)
+      try {
+        parsers.push_back(internal::automaton_parser(asts[i]));
+      }
+      catch (std::runtime_error const& e) {
+        throw std::runtime_error(paths[i] + ": " + e.what());
+      }
+    parallel_for(n, num_threads, [&](size_t i) {
+      res[i] = parsers[i]();
+      parsers[i] = nullptr; // releases the AST
+      asts[i] = nullptr;
+    });
+    return res;
+  }
+
   ratexp_t load_exp(const std::string& s) {
     bool b;
     return internal::parse_ratexp(internal::load_json_ast(b,s,true));
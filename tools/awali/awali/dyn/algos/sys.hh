@@ -85,6 +85,21 @@ namespace dyn {
    */
   automaton_t load(const std::string& path, options_t opts={});
 
+  /** Loads the automata from the files pointed by \p paths.
+   *
+   * The files are read and parsed concurrently by \p num_threads threads
+   * (one per core if \p num_threads is 0).  The contexts of all the
+   * automata are checked, and the corresponding modules are loaded, before
+   * any automaton is built.
+   * @param paths
+   * @param opts A set of options; {@link IO_FORMAT} is meaningful.
+   * @param num_threads
+   * @return The new automata, in the order of \p paths.
+   */
+  std::vector<automaton_t> load_all(const std::vector<std::string>& paths,
+                                    options_t opts={},
+                                    unsigned num_threads=0);
+
   /** Loads a \ref ratexp_t from file @pname{filepath} */
   ratexp_t load_exp(const std::string& filepath);
   
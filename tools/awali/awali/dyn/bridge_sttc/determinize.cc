@@ -48,6 +48,10 @@ namespace awali {
       throw std::runtime_error("complement only supported for NFA");
     }
 
+    static dyn::automaton_t complement_nfa(dyn::automaton_t, bool, bool) {
+      throw std::runtime_error("complement only supported for NFA");
+    }
+
     static void complement_here(dyn::automaton_t) {
       throw std::runtime_error("complement_here only supported for DFA");
     }
@@ -65,6 +69,12 @@ namespace awali {
       return dyn::make_automaton(sttc::complement(a));
     }
 
+    static dyn::automaton_t complement_nfa(dyn::automaton_t aut, bool minimal,
+                                           bool history) {
+      auto a=dyn::get_stc_automaton<context_t>(aut);
+      return dyn::make_automaton(sttc::complement_nfa(a, minimal, history));
+    }
+
     static void complement_here(dyn::automaton_t aut) {
       auto a=dyn::get_stc_automaton<context_t>(aut);
       sttc::complement_here(a);
@@ -99,6 +109,12 @@ namespace awali {
     static bool is_ambiguous(dyn::automaton_t){
       throw std::runtime_error("is-ambiguous only supported for automata labelled with letters and no epsilon-transitions allowed.");
     }
+    static bool is_ambiguous(dyn::automaton_t, dyn::any_t&){
+      throw std::runtime_error("is-ambiguous only supported for automata labelled with letters and no epsilon-transitions allowed.");
+    }
+    static ambiguity_t ambiguity_degree(dyn::automaton_t){
+      throw std::runtime_error("ambiguity degree only supported for automata labelled with letters and no epsilon-transitions allowed.");
+    }
     static dyn::automaton_t weighted_determinize(dyn::automaton_t) {
       throw std::runtime_error("weighted determinization only supported for automata labelled with letters and no epsilon-transitions allowed.");
     }
@@ -136,6 +152,12 @@ namespace awali {
     static bool is_ambiguous(dyn::automaton_t) {
       throw std::runtime_error("is-ambiguous only supported for automata labelled with letters and no epsilon-transitions allowed.");
     }
+    static bool is_ambiguous(dyn::automaton_t, dyn::any_t&) {
+      throw std::runtime_error("is-ambiguous only supported for automata labelled with letters and no epsilon-transitions allowed.");
+    }
+    static ambiguity_t ambiguity_degree(dyn::automaton_t) {
+      throw std::runtime_error("ambiguity degree only supported for automata labelled with letters and no epsilon-transitions allowed.");
+    }
     static dyn::automaton_t weighted_determinize(dyn::automaton_t)  {
       throw std::runtime_error("weighted determinization only supported for automata labelled with letters and no epsilon-transitions allowed.");
     }
@@ -180,6 +202,20 @@ namespace awali {
       return sttc::is_ambiguous(a);
     }
 
+    static bool is_ambiguous(dyn::automaton_t aut, dyn::any_t& witness){
+      auto a=dyn::get_stc_automaton<context_t>(aut);
+      typename sttc::labelset_t_of<decltype(a)>::word_t w;
+      if (!sttc::is_ambiguous(a, w))
+        return false;
+      witness = w;
+      return true;
+    }
+
+    static ambiguity_t ambiguity_degree(dyn::automaton_t aut){
+      auto a=dyn::get_stc_automaton<context_t>(aut);
+      return sttc::ambiguity_degree(a);
+    }
+
     static dyn::automaton_t weighted_determinize(dyn::automaton_t aut) {
       auto a=dyn::get_stc_automaton<context_t>(aut);
       return dyn::make_automaton(sttc::weighted_determinize(a));
@@ -250,6 +286,11 @@ namespace awali {
     return dispatch_B<context_t>::complement(aut);
   }
 
+  extern "C" dyn::automaton_t complement_nfa(dyn::automaton_t aut,
+                                             bool minimal, bool history) {
+    return dispatch_B<context_t>::complement_nfa(aut, minimal, history);
+  }
+
   extern "C" void complement_here(dyn::automaton_t aut) {
     dispatch_B<context_t>::complement_here(aut);
   }
@@ -286,6 +327,14 @@ namespace awali {
     return dispatch_LAL<context_t>::is_ambiguous(aut);
   }
 
+  extern "C" bool is_ambiguous_with_witness(dyn::automaton_t aut, dyn::any_t& witness) {
+    return dispatch_LAL<context_t>::is_ambiguous(aut, witness);
+  }
+
+  extern "C" ambiguity_t ambiguity_degree(dyn::automaton_t aut) {
+    return dispatch_LAL<context_t>::ambiguity_degree(aut);
+  }
+
   extern "C" dyn::automaton_t weighted_determinize(dyn::automaton_t aut) {
     return dispatch_LAL<context_t>::weighted_determinize(aut);
   }
@@ -16,6 +16,7 @@
 
 #include <awali/sttc/algos/enumerate.hh>
 #include <awali/sttc/algos/eval.hh>
+#include <awali/dyn/modules/eval.hh>
 #include <awali/dyn/bridge_sttc/explicit_automaton.cc>
 #include <awali/common/priority.hh>
 #include<set-types.hh>
@@ -112,6 +113,51 @@ namespace awali {
     return internal::shortest<context_t>(aut,max,priority::value);
   }
 
+
+  namespace internal {
+    template <typename Aut>
+    class word_enumerator : public dyn::abstract_word_enumerator_t {
+    public:
+      word_enumerator(const Aut& aut, unsigned max_length)
+        : enumerater_(sttc::lazy_enumerate(aut, max_length))
+      {}
+
+      bool next(dyn::any_t& word, dyn::weight_t& weight) override
+      {
+        typename sttc::internal::lazy_enumerater<Aut>::word_t w;
+        typename sttc::internal::lazy_enumerater<Aut>::weight_t k;
+        if (!enumerater_.next(w, k))
+          return false;
+        word = w;
+        weight = k;
+        return true;
+      }
+
+    private:
+      sttc::internal::lazy_enumerater<Aut> enumerater_;
+    };
+
+    template <typename C, typename T>
+    dyn::word_enumerator_t
+    lazy_enumerate(dyn::automaton_t aut, unsigned max_length, priority::ONE<T>)
+    {
+      throw std::runtime_error("lazy_enumerate only supported for free label-sets with no epsilon-transitions allowed.");
+    }
+
+    template <typename C, typename T>
+    auto lazy_enumerate(dyn::automaton_t aut, unsigned max_length, priority::TWO<T>)
+    -> typename std::enable_if< C::labelset_t::is_free(),
+                                dyn::word_enumerator_t>::type
+    {
+      auto a=dyn::get_stc_automaton<C>(aut);
+      return std::make_shared<word_enumerator<decltype(a)>>(a, max_length);
+    }
+  }
+
+  extern "C" dyn::word_enumerator_t lazy_enumerate(dyn::automaton_t aut, unsigned max_length) {
+    return internal::lazy_enumerate<context_t>(aut, max_length, priority::value);
+  }
+
 }
 
 #include <awali/dyn/core/any.cc>
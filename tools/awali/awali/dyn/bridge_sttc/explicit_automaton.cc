@@ -17,8 +17,10 @@
 #ifndef DYN_EXPLICIT_AUTOMATON_CC
 #define DYN_EXPLICIT_AUTOMATON_CC
 
+#include<limits>
 #include<sstream>
 #include<stdexcept>
+#include<typeinfo>
 
 
 #include <awali/sttc/core/transpose_view.hh>
@@ -48,6 +50,92 @@ namespace awali { namespace dyn {
           a, *(aut_->context().labelset()));
     }
 
+    using label_value_t = typename Context::labelset_t::value_t;
+    using weight_value_t = typename Context::weightset_t::value_t;
+
+    /* Typed labels and weights (char or int) are used directly when they
+     * have the type of the values of the automaton, and converted through
+     * any_t otherwise.
+     */
+    template <typename T>
+    label_value_t typed_l(T x, std::true_type) const {
+      return x;
+    }
+
+    template <typename T>
+    label_value_t typed_l(T x, std::false_type) const {
+      dyn::any_t a(x);
+      return l(a);
+    }
+
+    template <typename T>
+    label_value_t typed_l(T x) const {
+      return typed_l(x, std::is_same<label_value_t, T>{});
+    }
+
+    template <typename T>
+    weight_value_t typed_w(T x, std::true_type) const {
+      return x;
+    }
+
+    template <typename T>
+    weight_value_t typed_w(T x, std::false_type) const {
+      dyn::any_t a(x);
+      return w(a);
+    }
+
+    template <typename T>
+    weight_value_t typed_w(T x) const {
+      return typed_w(x, std::is_same<weight_value_t, T>{});
+    }
+
+    /* Conversely, arithmetic values are cast to the requested type if they
+     * are exactly representable in it, and the other ones go through
+     * any_cast; both throw an any_cast_exception otherwise.
+     */
+    template <typename T>
+    static bool is_negative(T x, std::true_type) {
+      return x < T(0);
+    }
+
+    template <typename T>
+    static bool is_negative(T, std::false_type) {
+      return false;
+    }
+
+    template <typename T>
+    static bool is_negative(T x) {
+      return is_negative(x, std::is_signed<T>{});
+    }
+
+    template <typename T, typename V>
+    static T untyped(const V& v, std::true_type) {
+      // Casting a floating point value out of the range of an integer type
+      // is undefined, hence the range is checked first.
+      bool ok = !std::is_floating_point<V>::value
+        || std::is_floating_point<T>::value
+        || (v >= static_cast<V>(std::numeric_limits<T>::min())
+            && v <= static_cast<V>(std::numeric_limits<T>::max()));
+      T res = ok ? static_cast<T>(v) : T();
+      if (!ok || static_cast<V>(res) != v || is_negative(res) != is_negative(v)) {
+        std::stringstream ss;
+        ss << "Value " << v << " cannot be converted exactly to "
+           << awali::internal::demangle(typeid(T).name()) << ".";
+        throw dyn::any_cast_exception(ss.str());
+      }
+      return res;
+    }
+
+    template <typename T, typename V>
+    static T untyped(const V& v, std::false_type) {
+      return dyn::internal::any_cast<T>(dyn::any_t(v));
+    }
+
+    template <typename T, typename V>
+    static T untyped(const V& v) {
+      return untyped<T>(v, std::is_arithmetic<V>{});
+    }
+
     sttc::mutable_automaton<Context> aut_;
 
     explicit_automaton_t(sttc::mutable_automaton<Context> aut) :
@@ -162,6 +250,18 @@ namespace awali { namespace dyn {
      return sttc::is_epsilon<typename Context::labelset_t>(aut_->label_of(tr));
     }
 
+    char label_of_char(unsigned tr) const override {
+      return untyped<char>(aut_->label_of(tr));
+    }
+
+    int label_of_int(unsigned tr) const override {
+      return untyped<int>(aut_->label_of(tr));
+    }
+
+    int weight_of_int(unsigned tr) const override {
+      return untyped<int>(aut_->weight_of(tr));
+    }
+
 
     bool has_explicit_name(unsigned s) const override 
     {
@@ -229,6 +329,30 @@ namespace awali { namespace dyn {
       return sttc::set_epsilon_trans(aut_, src, dst);
     }
 
+    unsigned
+    set_transition_char(unsigned src, unsigned dst, char label) override {
+      return aut_->set_transition(src, dst, typed_l(label));
+    }
+
+    unsigned
+    set_transition_char(unsigned src, unsigned dst, char label, int weight)
+    override
+    {
+      return aut_->set_transition(src, dst, typed_l(label), typed_w(weight));
+    }
+
+    unsigned
+    set_transition_int(unsigned src, unsigned dst, int label) override {
+      return aut_->set_transition(src, dst, typed_l(label));
+    }
+
+    unsigned
+    set_transition_int(unsigned src, unsigned dst, int label, int weight)
+    override
+    {
+      return aut_->set_transition(src, dst, typed_l(label), typed_w(weight));
+    }
+
 
     dyn::any_t 
     add_transition(unsigned src, unsigned dst, dyn::any_t label, 
@@ -251,6 +375,30 @@ namespace awali { namespace dyn {
       return sttc::add_epsilon_trans(aut_,src, dst);
     }
 
+    dyn::any_t
+    add_transition_char(unsigned src, unsigned dst, char label) override {
+      return aut_->add_transition(src, dst, typed_l(label));
+    }
+
+    dyn::any_t
+    add_transition_char(unsigned src, unsigned dst, char label, int weight)
+    override
+    {
+      return aut_->add_transition(src, dst, typed_l(label), typed_w(weight));
+    }
+
+    dyn::any_t
+    add_transition_int(unsigned src, unsigned dst, int label) override {
+      return aut_->add_transition(src, dst, typed_l(label));
+    }
+
+    dyn::any_t
+    add_transition_int(unsigned src, unsigned dst, int label, int weight)
+    override
+    {
+      return aut_->add_transition(src, dst, typed_l(label), typed_w(weight));
+    }
+
     dyn::any_t set_weight(unsigned tr, dyn::any_t weight) override {
       return aut_->set_weight(tr, w(weight));
     }
@@ -284,6 +432,20 @@ namespace awali { namespace dyn {
       return states;
     }
 
+    void fill_states(std::vector<dyn::state_t>& res, bool all) const override {
+      res.clear();
+      for (dyn::state_t s : all ? aut_->all_states() : aut_->states())
+        res.push_back(s);
+    }
+
+    void fill_transitions(std::vector<dyn::transition_t>& res,
+                          bool all) const override {
+      res.clear();
+      for (dyn::transition_t t : all ? aut_->all_transitions()
+                                     : aut_->transitions()     )
+        res.push_back(t);
+    }
+
 //     std::vector<dyn::transition_t> 
 //     out(state_t s, dyn::options_t opt) const 
 //     {
@@ -415,6 +577,44 @@ namespace awali { namespace dyn {
       return res;
     }
 
+    dyn::transition_span_t transitions_of(unsigned s) const override {
+      const auto& ts = aut_->all_out(s);
+      return {ts.data(), ts.data() + ts.size()};
+    }
+
+    dyn::transition_span_t transitions_into(unsigned s) const override {
+      const auto& ts = aut_->all_in(s);
+      return {ts.data(), ts.data() + ts.size()};
+    }
+
+    dyn::automaton_snapshot_t snapshot() const override {
+      dyn::automaton_snapshot_t res;
+      res.states.reserve(aut_->num_states());
+      for (dyn::state_t s : aut_->states())
+        res.states.push_back(s);
+      // Index of each state identifier; states are in increasing order.
+      std::vector<unsigned> index(res.states.empty()
+                                  ? 0 : res.states.back() + 1);
+      for (unsigned i = 0; i < res.states.size(); ++i)
+        index[res.states[i]] = i;
+      res.out_begin.reserve(res.states.size() + 1);
+      res.transitions.reserve(aut_->num_transitions());
+      res.dsts.reserve(aut_->num_transitions());
+      for (dyn::state_t s : res.states) {
+        res.out_begin.push_back(res.transitions.size());
+        for (dyn::transition_t t : aut_->out(s)) {
+          res.transitions.push_back(t);
+          res.dsts.push_back(index[aut_->dst_of(t)]);
+        }
+      }
+      res.out_begin.push_back(res.transitions.size());
+      for (dyn::transition_t t : aut_->initial_transitions())
+        res.initials.push_back(index[aut_->dst_of(t)]);
+      for (dyn::transition_t t : aut_->final_transitions())
+        res.finals.push_back(index[aut_->src_of(t)]);
+      return res;
+    }
+
     std::vector<dyn::any_t> alphabet() const override {
       std::vector<dyn::any_t> res;
       for(auto l : aut_->labelset()->genset())
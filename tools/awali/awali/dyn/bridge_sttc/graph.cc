@@ -39,14 +39,23 @@ namespace awali {
   }
 
 
+  extern "C"
+  std::pair< std::unordered_map<dyn::state_t, dyn::state_t>,
+             std::vector<std::vector<dyn::state_t>> >
+  scc(dyn::automaton_t aut, scc_algo_t algo) {
+    auto a=dyn::get_stc_automaton<context_t>(aut);
+    return sttc::scc(a, algo);
+  }
+
+
   extern "C"
   std::pair< dyn::automaton_t,
              std::pair< std::unordered_map<dyn::state_t, dyn::state_t>,
                         std::vector<std::vector<dyn::state_t>> >  >
-  condensation (dyn::automaton_t aut)
+  condensation (dyn::automaton_t aut, scc_algo_t algo)
   {
     auto a=dyn::get_stc_automaton<context_t>(aut);
-    auto res= sttc::condensation(a);
+    auto res= sttc::condensation(a, algo);
     return { dyn::make_automaton(res.first), std::move(res.second) };
   }
 
@@ -23,6 +23,7 @@
 #include <awali/sttc/algos/is_quotient.hh>
 #include <awali/sttc/algos/merge.hh>
 #include <awali/sttc/algos/min_quotient.hh>
+#include <awali/sttc/algos/minimize_incremental.hh>
 #include <awali/sttc/algos/proper.hh>
 #include <awali/sttc/labelset/traits.hh>
 #include <awali/sttc/weightset/b.hh>
@@ -86,6 +87,10 @@ namespace awali {
 	  sttc::complete_here(a);
           break;
         }
+        case INCREMENTAL:{
+          a=sttc::minimize_incremental(a);
+          break;
+        }
         case DETERMINIZE_QUOTIENT: {
           if(!sttc::is_deterministic(a))
             a=determinize(a);
@@ -124,6 +129,10 @@ namespace awali {
 	  sttc::complete_here(a);
           break;
         }
+        case INCREMENTAL:{
+          a=sttc::minimize_incremental(a);
+          break;
+        }
         case DETERMINIZE_QUOTIENT: {
           if(!sttc::is_deterministic(a))
             a=determinize(a);
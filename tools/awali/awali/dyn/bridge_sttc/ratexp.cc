@@ -50,6 +50,12 @@ namespace awali {
       return make_ratexp(sttc::aut_to_exp_in_order(a), rs);
   }
 
+  extern "C" dyn::ratexp_t aut_to_exp_ordered(dyn::automaton_t aut, state_elim_order_t order) {
+      auto a = dyn::get_stc_automaton<context_t>(aut);
+      auto rs = std::make_shared<ratexpset_t>(sttc::get_rat_context(a->context()),ratexpset_t::identities_t::trivial);
+      return make_ratexp(sttc::aut_to_exp(a, order), rs);
+  }
+
   extern "C" dyn::automaton_t lift(dyn::automaton_t aut) {
       auto a = dyn::get_stc_automaton<context_t>(aut);
       return dyn::make_automaton(sttc::lift(a));
@@ -27,6 +27,7 @@
 #include <awali/sttc/algos/letterize_tape.hh>
 #include <awali/sttc/algos/proper.hh>
 #include <awali/sttc/algos/is_of_finite_image.hh>
+#include <awali/sttc/algos/lazy_compose.hh>
 #include <awali/sttc/labelset/letterset.hh>
 #include <awali/sttc/labelset/nullableset.hh>
 #include <awali/sttc/labelset/wordset.hh>
@@ -250,6 +251,10 @@ namespace awali {
     static dyn::automaton_t realtime(dyn::automaton_t tdc) {
       throw std::runtime_error("realtime only supported for transducer with char letters");
     }
+
+    static dyn::automaton_t compose_all(const std::vector<dyn::automaton_t>& tdcs) {
+      throw std::runtime_error("compose_all only supported for transducer with char letters");
+    }
   };
 
   template<typename W>
@@ -273,6 +278,13 @@ namespace awali {
       auto td = dyn::get_stc_automaton<context_t>(tdc);
       return dyn::make_automaton(sttc::realtime(td));
     }
+
+    static dyn::automaton_t compose_all(const std::vector<dyn::automaton_t>& tdcs) {
+      std::vector<decltype(dyn::get_stc_automaton<context_t>(tdcs[0]))> tds;
+      for (const auto& tdc : tdcs)
+        tds.emplace_back(dyn::get_stc_automaton<context_t>(tdc));
+      return dyn::make_automaton(sttc::materialize(sttc::compose_all(tds)));
+    }
   };
   
   extern "C" bool is_functional(dyn::automaton_t tdc) {
@@ -291,6 +303,10 @@ namespace awali {
     return dispatch_TDC<context_t>::realtime(tdc);
   }
 
+  extern "C" dyn::automaton_t compose_all(const std::vector<dyn::automaton_t>& tdcs) {
+    return dispatch_TDC<context_t>::compose_all(tdcs);
+  }
+
   extern "C" bool is_realtime(dyn::automaton_t tdc) {
     auto td = dyn::get_stc_automaton<context_t>(tdc);
     return sttc::is_realtime(td);
@@ -36,6 +36,35 @@
 
 namespace awali { namespace dyn {
 
+  /** Flat copy of the graph of an automaton, in compressed sparse row form.
+   *
+   * The states are numbered from 0 to `num_states()-1`, in increasing
+   * order of their identifiers.  The transitions going out of the state
+   * with index `i` are at positions `out_begin[i]` to `out_begin[i+1]-1`
+   * of #transitions and #dsts.  Initial and final transitions are not
+   * stored, the indices of initial and final states are listed instead.
+   *
+   * A snapshot is not updated when the automaton is modified.
+   */
+  struct automaton_snapshot_t {
+    /** Identifiers of the states, by index. */
+    std::vector<state_t> states;
+    /** Offsets of the outgoing transitions of each state; its size is
+     * `num_states()+1`. */
+    std::vector<unsigned> out_begin;
+    /** Identifiers of the transitions, grouped by source. */
+    std::vector<transition_t> transitions;
+    /** Indices of the destinations of the transitions. */
+    std::vector<unsigned> dsts;
+    /** Indices of the initial states. */
+    std::vector<unsigned> initials;
+    /** Indices of the final states. */
+    std::vector<unsigned> finals;
+
+    size_t num_states() const { return states.size(); }
+    size_t num_transitions() const { return transitions.size(); }
+  };
+
   /** 
   Abstract interface listing the services provided by automata at the
   dynamical layer.
@@ -264,6 +293,23 @@ namespace awali { namespace dyn {
     /** Returns `true` if transition @pname{t} is an epsilon-transition */
     virtual bool is_eps_transition(transition_t t) const = 0;
 
+    /** Returns the label of transition @pname{t} as a char.
+     *
+     * The label is not boxed into a {@link label_t} if the labels of this
+     * {@link abstract_automaton_t} are characters; otherwise, the label is
+     * converted, which throws an {@link any_cast_exception} if it is not
+     * exactly representable as a char.
+     */
+    virtual char label_of_char(transition_t t) const = 0;
+
+    /** Returns the label of transition @pname{t} as an int; see
+     * {@link label_of_char}. */
+    virtual int label_of_int(transition_t t) const = 0;
+
+    /** Returns the weight of transition @pname{t} as an int; see
+     * {@link label_of_char}. */
+    virtual int weight_of_int(transition_t t) const = 0;
+
    
     /** Sets (and possibly replaces) a transition going from @pname{src}
      * to @pname{dst}, labelled by @pname{label} and with weight @pname{weight}.
@@ -306,6 +352,30 @@ namespace awali { namespace dyn {
      */
     virtual transition_t set_eps_transition(state_t src, state_t dst) = 0;
 
+    /** Same as #set_transition(state_t,state_t,label_t), for a char label.
+     *
+     * If the labels of this {@link abstract_automaton_t} are characters,
+     * the label is not boxed into a {@link label_t}; this is the fast way to
+     * build automata over letters.
+     */
+    virtual transition_t set_transition_char(state_t src, state_t dst,
+                                             char label) = 0;
+
+    /** Same as #set_transition(state_t,state_t,label_t,weight_t), for a
+     * char label and an int weight; see {@link set_transition_char}. */
+    virtual transition_t set_transition_char(state_t src, state_t dst,
+                                             char label, int weight) = 0;
+
+    /** Same as #set_transition(state_t,state_t,label_t), for an int label;
+     * see {@link set_transition_char}. */
+    virtual transition_t set_transition_int(state_t src, state_t dst,
+                                            int label) = 0;
+
+    /** Same as #set_transition(state_t,state_t,label_t,weight_t), for an
+     * int label and an int weight; see {@link set_transition_char}. */
+    virtual transition_t set_transition_int(state_t src, state_t dst,
+                                            int label, int weight) = 0;
+
     /** Sets an epsilon transition going from @pname{src} to @pname{dst} and
      * weighted by @pname{weight}.
      *
@@ -373,6 +443,26 @@ namespace awali { namespace dyn {
     virtual weight_t add_eps_transition(state_t src, state_t dst, 
                                         weight_t weight) = 0;
 
+    /** Same as #add_transition(state_t,state_t,label_t), for a char label;
+     * see {@link set_transition_char}. */
+    virtual weight_t add_transition_char(state_t src, state_t dst,
+                                         char label) = 0;
+
+    /** Same as #add_transition(state_t,state_t,label_t,weight_t), for a
+     * char label and an int weight; see {@link set_transition_char}. */
+    virtual weight_t add_transition_char(state_t src, state_t dst,
+                                         char label, int weight) = 0;
+
+    /** Same as #add_transition(state_t,state_t,label_t), for an int label;
+     * see {@link set_transition_char}. */
+    virtual weight_t add_transition_int(state_t src, state_t dst,
+                                        int label) = 0;
+
+    /** Same as #add_transition(state_t,state_t,label_t,weight_t), for an
+     * int label and an int weight; see {@link set_transition_char}. */
+    virtual weight_t add_transition_int(state_t src, state_t dst,
+                                        int label, int weight) = 0;
+
     /** Sets to @pname{w} the weight of transition @pname{tr}. */ 
     virtual weight_t set_weight(transition_t tr, weight_t w) = 0;
 
@@ -410,6 +500,18 @@ namespace awali { namespace dyn {
     {
       return internal::states(this, opts[PREPOST_PARADIGM]);
     }
+
+    /** Same as #states(options_t)const, but the states are written in
+     * @pname{res}, whose memory is reused. */
+    void states(std::vector<state_t>& res, options_t opts = {}) const
+    {
+      fill_states(res, opts[PREPOST_PARADIGM]);
+    }
+
+    /** Replaces the content of @pname{res} by the states of this
+     * {@link abstract_automaton_t}; if @pname{all} is `true`, {@link pre}
+     * and {@link post} are included. */
+    virtual void fill_states(std::vector<state_t>& res, bool all) const = 0;
     
     /** Returns the transitions in this {@link abstract_automaton_t}. 
      *
@@ -424,6 +526,19 @@ namespace awali { namespace dyn {
       return internal::transitions(this, opts[PREPOST_PARADIGM]);
     }
 
+    /** Same as #transitions(options_t)const, but the transitions are
+     * written in @pname{res}, whose memory is reused. */
+    void transitions(std::vector<transition_t>& res, options_t opts = {}) const
+    {
+      fill_transitions(res, opts[PREPOST_PARADIGM]);
+    }
+
+    /** Replaces the content of @pname{res} by the transitions of this
+     * {@link abstract_automaton_t}; if @pname{all} is `true`, the initial
+     * and final transitions are included. */
+    virtual void fill_transitions(std::vector<transition_t>& res,
+                                  bool all) const = 0;
+
     /** Returns the initial states of this {@link abstract_automaton_t}. */
     virtual std::vector<state_t> initial_states() const = 0;
 
@@ -468,6 +583,122 @@ namespace awali { namespace dyn {
     /** Returns all transitions going from @pname{src} to @pname{dst}. */
     virtual std::vector<transition_t> outin(state_t src, state_t dst) const = 0;
 
+    /** Returns the transitions going out of @pname{s}, without copy.
+     *
+     * Unlike {@link outgoing}, the range contains the final transition of
+     * @pname{s}, if any, which goes to {@link post}.
+     * The range is invalidated by any modification of this
+     * {@link abstract_automaton_t}.
+     */
+    virtual transition_span_t transitions_of(state_t s) const = 0;
+
+    /** Returns the transitions coming in @pname{s}, without copy.
+     *
+     * Unlike {@link incoming}, the range contains the initial transition
+     * of @pname{s}, if any, which comes from {@link pre}.
+     * The range is invalidated by any modification of this
+     * {@link abstract_automaton_t}.
+     */
+    virtual transition_span_t transitions_into(state_t s) const = 0;
+
+    /** Calls @pname{f} on each transition going out of @pname{s}.
+     *
+     * The transitions are the ones returned by {@link outgoing}, but no
+     * vector is built.  @pname{f} must not modify this
+     * {@link abstract_automaton_t}.
+     */
+    template<typename F>
+    void for_each_out(state_t s, F f) const
+    {
+      state_t p = post();
+      for (transition_t t : transitions_of(s))
+        if (dst_of(t) != p)
+          f(t);
+    }
+
+    /** Calls @pname{f} on each transition coming in @pname{s}; see
+     * #for_each_out. */
+    template<typename F>
+    void for_each_in(state_t s, F f) const
+    {
+      state_t p = pre();
+      for (transition_t t : transitions_into(s))
+        if (src_of(t) != p)
+          f(t);
+    }
+
+    /** Calls @pname{f} on the destination of each transition going out of
+     * @pname{s}; see #for_each_out. */
+    template<typename F>
+    void for_each_successor(state_t s, F f) const
+    {
+      state_t p = post();
+      for (transition_t t : transitions_of(s)) {
+        state_t d = dst_of(t);
+        if (d != p)
+          f(d);
+      }
+    }
+
+    /** Calls @pname{f} on the source of each transition coming in
+     * @pname{s}; see #for_each_out. */
+    template<typename F>
+    void for_each_predecessor(state_t s, F f) const
+    {
+      state_t p = pre();
+      for (transition_t t : transitions_into(s)) {
+        state_t d = src_of(t);
+        if (d != p)
+          f(d);
+      }
+    }
+
+    /** Same as #outgoing(state_t,options_t)const without options, but the
+     * transitions are written in @pname{res}, whose memory is reused. */
+    void outgoing(state_t s, std::vector<transition_t>& res) const
+    {
+      res.clear();
+      for_each_out(s, [&res](transition_t t) { res.push_back(t); });
+    }
+
+    /** Same as #incoming(state_t,options_t)const without options, but the
+     * transitions are written in @pname{res}, whose memory is reused. */
+    void incoming(state_t s, std::vector<transition_t>& res) const
+    {
+      res.clear();
+      for_each_in(s, [&res](transition_t t) { res.push_back(t); });
+    }
+
+    /** Same as #successors(state_t)const, but the states are written in
+     * @pname{res}, whose memory is reused. */
+    void successors(state_t s, std::vector<state_t>& res) const
+    {
+      res.clear();
+      for_each_successor(s, [&res](state_t d) { res.push_back(d); });
+    }
+
+    /** Same as #predecessors(state_t)const, but the states are written in
+     * @pname{res}, whose memory is reused. */
+    void predecessors(state_t s, std::vector<state_t>& res) const
+    {
+      res.clear();
+      for_each_predecessor(s, [&res](state_t d) { res.push_back(d); });
+    }
+
+    /** Same as #outin(state_t,state_t)const, but the transitions are written
+     * in @pname{res}, whose memory is reused. */
+    void outin(state_t src, state_t dst, std::vector<transition_t>& res) const
+    {
+      res.clear();
+      for (transition_t t : transitions_of(src))
+        if (dst_of(t) == dst)
+          res.push_back(t);
+    }
+
+    /** Returns a flat copy of the states and transitions of this
+     * {@link abstract_automaton_t}; see {@link automaton_snapshot_t}. */
+    virtual automaton_snapshot_t snapshot() const = 0;
+
     /** Returns the preinitial state.
      *
      *  See @ref PREPOST_PARADIGM for details.
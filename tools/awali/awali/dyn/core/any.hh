@@ -55,6 +55,9 @@ namespace awali {
      * exactly the correct type expected by the automaton.
      * Usually, automatic type conversion will *not* work (typically long->int,
      * etc) and provoke a runtime error.
+     *
+     * Small values (char, int, bool, double, q_fraction_t...) are stored
+     * inside the object itself, hence they are boxed without allocation.
      */
     struct any_t {
       template<typename T>
@@ -69,9 +72,57 @@ namespace awali {
       friend std::ostream& operator<<(std::ostream& o, const dyn::any_t& a);
 
     private:
+      /// Points either to buf_ or to the heap.
       internal::untyped_value* val;
 
       bool is_tuple;
+
+      /// Whether val points to buf_.
+      bool inline_;
+
+      internal::inline_buffer_t buf_;
+
+      template<typename T>
+      internal::untyped_value* box_(const T& t, std::true_type) {
+        return new (&buf_) internal::Value<T>(t);
+      }
+
+      template<typename T>
+      internal::untyped_value* box_(const T& t, std::false_type) {
+        return new internal::Value<T>(t);
+      }
+
+      internal::untyped_value* clone_(const any_t& a) {
+        inline_ = a.inline_;
+        if (!a.val)
+          return nullptr;
+        if (a.inline_)
+          return a.val->clone_into(&buf_);
+        return a.val->clone();
+      }
+
+      void release_() {
+        if (inline_)
+          val->~untyped_value();
+        else
+          delete val;
+        val = nullptr;
+        inline_ = false;
+      }
+
+      /// Takes the value of \p a, which is left empty.
+      void steal_(any_t& a) {
+        inline_ = a.inline_;
+        if (a.inline_) {
+          val = a.val->clone_into(&buf_);
+          a.release_();
+        }
+        else {
+          val = a.val;
+          a.val = nullptr;
+        }
+        is_tuple = a.is_tuple;
+      }
       
       std::ostream& output (std::ostream& o) const {
         if (is_tuple) {
@@ -110,14 +161,17 @@ namespace awali {
 
     public:
       template<typename T>
-      any_t(const T& t) : val(new internal::Value<T>(t)), is_tuple(false) {}
+      any_t(const T& t)
+        : val(box_(t, internal::fits_inline<T>{})), is_tuple(false),
+          inline_(internal::fits_inline<T>::value)
+      {}
     
-      any_t() : val(nullptr), is_tuple(false) {}
+      any_t() : val(nullptr), is_tuple(false), inline_(false) {}
 
       template<typename H, typename... T>
       any_t(const H& head, const T&... tail) 
       : val(new internal::Value<std::list<any_t>>({})),
-        is_tuple(true) 
+        is_tuple(true), inline_(false)
       {
         internal::Value<std::list<any_t>>& test
             = dynamic_cast<internal::Value<std::list<any_t>>&>
@@ -125,18 +179,32 @@ namespace awali {
         add_to_vect(test.val, head, tail...);
       }
 
-      any_t(const char *s) : val(new internal::Value<std::string>(s)), is_tuple(false) {}
+      any_t(const char *s) : any_t(std::string(s)) {}
 
-      any_t(const any_t& a) : val(a.val->clone()), is_tuple(a.is_tuple) {}
+      any_t(const any_t& a) : val(nullptr), is_tuple(a.is_tuple), inline_(false)
+      {
+        val = clone_(a);
+      }
+
+      any_t(any_t&& a) : val(nullptr), inline_(false) {
+        steal_(a);
+      }
 
       any_t& operator= (const any_t& t) {
         if(&t==this) return *this;
-        delete val;
-        val=t.val->clone();
+        release_();
+        val=clone_(t);
         is_tuple=t.is_tuple;
         return *this;
       }
 
+      any_t& operator= (any_t&& t) {
+        if(&t==this) return *this;
+        release_();
+        steal_(t);
+        return *this;
+      }
+
       bool operator< (const any_t& a) const {
         return val->less(*(a.val));
       }
@@ -182,7 +250,7 @@ namespace awali {
       }
 
       ~any_t() {
-        delete val;
+        release_();
       }
     };
 
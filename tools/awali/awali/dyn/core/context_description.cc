@@ -16,6 +16,7 @@
 
 #include <awali/dyn/core/context_description.hh>
 #include<unordered_map>
+#include<mutex>
 
 #include <awali/dyn/core/context_description/weightsets/weightsets.cc>
 
@@ -77,6 +78,8 @@ namespace awali {
 
       weightset_description weightset(std::string const&k) {
         static std::unordered_map<std::string,weightset_description> memo;
+        static std::mutex memo_mutex;
+        std::lock_guard<std::mutex> lock(memo_mutex);
         auto it = memo.find(k);
         if (it != memo.end())
           return it->second;
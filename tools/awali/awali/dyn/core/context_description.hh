@@ -51,11 +51,11 @@ namespace awali {
       const std::vector<abstract_weightset*>& instances() {
         static basic_weightset _b_description("B","b",{}, // In spite of {}, B has
                     "Boolean semiring");      //  promotion to every weightset
-        static basic_weightset _n_description("N","n",{"N-oo","Z","Q","R","C"},
+        static basic_weightset _n_description("N","n",{"N-oo","Z","Q","R","C","Z64","Q64"},
                     "Natural integer semiring, ie non-negative integers");
-	static basic_weightset _z_description("Z","z",{"Q","R","C"},
+	static basic_weightset _z_description("Z","z",{"Q","R","C","Z64","Q64"},
                     "Ring of the integers  -- a principal ideal domain indeed");
-	static basic_weightset _q_description("Q","q",{"R","C"},
+	static basic_weightset _q_description("Q","q",{"R","C","Q64"},
                     "Field of the rational numbers");
 	static basic_weightset _r_description("R","r",{"C"},
                     "Field of the real numbers");
@@ -80,6 +80,13 @@ namespace awali {
                     "and min (for multiplication) -- locally finite");
 	static cyclic_weightset _cyclic_description("Z/<int>Z", "Cyclic semiring Z/<int>Z");
 	static bounded_weightset _bounded_description("N<int>", "Quotient of N by the congruence generated by <int> = <int>+1");
+	// Indices are given in order of construction.
+	static basic_weightset _z64_description("Z64","z64",{"Q64"},
+                    "Ring of the integers, computed on 64 bits and "
+                    "with arbitrary precision in case of overflow");
+	static basic_weightset _q64_description("Q64","q64",{},
+                    "Field of the rational numbers, whose numerators and "
+                    "denominators are Z64 integers");
 	static std::vector<abstract_weightset*> v{
 	    &_b_description,
 	    &_n_description,
@@ -94,7 +101,9 @@ namespace awali {
 	    &_rmaxp_description,
 	    &_maxminp_description,
 	    &_cyclic_description,
-	    &_bounded_description};
+	    &_bounded_description,
+	    &_z64_description,
+	    &_q64_description};
 	return v;
       }
 
@@ -71,18 +71,17 @@ namespace awali {
       basic_weightset::possible_promotions()
 	const
       {
-	static std::vector<std::string> b_vector
-	  = all_weightset_public_static_names();
-	static bool once = true;
-	if (once) {
-	  once = false;
+	// Initialized once, even if several threads get here.
+	static std::vector<std::string> const b_vector = [] {
+	  std::vector<std::string> v = all_weightset_public_static_names();
 	  size_t i;
-	  for (i = 0; i< b_vector.size(); i++) {
-	    if(!b_vector[i].compare("B"))
+	  for (i = 0; i< v.size(); i++) {
+	    if(!v[i].compare("B"))
 	      break;
 	  }
-	  b_vector.erase(b_vector.begin()+i);
-	}
+	  v.erase(v.begin()+i);
+	  return v;
+	}();
 	if (this->static_public_name() == "B")
 	  return b_vector;
 	else
@@ -116,7 +115,7 @@ namespace awali {
       cyclic_weightset::tostring(weightset_description ws, bool)
 	const
       {
-	static std::string res;
+	thread_local std::string res;
 	std::ostringstream o;
 	o << "zz" << ws->characteristic ;
 	res=o.str();
@@ -190,7 +189,7 @@ namespace awali {
       bounded_weightset::tostring(weightset_description ws, bool)
 	const
       {
-	static std::string res;
+	thread_local std::string res;
 	std::ostringstream o;
 	o << "nn" << ws->characteristic ;
 	res=o.str();
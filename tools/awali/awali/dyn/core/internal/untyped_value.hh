@@ -28,6 +28,8 @@ namespace awali { namespace dyn {
       untyped_value(const untyped_value&) {}
       virtual ~untyped_value(){}
       virtual untyped_value* clone() const = 0;
+      /// Copy constructs *this in the storage \p buf, if it fits there.
+      virtual untyped_value* clone_into(void* buf) const = 0;
       virtual std::ostream& output(std::ostream& o) const = 0;
       virtual bool less(const untyped_value& uv) const = 0;
       virtual bool equal(const untyped_value& uv) const = 0;
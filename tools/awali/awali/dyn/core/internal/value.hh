@@ -21,6 +21,8 @@
 #include <awali/common/qfraction.hh>
 #include <awali/dyn/core/internal/untyped_value.hh>
 
+#include<new>
+#include<type_traits>
 #include<typeinfo>  
 
 namespace awali { namespace dyn {
@@ -28,6 +30,21 @@ namespace awali { namespace dyn {
 
     template<typename T> T any_cast(const any_t& a);
 
+    template<typename T> struct Value;
+
+    /// Storage in which any_t keeps small values.
+    using inline_buffer_t = std::aligned_storage<2 * sizeof(void*),
+                                                 alignof(void*)>::type;
+
+    /// Whether values of type T are stored in an inline_buffer_t.
+    template<typename T>
+    using fits_inline
+      = std::integral_constant<bool,
+                               sizeof(Value<T>) <= sizeof(inline_buffer_t)
+                               && alignof(Value<T>) <= alignof(inline_buffer_t)
+                               && std::is_nothrow_copy_constructible<T>
+                                    ::value>;
+
     template<typename T>
     struct Value : public untyped_value {
       Value(const T& val) : val(val) {}
@@ -37,6 +54,12 @@ namespace awali { namespace dyn {
         return new Value(val);
       }
 
+      /// Values which do not fit in the buffer are never stored inline,
+      /// they are copied on the heap instead.
+      Value* clone_into(void* buf) const override {
+        return clone_into_(buf, fits_inline<T>{});
+      }
+
       std::ostream& output(std::ostream& o) const override {
         return (o << val);
       }
@@ -57,6 +80,15 @@ namespace awali { namespace dyn {
       }
 
       virtual ~Value() {}
+
+    private:
+      Value* clone_into_(void* buf, std::true_type) const {
+        return new (buf) Value(val);
+      }
+
+      Value* clone_into_(void*, std::false_type) const {
+        return clone();
+      }
     };
 
     template<typename T>
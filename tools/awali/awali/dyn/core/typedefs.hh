@@ -18,6 +18,8 @@
 #ifndef DYN_CORE_TYPEDEFS_HH
 #define DYN_CORE_TYPEDEFS_HH
 
+#include<cstddef>
+
 #include<awali/dyn/core/any.hh>
 
 namespace awali { namespace dyn {
@@ -32,6 +34,22 @@ namespace awali { namespace dyn {
    */
   using transition_t = unsigned;
 
+  /** Range of transitions stored contiguously in an automaton.
+   *
+   * The range is a view: it is invalidated by any modification of the
+   * automaton.
+   */
+  struct transition_span_t {
+    const transition_t* first;
+    const transition_t* last;
+
+    const transition_t* begin() const { return first; }
+    const transition_t* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    transition_t operator[](size_t i) const { return first[i]; }
+  };
+
   /** 
   Type for (transition) labels; it is an alias to {@link any_t} since its precise
   type depends on the weightset of manipulated {@link automaton_t} or {@link ratexp_t}.
@@ -219,7 +219,7 @@ namespace awali { namespace dyn {
 
       *warning_stream << std::string("Linking module \"" + name + "\" for a new automaton context (" + static_context + ").") << std::endl;
 //       std::string ld_flags = " -shared"
-      std::string lib_cmd = cxx+" -shared"
+      std::string lib_cmd = cxx+" -shared -pthread"
       +" -o " + modulepath
 #ifdef CMAKE_OSX_SYSROOT
 #define STR_VALUE(arg)      #arg
@@ -20,11 +20,17 @@
 #include <awali/dyn/loading/handler.hh>
 #include <awali/dyn/loading/locations.hh>
 
+#include <mutex>
+
 namespace awali { namespace dyn {
   namespace loading {
 
     static std::map<std::string,void*> loaded_handler;
 
+    /* Protects loaded_handler; it is held during the compilation of a
+       module, so that two threads never build the same library. */
+    static std::mutex loaded_handler_mutex;
+
 //     struct test_t { 
 //       test_t() { dlopen(NULL,RTLD_NOW|RTLD_GLOBAL); }
 //     };
@@ -42,6 +48,7 @@ namespace awali { namespace dyn {
         const std::string& static_context) 
     {
       std::string unique_name(name+"@"+group+"@"+static_context);
+      std::lock_guard<std::mutex> lock(loaded_handler_mutex);
       auto handler_it= loaded_handler.find(unique_name);
       if (handler_it != loaded_handler.end())
         return handler_it->second;
@@ -70,12 +77,13 @@ namespace awali { namespace dyn {
     void* get_handler(const std::string& name, const std::string& group,
                       const std::string& static_context1,
                       const std::string& static_context2) {
-      make_awali_dir();
       std::string p(libname(static_context1+"_"+static_context2,group)+".so");
       std::string unique_name = name+"@"+group+"@"+p;
+      std::lock_guard<std::mutex> lock(loaded_handler_mutex);
       auto handler_it= loaded_handler.find(unique_name);
       if (handler_it != loaded_handler.end())
         return handler_it->second;
+      make_awali_dir();
       std::string local = get_lib_directory()[0]+"/"+p;
       std::string global = get_lib_directory()[1]+"/"+p;
       auto handle = dlopen(local.c_str(), RTLD_NOW);
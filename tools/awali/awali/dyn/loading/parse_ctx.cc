@@ -51,7 +51,7 @@ namespace awali { namespace  dyn {
      * C  -> L_W
      * L  -> lao | lal_char lal_int | law_char | lan<L> | lat<LL>
      * LL -> L | L,LL
-     * W  -> b | z | q | r | c | f2 | zmin | zmax | pmax | zzN | nnK
+     * W  -> b | z | q | r | c | f2 | zmin | zmax | pmax | zzN | nnK | z64 | q64
      *     | ratexpset<C> | series<C> | product<WW>
      * WW -> W | W,WW
      *
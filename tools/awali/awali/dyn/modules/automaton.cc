@@ -70,6 +70,10 @@ namespace awali {
       loading::call1<void>("change_int_alphabet", "automaton", aut, v);
     }
 
+    void change_int_alphabet(automaton_t aut, const std::set<int>& alphabet) {
+      loading::call1<void>("change_int_alphabet", "automaton", aut, alphabet);
+    }
+
     automaton_t left_mult(automaton_t aut, weight_t w, options_t opts)
     {
       automaton_t res = opts[IN_PLACE] ? aut : copy(aut, opts);
@@ -17,6 +17,7 @@
 #ifndef DYN_MODULES_AUTOMATON_HH
 #define DYN_MODULES_AUTOMATON_HH
 
+#include <set>
 #include <unordered_map>
 
 #include <awali/dyn/options/options.hh>
@@ -93,6 +94,17 @@ namespace awali {
      */
     void change_int_alphabet(automaton_t aut, int a, int b);
 
+    /** @brief Change the alphabet of the automaton
+     *
+     * This function replaces the alphabet of the automaton by the given set
+     * of int.  Transitions which are labeled with letters that do not belong
+     * to the new alphabet are deleted.
+     *
+     * @param aut the automaton
+     * @param alphabet the new alphabet
+     */
+    void change_int_alphabet(automaton_t aut, const std::set<int>& alphabet);
+
     /** Determines if two automata are isomorphic.
      *
      *  @param aut1
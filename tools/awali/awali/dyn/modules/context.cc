@@ -138,8 +138,8 @@ internal::make_context(context::context_description cd)
 //}
 
 
-automaton_t 
-internal::parse_automaton(json_ast_t p)
+std::function<automaton_t()>
+internal::automaton_parser(json_ast_t p)
 {
   if(!p->has_child("kind") || p->at("kind")->to_string() != "Automaton")
     throw std::runtime_error("json: Automaton");
@@ -150,18 +150,16 @@ internal::parse_automaton(json_ast_t p)
   std::string stat_ctx = tostring(ct, false);
   typedef automaton_t (*bridge_t)(json::object_t*, 
                                   dyn::context::context_description);
-  static std::unordered_map<std::string, void*> bridges;
-  auto it = bridges.find(stat_ctx);
-  automaton_t res;
-  if(it == bridges.end()) {
-    auto bridge = (bridge_t) loading::get_handler("parse_automaton", "context",
-                                                  stat_ctx);
-    bridges.emplace(stat_ctx, (void*) bridge);
-    res= bridge(&(*p), ct);
-  }
-  else
-    res = ((bridge_t) it->second)(&(*p), ct);
-  return res;
+  auto bridge = (bridge_t) loading::get_handler("parse_automaton", "context",
+                                                stat_ctx);
+  return [p, ct, bridge] { return bridge(&(*p), ct); };
+}
+
+
+automaton_t 
+internal::parse_automaton(json_ast_t p)
+{
+  return automaton_parser(p)();
 }
 
 
@@ -186,17 +184,9 @@ internal::deprecated_parse_automaton(std::istream& i)
   awali::internal::check(i, ',');
   std::string stat_ctx = tostring(ct,false);
   typedef automaton_t (*bridge_t)(std::istream&, context::context_description);
-  static std::unordered_map<std::string, bridge_t> bridges;
-  auto it = bridges.find(stat_ctx);
-  automaton_t res;
-  if(it == bridges.end()) {
-    auto bridge = (bridge_t) loading::get_handler("parse_automaton_deprecated",
-                                                  "context", stat_ctx);
-    bridges.emplace(stat_ctx, bridge);
-    res= bridge(i, ct);
-  }
-  else
-    res = it->second(i, ct);
+  auto bridge = (bridge_t) loading::get_handler("parse_automaton_deprecated",
+                                                "context", stat_ctx);
+  automaton_t res = bridge(i, ct);
   awali::internal::check(i,']');
   awali::internal::check(i,'}');
   return res;
@@ -223,16 +213,9 @@ internal::make_ratexp_with_context(std::string const& exp,
 {
   std::string stat_ctx = tostring(cd, false);
   typedef ratexp_t (*bridge_t)(const char*, context::context_description, bool);
-  static std::unordered_map<std::string, void*> bridges;
-  auto it = bridges.find(stat_ctx);
-  if(it == bridges.end()) {
-    auto bridge = (bridge_t) loading::get_handler("make_ratexp_with_desc",
-                  "context", stat_ctx);
-    bridges.emplace(stat_ctx, (void*) bridge);
-    return bridge(exp.c_str(), cd, fixed_alphabet);
-  }
-  else
-    return ((bridge_t) it->second)(exp.c_str(), cd, fixed_alphabet);
+  auto bridge = (bridge_t) loading::get_handler("make_ratexp_with_desc",
+                "context", stat_ctx);
+  return bridge(exp.c_str(), cd, fixed_alphabet);
 }
 
 
@@ -368,18 +351,9 @@ internal::parse_ratexp(json_ast_t p)
   std::string stat_ctx = tostring(ct, false);
   typedef ratexp_t (*bridge_t)(context::context_description, 
                                json::object_t*);
-  static std::unordered_map<std::string, void*> bridges;
-  auto it = bridges.find(stat_ctx);
-  ratexp_t res;
-  if(it == bridges.end()) {
-    auto bridge = (bridge_t) loading::get_handler("parse_ratexp", "context",
-                  stat_ctx);
-    bridges.emplace(stat_ctx, (void*) bridge);
-    res= bridge(ct, p->at("data")->object());
-  }
-  else
-    res = ((bridge_t)it->second)(ct, p->at("data")->object());
-  return res;
+  auto bridge = (bridge_t) loading::get_handler("parse_ratexp", "context",
+                stat_ctx);
+  return bridge(ct, p->at("data")->object());
 }
 
 
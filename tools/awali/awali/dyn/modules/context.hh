@@ -17,6 +17,7 @@
 #ifndef DYN_MODULES_CONTEXT_HH
 #define DYN_MODULES_CONTEXT_HH
 
+#include<functional>
 #include<string>
 
 #include <awali/dyn/core/context_description.hh>
@@ -71,6 +72,11 @@ namespace awali {
 
       automaton_t parse_automaton(json_ast_t ast);
 
+      /* Checks the context of the automaton described by \p ast and loads
+       * the corresponding module; the returned function builds the
+       * automaton, and may be called in another thread. */
+      std::function<automaton_t()> automaton_parser(json_ast_t ast);
+
       automaton_t deprecated_parse_automaton(std::istream& i);
 
       ratexp_t make_ratexp_with_context(const std::string& exp,
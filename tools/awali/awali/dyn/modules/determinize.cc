@@ -55,6 +55,14 @@ namespace awali {
     }
 
 
+    automaton_t
+    complement_nfa (automaton_t aut, options_t opts)
+    {
+      return loading::call1<automaton_t>("complement_nfa", "determinize", aut,
+                                         opts[MINIMIZE], opts[KEEP_HISTORY]);
+    }
+
+
     automaton_t
     complete (automaton_t aut, options_t opts)
     {
@@ -105,6 +113,19 @@ namespace awali {
       return loading::call1<bool>("is_ambiguous", "determinize", aut);
     }
 
+    bool
+    is_ambiguous (automaton_t aut, any_t& witness)
+    {
+      return loading::call1<bool, automaton_t, any_t&>
+        ("is_ambiguous_with_witness", "determinize", aut, witness);
+    }
+
+    ambiguity_t
+    ambiguity_degree (automaton_t aut)
+    {
+      return loading::call1<ambiguity_t>("ambiguity_degree", "determinize", aut);
+    }
+
     automaton_t explore_by_length(automaton_t aut, unsigned depth) {
       return loading::call1<automaton_t>("explore_by_length", "determinize", aut, depth);
     }
@@ -54,6 +54,19 @@ namespace awali {
      */
     automaton_t complement(automaton_t aut, options_t opts = {});
 
+    /** Computes a complete deterministic automaton accepting the complement
+     * of the language of \p aut.
+     *
+     * The complement is built by a single subset construction which adds
+     * the sink state and sets the final states on the fly; \p aut needs not
+     * be deterministic nor complete.
+     * @param aut a Boolean automaton
+     * @param opts A set of options.  Only {@link MINIMIZE} and
+     * {@link KEEP_HISTORY} are meaningful.
+     * @pre \p aut should be over weightset B and labelled by letters
+     */
+    automaton_t complement_nfa(automaton_t aut, options_t opts = {});
+
 
     /** Completes \p aut or returns a completed copy of given automaton.
      * @param aut
@@ -101,6 +114,24 @@ namespace awali {
      */
     bool is_ambiguous(automaton_t aut);
 
+    /** Tests whether an automaton is ambiguous, and gives a witness.
+     * The square of `aut` is explored on the fly, and the exploration stops
+     * at the first pair of distinct states which is useful in the square.
+     * @param aut the automaton
+     * @param witness set to a word which is the label of two accepting runs,
+     * if `aut` is ambiguous; left unchanged otherwise
+     * @pre the labels of `aut` should be letters.
+     */
+    bool is_ambiguous(automaton_t aut, any_t& witness);
+
+    /** Computes the degree of ambiguity of an automaton.
+     * That is, whether the number of accepting runs of a word is at most one,
+     * bounded, polynomial or exponential in its length.
+     * The weights of `aut` are not taken into account.
+     * @pre the labels of `aut` should be letters.
+     */
+    ambiguity_t ambiguity_degree(automaton_t aut);
+
     /** Computes the exploration of \p aut by length.
      * @param aut the automaton to explore
      * @param depth the depth of the exploration
@@ -41,6 +41,11 @@ namespace awali {
     {
       return loading::call1<std::map<any_t, weight_t>>("shortest", "eval", aut, max);
     }
+
+    word_enumerator_t lazy_enumerate(automaton_t aut, unsigned max_length)
+    {
+      return loading::call1<word_enumerator_t>("lazy_enumerate", "eval", aut, max_length);
+    }
   }
 }//end of ns awali::dyn
 
@@ -17,7 +17,9 @@
 #ifndef DYN_MODULES_EVAL_HH
 #define DYN_MODULES_EVAL_HH
 
+#include <limits>
 #include <map>
+#include <memory>
 #include <awali/dyn/core/automaton.hh>
 
 //Only for lal
@@ -50,6 +52,40 @@ namespace awali {
      */
     std::map<any_t, weight_t> shortest(automaton_t aut, unsigned max);
 
+
+    /** Abstract interface for the lazy enumeration of the words accepted
+     * by an automaton; see {@link lazy_enumerate}.
+     */
+    class abstract_word_enumerator_t {
+    public:
+      /** Gets the next accepted word and its weight.
+       * @param word is set to the next word
+       * @param weight is set to the weight of \p word
+       * @return false if there is no more words; \p word and \p weight
+       * are then left unchanged.
+       */
+      virtual bool next(any_t& word, weight_t& weight) = 0;
+
+      virtual ~abstract_word_enumerator_t() {}
+    };
+
+    using word_enumerator_t = std::shared_ptr<abstract_word_enumerator_t>;
+
+
+    /** Gives the words accepted by \p aut one at a time, by increasing
+     * length, then in lexicographic order.
+     *
+     * Words are computed on demand, so that the enumeration may be
+     * stopped at any time, even if the language is infinite.
+     *
+     * @param aut
+     * @param max_length the maximal length of the enumerated words
+     * @pre \p aut should not be a transducer or allow epsilon transitions.
+     */
+    word_enumerator_t
+    lazy_enumerate(automaton_t aut,
+                   unsigned max_length = std::numeric_limits<unsigned>::max());
+
   }
 }//end of ns awali::dyn
 
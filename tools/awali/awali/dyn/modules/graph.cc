@@ -40,26 +40,37 @@ namespace awali {
       }
 
 
+      std::pair< std::unordered_map<state_t, unsigned int>,
+      std::vector<std::vector<state_t>> >
+                                     scc (automaton_t aut, scc_algo_t algo)
+      {
+        return loading::call1<  std::pair< std::unordered_map<state_t, unsigned int>, std::vector<std::vector<state_t>> >  >("scc",
+               "graph", aut, algo);
+      }
+
+
       std::pair<  automaton_t,
       std::pair< std::unordered_map<state_t, unsigned int>,
       std::vector<std::vector<state_t>> >  >
-                                     condensation (automaton_t aut)
+                                     condensation (automaton_t aut,
+                                                   scc_algo_t algo)
       {
         return loading::call1< std::pair<  automaton_t, std::pair< std::unordered_map<state_t, unsigned int>, std::vector<std::vector<state_t>> >  >
-               >("condensation", "graph", aut);
+               >("condensation", "graph", aut, algo);
       }
     }
 
 
-    scc_return_t strongly_connected_components(automaton_t aut)
+    scc_return_t strongly_connected_components(automaton_t aut,
+                                               options_t opts)
     {
-      auto res = internal::scc_iterative(aut);
+      auto res = internal::scc(aut, opts[SCC_ALGO]);
       return {res.first, res.second};
     }
 
-    automaton_t condensation (automaton_t aut)
+    automaton_t condensation (automaton_t aut, options_t opts)
     {
-      return internal::condensation(aut).first;
+      return internal::condensation(aut, opts[SCC_ALGO]).first;
     }
 
     /** Computes the strongly connected components of @pname{s}.
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include <awali/dyn/core/automaton.hh>
+#include <awali/dyn/options/options.hh>
 
 namespace awali {
   namespace dyn {
@@ -36,18 +37,23 @@ namespace awali {
     /**
      * Computes the strongly connected components of an automaton.
      * @param aut
+     * @param opts Option {@link SCC_ALGO} selects the algorithm;
+     * {@link FORWARD_BACKWARD} runs on all cores.
      * @return A double map: states to scc and scc to states
      */
-    scc_return_t strongly_connected_components(automaton_t aut);
+    scc_return_t strongly_connected_components(automaton_t aut,
+                                               options_t opts = {});
 
 
     /** Computes the condensation of an automaton; it results from reducing each
      * strongly connected component of the original automaton to a single state
      *
      * @param aut
+     * @param opts Option {@link SCC_ALGO} selects the algorithm used to
+     * compute the strongly connected components.
      * @return The condensation of \p aut
      */
-    automaton_t condensation (automaton_t aut);
+    automaton_t condensation (automaton_t aut, options_t opts = {});
 
     /** Returns the strongly connected component of a state.
      *
@@ -40,6 +40,10 @@ namespace awali {
         return loading::call1<ratexp_t>("aut_to_exp_in_order", "ratexp", aut);
       case MIN_INOUT_DEGREE:
         return loading::call1<ratexp_t>("aut_to_exp_heuristic", "ratexp", aut);
+      case MIN_EXP_SIZE:
+      case SCC_MIN_INOUT_DEGREE:
+        return loading::call1<ratexp_t>("aut_to_exp_ordered", "ratexp", aut,
+                                        opts[STATE_ELIM_ORDER]);
       }
       throw std::runtime_error("dyn::aut_to_exp Unreachable statement");
     }
@@ -231,6 +231,30 @@ namespace awali {
       return loading::call2<transducer_t>("compose", "compose", tdc1, tdc2);
     }
 
+    transducer_t compose_all(const std::vector<transducer_t>& tdcs)
+    {
+      if (tdcs.empty())
+        throw std::domain_error("compose_all: empty list of transducers.");
+      std::vector<automaton_t> auts;
+      for (transducer_t tdc : tdcs)
+        auts.push_back(tdc);
+      // The lazy cascade is only available for two-tape transducers over
+      // chars, all with the same context; otherwise compose pairwise.
+      std::string stat_ctx = auts[0]->get_context()->sname();
+      bool lazy = stat_ctx.compare(0, 32, "lat<lan<lal_char>,lan<lal_char>>") == 0;
+      for (const auto& aut : auts)
+        if (aut->get_context()->sname() != stat_ctx)
+          lazy = false;
+      if (!lazy) {
+        transducer_t res = tdcs[0];
+        for (size_t i = 1; i < tdcs.size(); ++i)
+          res = compose(res, tdcs[i]);
+        return res;
+      }
+      return loading::call0<automaton_t, const std::vector<automaton_t>&>
+        ("compose_all", "transducer", stat_ctx, auts);
+    }
+
     bool is_functional(transducer_t tdc)
     {
       return loading::call1<bool>("is_functional", "transducer", tdc);
@@ -130,6 +130,20 @@ namespace awali {
     /** \ingroup Transducer */
     transducer_t compose(transducer_t tdc1, transducer_t tdc2);
 
+    /** Composition of a cascade of transducers.
+     *
+     * The second tape of each transducer is composed with the first tape
+     * of the next one.  If all the transducers have the same context, with
+     * two tapes of chars, the composition is computed lazily: only the
+     * accessible states of the result are built, and no intermediate
+     * transducer is, and the result is trim.  Otherwise, the transducers
+     * are composed pairwise with {@link compose}.
+     *
+     * @param tdcs A non-empty list of transducers.
+     * @return A new transducer.
+     */
+    transducer_t compose_all(const std::vector<transducer_t>& tdcs);
+
     /** Tests whether \p tdc is functional.
      *
      * @param tdc
@@ -35,9 +35,11 @@ namespace awali {
 
 
     /** Option used when a rational expression is computed from an automaton.
-     * Defaults to {@link STANDARD_AND_QUOTIENT}.
+     * Defaults to {@link DERIVED_TERM}; for expressions whose labels are not
+     * letters, {@link DERIVED_TERM} falls back to
+     * {@link STANDARD_AND_QUOTIENT}.
      */
-    DECLARE_OPTION(EXP_TO_AUT_ALGO, exp_to_aut_algo_t, STANDARD_AND_QUOTIENT);
+    DECLARE_OPTION(EXP_TO_AUT_ALGO, exp_to_aut_algo_t, DERIVED_TERM);
 
     /** Option used when there are "forward" or "backward" strategies.
      *  Defaults to {@link BACKWARD}.
@@ -80,6 +82,13 @@ namespace awali {
      */
     DECLARE_OPTION(MINIM_ALGO, minim_algo_t, DETERMINIZE_QUOTIENT);
 
+    /** Option used by constructions of deterministic automata to tell
+     * whether the result should be minimal.
+     *
+     * Defaults to `false`.
+     */
+    DECLARE_OPTION(MINIMIZE, bool, false);
+
     /** Option used to specify the algorithm to use for computing quotients.
      * Note that it is also used by default when making a minimization.
      *
@@ -87,6 +96,14 @@ namespace awali {
      */
     DECLARE_OPTION(QUOTIENT_ALGO, quotient_algo_t, MOORE);
 
+    /** Option used to specify the algorithm to use for computing strongly
+     * connected components.
+     *
+     * Defaults to {@link TARJAN_ITERATIVE}; {@link FORWARD_BACKWARD} uses
+     * all cores and is meant for very large automata.
+     */
+    DECLARE_OPTION(SCC_ALGO, scc_algo_t, TARJAN_ITERATIVE);
+
 // // <<<<<<< HEAD
 //     /** Option used when a name may be given.
 //      *
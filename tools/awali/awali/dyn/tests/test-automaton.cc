@@ -16,10 +16,17 @@
 
 #include <awali/dyn.hh>
 #include<cassert>
+#include<stdexcept>
 
 using namespace awali::dyn;
+using namespace awali;
 using namespace awali::dyn::context;
 
+void check(bool b, const std::string& msg) {
+  if (!b)
+    throw std::runtime_error(msg);
+}
+
 int main() {
   automaton_t(ltupleset({nullableset(letterset("ab")),letterset("xy")}),weightset("B"));
 
@@ -29,5 +36,97 @@ int main() {
     automaton_t::from("ab", sr, true);
   }
 
+  // Typed accessors and mutators.
+  automaton_t a = automaton_t::from("ab");
+  state_t s0 = a->add_state(), s1 = a->add_state();
+  transition_t t = a->set_transition_char(s0, s1, 'a');
+  a->add_transition_char(s1, s1, 'b');
+  a->set_final(s1);
+  check(a->label_of_char(t) == 'a', "label_of_char");
+  check((char) a->label_of(t) == 'a', "label_of");
+  check(a->transitions_of(s0).size() == 1 && a->transitions_of(s0)[0] == t,
+        "transitions_of");
+  // The final transition is in the range.
+  check(a->transitions_of(s1).size() == 2, "transitions_of final");
+
+  automaton_t z = automaton_t::from("ab", "Z");
+  t = z->set_transition_char(z->add_state(), z->add_state(), 'b', 3);
+  z->add_transition_char(z->src_of(t), z->dst_of(t), 'b', 4);
+  check(z->weight_of_int(t) == 7 && (int) z->weight_of(t) == 7,
+        "weight_of_int");
+  // Weights of other types are converted.
+  automaton_t q = automaton_t::from("ab", "Q");
+  t = q->set_transition_char(q->add_state(), q->add_state(), 'a', 2);
+  check((q_fraction_t) q->weight_of(t) == q_fraction_t(2), "Q weight");
+
+  // Weights which are not integers are not truncated.
+  automaton_t r = automaton_t::from("ab", "R");
+  t = r->set_transition_char(r->add_state(), r->add_state(), 'a', 2);
+  check(r->weight_of_int(t) == 2, "R weight_of_int");
+  r->set_weight(t, 0.5);
+  bool thrown = false;
+  try {
+    r->weight_of_int(t);
+  }
+  catch (const any_cast_exception&) {
+    thrown = true;
+  }
+  check(thrown, "R weight_of_int 0.5");
+
+  automaton_t n = automaton_t::with_int_labels::from_range(1, 3);
+  t = n->set_transition_int(n->add_state(), n->add_state(), 2);
+  check(n->label_of_int(t) == 2, "label_of_int");
+
+  // Iteration without allocation agrees with the vector-returning API.
+  automaton_t d = load("a1");
+  std::vector<transition_t> buf;
+  std::vector<state_t> sbuf;
+  size_t count = 0;
+  for (state_t s : d->states()) {
+    d->outgoing(s, buf);
+    check(buf == d->outgoing(s), "outgoing buffer");
+    d->incoming(s, buf);
+    check(buf == d->incoming(s), "incoming buffer");
+    d->successors(s, sbuf);
+    check(sbuf == d->successors(s), "successors buffer");
+    d->predecessors(s, sbuf);
+    check(sbuf == d->predecessors(s), "predecessors buffer");
+    d->outin(s, s, buf);
+    check(buf == d->outin(s, s), "outin buffer");
+    d->for_each_out(s, [&count](transition_t) { ++count; });
+  }
+  check(count == d->num_transitions(), "for_each_out");
+  d->states(sbuf);
+  check(sbuf == d->states(), "states buffer");
+  d->transitions(buf, {PREPOST_PARADIGM = true});
+  check(buf == d->transitions({PREPOST_PARADIGM = true}),
+        "transitions buffer");
+
+  automaton_snapshot_t snap = d->snapshot();
+  check(snap.states == d->states()
+        && snap.num_transitions() == d->num_transitions()
+        && snap.out_begin.size() == snap.num_states() + 1
+        && snap.initials.size() == d->num_initials()
+        && snap.finals.size() == d->num_finals(), "snapshot");
+  for (unsigned i = 0; i < snap.num_states(); ++i)
+    for (unsigned j = snap.out_begin[i]; j < snap.out_begin[i+1]; ++j)
+      check(d->src_of(snap.transitions[j]) == snap.states[i]
+            && d->dst_of(snap.transitions[j]) == snap.states[snap.dsts[j]],
+            "snapshot transition");
+
+  // Automata loaded in parallel are the same as those loaded one by one.
+  std::vector<std::string> names = {"a1", "b1", "a1", "binary", "c1"};
+  std::vector<automaton_t> auts = load_all(names, {}, 3);
+  check(auts.size() == names.size() && auts[0] != auts[2], "load_all");
+  for (size_t i = 0; i < names.size(); ++i)
+    check(are_isomorphic(auts[i], load(names[i])), "load_all " + names[i]);
+
+  // Small values are copied and moved within any_t.
+  any_t x = 'a', y = x, w(std::move(y));
+  y = x;
+  x = std::string("abc");
+  check((char) w == 'a' && (char) y == 'a' && (std::string) x == "abc",
+        "any_t");
+
   return 0;
 }
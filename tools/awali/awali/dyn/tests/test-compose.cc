@@ -0,0 +1,66 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <awali/dyn.hh>
+#include<cassert>
+#include<iostream>
+
+using namespace awali::dyn;
+
+void sep(std::string str) {
+  std::cout << "==================== " << str
+            << " ====================" << std::endl;
+}
+
+// compose_all must agree with pairwise composition, whether or not the
+// lazy cascade is available for the context.
+void test_compose_all(transducer_t t1, transducer_t t2) {
+  automaton_t all = compose_all({t1, t2, t1});
+  automaton_t pw = trim(compose(compose(t1, t2), t1));
+  std::cout << all->num_states() << " states, "
+            << all->num_transitions() << " transitions" << std::endl;
+  assert(all->num_states() == pw->num_states());
+  assert(all->num_transitions() == pw->num_transitions());
+}
+
+int main() {
+
+  sep("chars");
+  transducer_t ct = transducer_t::from({"ab","ab"});
+  state_t cp = ct->add_state();
+  state_t cq = ct->add_state();
+  ct->set_initial(cp);
+  ct->set_final(cq);
+  ct.set_transition(cp, cq, {"a","b"});
+  ct.set_transition(cq, cq, {"b","a"});
+  test_compose_all(ct, inverse(ct));
+
+  sep("ints");
+  std::vector<context::labelset_description> v =
+    {
+      context::nullableset(context::intletterset(0,2)),
+      context::nullableset(context::intletterset(0,2))
+    };
+  transducer_t it = automaton_t(context::ltupleset(v),
+                                context::weightset("B"));
+  state_t ip = it->add_state();
+  state_t iq = it->add_state();
+  it->set_initial(ip);
+  it->set_final(iq);
+  it.set_transition(ip, iq, {"0","1"});
+  it.set_transition(iq, iq, {"1","2"});
+  test_compose_all(it, inverse(it));
+}
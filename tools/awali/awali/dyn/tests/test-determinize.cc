@@ -43,6 +43,11 @@ int main() {
   inter = product(a,d);
   trim(inter,{IN_PLACE=true});
   assert(is_empty(inter));
+  automaton_t cn = complement_nfa(a);
+  assert(is_deterministic(cn) && is_complete(cn));
+  assert(are_equivalent(cn, cpt));
+  automaton_t cm = complement_nfa(a, {MINIMIZE=true});
+  assert(are_equivalent(cm, cpt));
 
 //   std::ifstream
 
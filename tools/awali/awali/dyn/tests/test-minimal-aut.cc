@@ -33,6 +33,13 @@ void test(automaton_t aut) {
     std::cout << aut2 << std::endl;
     exit(1);
   }
+  automaton_t aut3 = minimal_automaton(aut, {MINIM_ALGO = awali::INCREMENTAL});
+  if (!are_isomorphic(aut3,aut2)) {
+    std::cout << "Incremental minimization: automata are not isomorphic."
+              << std::endl;
+    std::cout << aut3 << std::endl;
+    exit(1);
+  }
 }
 
 int main() {
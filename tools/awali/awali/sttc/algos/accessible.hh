@@ -21,10 +21,13 @@
 #ifndef AWALI_ALGOS_ACCESSIBLE_HH
 #define AWALI_ALGOS_ACCESSIBLE_HH
 
+#include <algorithm>
 #include <deque>
 #include <queue>
 #include <map>
+#include <set>
 #include <unordered_set>
+#include <vector>
 
 #include <awali/sttc/algos/copy.hh>
 #include <awali/sttc/algos/sub_automaton.hh>
@@ -36,6 +39,152 @@ namespace awali {
   namespace sttc {
 
 
+  /*-------------------------------------------------------.
+  | Bitvectors of accessible, coaccessible, useful states.  |
+  `-------------------------------------------------------*/
+
+  namespace internal {
+
+    /// Scratch buffer for the frontier of the breadth-first searches;
+    /// it is kept from one call to the next to avoid reallocations.
+    inline
+    std::vector<state_t>&
+    reach_frontier()
+    {
+      static thread_local std::vector<state_t> frontier;
+      return frontier;
+    }
+
+    /// One more than the greatest state of \a aut, pre() and post()
+    /// included.
+    template <typename Aut>
+    state_t
+    state_bound(const Aut& aut)
+    {
+      state_t res = std::max(aut->pre(), aut->post());
+      for (auto s : aut->states())
+        if (s > res)
+          res = s;
+      return res + 1;
+    }
+
+    /// Set in \a res the states reachable from pre() in \a aut
+    /// (pre() and post() included).
+    template <typename Aut>
+    void
+    fill_reachable_bits(std::vector<bool>& res, const Aut& aut)
+    {
+      std::vector<state_t>& frontier = reach_frontier();
+      frontier.clear();
+      frontier.emplace_back(aut->pre());
+      res[aut->pre()] = true;
+      // The frontier is a flat queue: states before i are explored.
+      for (size_t i = 0; i < frontier.size(); ++i)
+        for (auto tr : aut->all_out(frontier[i])) {
+          state_t dst = aut->dst_of(tr);
+          if (!res[dst]) {
+            res[dst] = true;
+            frontier.emplace_back(dst);
+          }
+        }
+    }
+  }
+
+  /** @brief Bitvector of accessible states
+   *
+   * Computes the accessible states of aut, as a vector of Booleans
+   * indexed by states.
+   *
+   * @tparam Aut The static type of automaton
+   * @param aut  A static Awali automaton that can be read-only (including view)
+   * @param include_pre_post  if true, the pre-initial and the post-final states may be set in the result.
+   *
+   * @return a vector `v` such that `v[s]` is true iff `s` is accessible
+   **/
+    template <typename Aut>
+    std::vector<bool>
+    accessible_bits(const Aut& aut, bool include_pre_post=false)
+    {
+      std::vector<bool> res(internal::state_bound(aut), false);
+      internal::fill_reachable_bits(res, aut);
+      if (!include_pre_post) {
+        res[aut->pre()] = false;
+        res[aut->post()] = false;
+      }
+      return res;
+    }
+
+  /** @brief Bitvector of coaccessible states
+   *
+   * Computes the coaccessible states of aut, as a vector of Booleans
+   * indexed by states.
+   *
+   * @tparam Aut The static type of automaton
+   * @param aut  A static Awali automaton that can be read-only (including view)
+   * @param include_pre_post  if true, the pre-initial and the post-final states may be set in the result.
+   *
+   * @return a vector `v` such that `v[s]` is true iff `s` is coaccessible
+   **/
+    template <typename Aut>
+    std::vector<bool>
+    coaccessible_bits(const Aut& aut, bool include_pre_post=false)
+    {
+      return accessible_bits(transpose_view(aut), include_pre_post);
+    }
+
+  /** @brief Bitvector of useful states
+   *
+   * Computes the useful (accessible and coaccessible) states of aut,
+   * as a vector of Booleans indexed by states.
+   *
+   * @tparam Aut The static type of automaton
+   * @param aut  A static Awali automaton that can be read-only (including view)
+   *
+   * @return a vector `v` such that `v[s]` is true iff `s` is useful
+   **/
+    template <typename Aut>
+    std::vector<bool>
+    useful_bits(const Aut& aut)
+    {
+      std::vector<bool> res = accessible_bits(aut);
+      std::vector<bool> coacc = coaccessible_bits(aut);
+      for (size_t s = 0; s < res.size(); ++s)
+        if (!coacc[s])
+          res[s] = false;
+      return res;
+    }
+
+  namespace internal {
+
+    template <typename Set>
+    void
+    fill_with_bits(Set& res, const std::vector<bool>& bits)
+    {
+      for (state_t s = 0; s < bits.size(); ++s)
+        if (bits[s])
+          res.emplace(s);
+    }
+
+    inline
+    std::set<state_t>
+    set_of_bits(const std::vector<bool>& bits)
+    {
+      std::set<state_t> res;
+      for (state_t s = 0; s < bits.size(); ++s)
+        if (bits[s])
+          res.emplace_hint(res.end(), s);
+      return res;
+    }
+
+    inline
+    size_t
+    count_bits(const std::vector<bool>& bits)
+    {
+      return std::count(bits.begin(), bits.end(), true);
+    }
+  }
+
+
   /*--------------------------------------------------.
   | Sets of accessible, coaccessible, useful states.  |
   `--------------------------------------------------*/
@@ -45,30 +194,7 @@ namespace awali {
     template <typename Set, typename Aut>
     void
     fill_with_accessible_states(Set& res, const Aut& aut, bool include_pre_post=false) {
-      // Reachable states.
-      const auto& a = *aut;
-      if(include_pre_post)
-        res.emplace(a.pre());
-      
-      // States work list.
-      using worklist_t = std::queue<state_t>;
-      worklist_t todo;
-      todo.emplace(a.pre());
-      
-      while (!todo.empty())
-        {
-          const state_t src = todo.front();
-          todo.pop();
-          
-          for (auto tr : a.all_out(src))
-            {
-              state_t dst = a.dst_of(tr);
-              // If we have not seen it already, explore its successors.
-              if(dst != a.post() || include_pre_post)
-                if (res.emplace(dst).second)
-                  todo.emplace(dst);
-            }
-        }
+      internal::fill_with_bits(res, accessible_bits(aut, include_pre_post));
     }
     
   /** @brief List of accessible states
@@ -85,16 +211,13 @@ namespace awali {
     std::set<state_t>
     accessible_states(const Aut& aut, bool include_pre_post=false)
     {
-      // Reachable states.
-      std::set<state_t> res;
-      fill_with_accessible_states(res, aut, include_pre_post);
-      return res;
+      return internal::set_of_bits(accessible_bits(aut, include_pre_post));
     }
 
     template <typename Set, typename Aut>
     void
     fill_with_coaccessible_states(Set& res, const Aut& aut, bool include_pre_post=false) {
-      fill_with_accessible_states(res, transpose_view(aut), false);
+      internal::fill_with_bits(res, coaccessible_bits(aut));
     }
     
     // The set of coaccessible states, including post(), and possibly pre().
@@ -112,7 +235,7 @@ namespace awali {
     std::set<state_t>
     coaccessible_states(const Aut& aut, bool include_pre_post=false)
     {
-      return accessible_states(transpose_view(aut), false);
+      return internal::set_of_bits(coaccessible_bits(aut));
     }
 
     // The set of coaccessible states, including post(), and possibly pre().
@@ -130,9 +253,7 @@ namespace awali {
     std::set<state_t>
     useful_states(const Aut& aut, bool include_pre_post=false)
     {
-      auto accessible = accessible_states(aut, false);
-      auto coaccessible = coaccessible_states(aut, false);
-      return internal::intersection(accessible, coaccessible);
+      return internal::set_of_bits(useful_bits(aut));
     }
 
 
@@ -152,9 +273,7 @@ namespace awali {
     size_t
     num_accessible_states(const Aut& aut)
     {
-      std::unordered_set<state_t> set;
-      fill_with_accessible_states(set,aut);
-      return set.size();
+      return internal::count_bits(accessible_bits(aut));
     }
 
     /** @brief Number of coaccessible states
@@ -169,9 +288,7 @@ namespace awali {
     size_t
     num_coaccessible_states(const Aut& aut)
     {
-      std::unordered_set<state_t> set;
-      fill_with_coaccessible_states(set,aut);
-      return set.size();
+      return internal::count_bits(coaccessible_bits(aut));
     }
 
     /** @brief Number of useful states
@@ -186,8 +303,7 @@ namespace awali {
     size_t
     num_useful_states(const Aut& aut)
     {
-      auto set = useful_states(aut);
-      return set.size();
+      return internal::count_bits(useful_bits(aut));
     }
 
 
@@ -211,7 +327,9 @@ namespace awali {
     typename Aut::element_type::automaton_nocv_t
     accessible(const Aut& aut, bool keep_history=true)
     {
-      return copy(aut, accessible_states(aut), keep_history,false,true);
+      auto bits = accessible_bits(aut);
+      return copy(aut, [&bits](state_t s) { return bits[s]; },
+                  keep_history, false, true);
     }
     
     /** @brief In-place accessible subautomaton
@@ -225,7 +343,8 @@ namespace awali {
     void
     accessible_here(Aut& aut)
     {
-      return sub_automaton(aut, accessible_states(aut));
+      auto bits = accessible_bits(aut);
+      aut->del_states([&bits](state_t s) { return bits[s]; });
     }
 
     /** @brief Coaccessible subautomaton
@@ -244,7 +363,9 @@ namespace awali {
     typename Aut::element_type::automaton_nocv_t
     coaccessible(const Aut& aut, bool keep_history=true)
     {
-      return copy(aut, coaccessible_states(aut), keep_history, false, true);
+      auto bits = coaccessible_bits(aut);
+      return copy(aut, [&bits](state_t s) { return bits[s]; },
+                  keep_history, false, true);
     }
 
     /** @brief In-place coaccessible subautomaton
@@ -258,7 +379,8 @@ namespace awali {
     void
     coaccessible_here(Aut& aut)
     {
-      return sub_automaton(aut, coaccessible_states(aut));
+      auto bits = coaccessible_bits(aut);
+      aut->del_states([&bits](state_t s) { return bits[s]; });
     }
 
     /** @brief Trim subautomaton
@@ -277,12 +399,15 @@ namespace awali {
     typename Aut::element_type::automaton_nocv_t
     trim(const Aut& aut, bool keep_history=true)
     {
-      return copy(aut, useful_states(aut), keep_history, false, true);
+      auto bits = useful_bits(aut);
+      return copy(aut, [&bits](state_t s) { return bits[s]; },
+                  keep_history, false, true);
     }
 
     /** @brief In-place trim subautomaton
      * 
-     * Remove every useless state of aut.
+     * Remove every useless state of aut, in a single pass over the
+     * transitions.
      *
      * @tparam Aut The static type of automaton
      * @param aut A static mutable Awali automaton
@@ -291,7 +416,8 @@ namespace awali {
     void
     trim_here(Aut& aut)
     {
-      return sub_automaton(aut, useful_states(aut));
+      auto bits = useful_bits(aut);
+      aut->del_states([&bits](state_t s) { return bits[s]; });
     }
     
     /*----------------------------------------------------------------.
@@ -66,7 +66,12 @@ namespace awali {
         const auto& ws2 = *aut2->weightset();
         // d = aut1 U -aut2.
         auto d = sum(aut1, left_mult(aut2, ws2.sub(ws2.zero(), ws2.one())));
-        return is_empty(reduce(d));
+        // A difference found modulo a prime is a difference.  The same
+        // computation tells reduce() whether d is already reduced.
+        auto check = internal::check_modular(d);
+        if (check.nonzero)
+          return false;
+        return is_empty(internal::reduce(d, check.reduced));
       }
       
       
@@ -113,12 +118,11 @@ namespace awali {
     difference(const Lhs& aut1, const Rhs& aut2)
     {
       // Meet complement()'s requirements.
-      auto a = aut2;
-      if (!is_deterministic(a))
-        a = complete(determinize(a,false));
-      else if (!is_complete(a))
-        a = complete(a);
-      return product(aut1, complement(a));
+      if (!is_deterministic(aut2))
+        return product(aut1, complement(complete(determinize(aut2,false))));
+      if (!is_complete(aut2))
+        return product(aut1, complement(complete(aut2)));
+      return product(aut1, complement(aut2));
     }
 
     
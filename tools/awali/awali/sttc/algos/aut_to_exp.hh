@@ -17,9 +17,18 @@
 #ifndef AWALI_ALGOS_AUT_TO_EXP_HH
 # define AWALI_ALGOS_AUT_TO_EXP_HH
 
+# include <functional>
+# include <memory>
+# include <queue>
+# include <tuple>
+# include <vector>
+
+#include <awali/common/enums.hh>
 #include <awali/sttc/algos/copy.hh>
 #include <awali/sttc/algos/lift.hh>
+#include <awali/sttc/algos/scc.hh>
 #include <awali/sttc/core/rat/ratexp.hh>
+#include <awali/sttc/core/rat/size.hh>
 #include <awali/sttc/misc/vector.hh>
 #include <awali/sttc/labelset/traits.hh>
 
@@ -93,6 +102,198 @@ namespace awali { namespace sttc {
    }
 /* */
 
+  /*-----------------------------.
+  | Heap of states to eliminate. |
+  `-----------------------------*/
+
+  namespace internal
+  {
+    /** Chooses the states to eliminate by increasing key.
+
+        The keys are kept in a heap.  When a state is chosen, its
+        neighbours are recorded, and their keys are computed again on
+        the next call, that is once the state is eliminated: the
+        elimination of a state only changes the transitions of its
+        predecessors and successors.  Outdated entries of the heap are
+        discarded when they are popped.
+
+        The key of a state is a triple (group, cost, has_loop), and
+        ties are broken by increasing state id:
+
+        - MIN_INOUT_DEGREE: the cost is the in-degree times the
+          out-degree (without the loop), as in next_heuristic;
+
+        - MIN_EXP_SIZE: the cost is the size of the transitions
+          created by the elimination minus the size of the
+          transitions it deletes;
+
+        - SCC_MIN_INOUT_DEGREE: as MIN_INOUT_DEGREE, but the states
+          of the strongly connected components with several states
+          are eliminated first, component by component, in the order
+          of Tarjan's algorithm; the other states come last (following
+          a topological order would duplicate the shared parts of the
+          expression).
+     */
+    template <typename Aut>
+    class elimination_queue
+    {
+    public:
+      using automaton_t = Aut;
+      using weightset_t = weightset_t_of<automaton_t>;
+      using key_t = std::tuple<unsigned, long long, bool>;
+      using entry_t = std::pair<key_t, state_t>;
+
+      elimination_queue(state_elim_order_t order)
+        : order_(order)
+      {}
+
+      state_t operator()(const automaton_t& a)
+      {
+        if (keys_.empty())
+          init_(a);
+        else
+          {
+            // The elimination replaced the weights of the transitions
+            // from the predecessors, and the ids of the deleted
+            // transitions may be reused by the new ones.
+            for (auto p : sources_)
+              if (a->has_state(p))
+                for (auto t : a->all_out(p))
+                  if (t < sizes_.size())
+                    sizes_[t] = 0;
+            for (auto s : touched_)
+              if (s != a->pre() && s != a->post() && a->has_state(s))
+                update_(a, s);
+          }
+        touched_.clear();
+        sources_.clear();
+        while (true)
+          {
+            require(!heap_.empty(), "aut_to_exp: no state to eliminate");
+            entry_t e = heap_.top();
+            heap_.pop();
+            state_t s = e.second;
+            if (!a->has_state(s) || keys_[s] != e.first)
+              continue;
+            for (auto t : a->all_in(s))
+              {
+                touched_.emplace_back(a->src_of(t));
+                sources_.emplace_back(a->src_of(t));
+              }
+            for (auto t : a->all_out(s))
+              touched_.emplace_back(a->dst_of(t));
+            return s;
+          }
+      }
+
+    private:
+      void init_(const automaton_t& a)
+      {
+        keys_.resize(a->max_state() + 1);
+        group_.assign(a->max_state() + 1, 0);
+        if (order_ == SCC_MIN_INOUT_DEGREE)
+          {
+            auto comps = scc_iterative(a).second;
+            unsigned num = 0;
+            for (const auto& comp : comps)
+              if (comp.size() > 1)
+                {
+                  for (auto s : comp)
+                    group_[s] = num;
+                  ++num;
+                }
+            for (const auto& comp : comps)
+              if (comp.size() == 1)
+                group_[comp.front()] = num;
+          }
+        for (auto s : a->states())
+          update_(a, s);
+      }
+
+      void update_(const automaton_t& a, state_t s)
+      {
+        long long in = 0, out = 0;
+        bool has_loop = false;
+        if (order_ == MIN_EXP_SIZE)
+          {
+            long long in_size = 0, out_size = 0, loop_size = 0;
+            for (auto t : a->all_in(s))
+              if (a->src_of(t) != s)
+                {
+                  ++in;
+                  in_size += size_of_(a, t);
+                }
+            for (auto t : a->all_out(s))
+              if (a->dst_of(t) != s)
+                {
+                  ++out;
+                  out_size += size_of_(a, t);
+                }
+              else
+                {
+                  has_loop = true;
+                  loop_size += size_of_(a, t) + 1;
+                }
+            // Every pair (in, out) yields in.loop*.out.
+            long long cost = in_size * out + out_size * in
+              + loop_size * in * out
+              - in_size - out_size - loop_size;
+            keys_[s] = key_t{0, cost, has_loop};
+          }
+        else
+          {
+            // Since we are in LAO, there can be at most one such loop.
+            for (auto t: a->all_out(s))
+              if (a->dst_of(t) != s)
+                ++out;
+              else
+                has_loop = true;
+            in = a->all_in(s).size();
+            keys_[s] = key_t{group_[s], in * out, has_loop};
+          }
+        heap_.emplace(keys_[s], s);
+      }
+
+      /// The size of the weight of \a t, which is a ratexp.
+      size_t size_of_(const automaton_t& a, transition_t t)
+      {
+        if (sizes_.size() <= t)
+          sizes_.resize(t + 1, 0);
+        if (!sizes_[t])
+          sizes_[t] = rat::size<weightset_t>()(a->weight_of(t));
+        return sizes_[t];
+      }
+
+      state_elim_order_t order_;
+      std::priority_queue<entry_t, std::vector<entry_t>,
+                          std::greater<entry_t>> heap_;
+      /// The current key of every state.
+      std::vector<key_t> keys_;
+      /// The component of every state, for SCC_MIN_INOUT_DEGREE.
+      std::vector<unsigned> group_;
+      /// The neighbours of the last chosen state.
+      std::vector<state_t> touched_;
+      /// The predecessors of the last chosen state.
+      std::vector<state_t> sources_;
+      /// The size of the weight of every transition, 0 if unknown.
+      std::vector<size_t> sizes_;
+    };
+  }
+
+  /// A state chooser which eliminates the states in the order \a order.
+  ///
+  /// The chooser keeps its own heap of states; it is meant for a
+  /// single elimination of all the states of an automaton.
+  template <typename Aut>
+  std::function<state_t(const Aut&)>
+  elimination_order(state_elim_order_t order)
+  {
+    if (order == MIN_ID)
+      return next_in_order<Aut>;
+    auto queue = std::make_shared<internal::elimination_queue<Aut>>(order);
+    return [queue](const Aut& a) { return (*queue)(a); };
+  }
+
   /*------------------.
   | eliminate_state.  |
   `------------------*/
@@ -285,7 +486,31 @@ namespace awali { namespace sttc {
   typename Context::ratexp_t
   aut_to_exp(const Aut& a)
   {
-    state_chooser_t<Aut> next = next_heuristic<internal::lifted_automaton_t<Aut>>;
+    state_chooser_t<Aut> next
+      = elimination_order<internal::lifted_automaton_t<Aut>>(MIN_INOUT_DEGREE);
+    return aut_to_exp(a, next);
+  }
+
+    /** State elimination algorithm with a given ordering
+     *
+     * Based on {@link aut_to_exp}; see {@link state_elim_order_t} for
+     * the orderings.  The next state to eliminate is taken from a heap,
+     * where only the keys of the neighbours of the eliminated states
+     * are updated.
+     *
+     * @tparam Aut the type of the automaton
+     * @tparam Context the context of rational expressions
+     * @param a the automaton
+     * @param order the elimination ordering
+     * @return a rational expression describing the behaviour of the automaton
+     */
+  template <typename Aut,
+            typename Context = ratexpset_of<context_t_of<Aut>>>
+  typename Context::ratexp_t
+  aut_to_exp(const Aut& a, state_elim_order_t order)
+  {
+    state_chooser_t<Aut> next
+      = elimination_order<internal::lifted_automaton_t<Aut>>(order);
     return aut_to_exp(a, next);
   }
 
@@ -18,10 +18,15 @@
 # define AWALI_ALGOS_COMPLEMENT_HH
 
 # include <set>
+# include <unordered_map>
+# include <vector>
 
 #include <awali/sttc/algos/copy.hh>
 #include <awali/sttc/algos/is_complete.hh>
 #include <awali/sttc/algos/determinize.hh>
+#include <awali/sttc/algos/minimize_incremental.hh>
+#include <awali/sttc/history/partition_history.hh>
+#include <awali/utils/hash.hh>
 #include <awali/sttc/misc/raise.hh>
 #include <awali/sttc/weightset/fwd.hh> // b
 
@@ -84,6 +89,186 @@ namespace awali { namespace sttc {
     return res;
   }
 
+
+  /*----------------------------.
+  | complement_nfa(automaton).  |
+  `----------------------------*/
+
+  namespace internal {
+
+    /// Subset construction which builds the complement at once.
+    ///
+    /// The empty subset plays the role of the sink state: it is
+    /// final, and all its transitions are loops.  The states of the
+    /// result are final iff their subset contains no final state of
+    /// the input.  Subsets are sorted vectors; the successors of every
+    /// input state are stored by letter in a flat table.
+    template <typename Aut>
+    class nfa_complementer
+    {
+      static_assert(labelset_t_of<Aut>::is_free(),
+                    "complement: requires free labelset");
+      static_assert(std::is_same<weightset_t_of<Aut>, b>::value,
+                    "complement: requires Boolean weights");
+
+    public:
+      using automaton_t = Aut;
+      using automaton_nocv_t = mutable_automaton<context_t_of<Aut>>;
+      using context_t = context_t_of<automaton_t>;
+      using label_t = label_t_of<automaton_t>;
+      using subset_t = std::vector<state_t>;
+
+      nfa_complementer(const automaton_t& a)
+        : input_(a)
+        , output_(make_mutable_automaton<context_t>(a->context()))
+      {
+        std::unordered_map<label_t, unsigned> index;
+        for (auto l : a->labelset()->genset()) {
+          index.emplace(l, letters_.size());
+          letters_.emplace_back(l);
+        }
+        unsigned n = a->max_state() + 1, nl = letters_.size();
+        final_.assign(n, false);
+        for (auto t : a->final_transitions())
+          final_[a->src_of(t)] = true;
+        mark_.assign(n, 0);
+        // Successors of s by the i-th letter:
+        // succ_[succ_begin_[s*nl+i]] to succ_[succ_begin_[s*nl+i+1]-1].
+        succ_begin_.assign(n * nl + 1, 0);
+        for (auto t : a->transitions())
+          ++succ_begin_[a->src_of(t) * nl + index[a->label_of(t)] + 1];
+        for (unsigned i = 0; i < n * nl; ++i)
+          succ_begin_[i + 1] += succ_begin_[i];
+        succ_.resize(succ_begin_[n * nl]);
+        std::vector<unsigned> pos(succ_begin_.begin(), succ_begin_.end() - 1);
+        for (auto t : a->transitions())
+          succ_[pos[a->src_of(t) * nl + index[a->label_of(t)]]++]
+            = a->dst_of(t);
+      }
+
+      automaton_nocv_t operator()()
+      {
+        subset_t init;
+        for (auto t : input_->initial_transitions())
+          init.emplace_back(input_->dst_of(t));
+        std::sort(init.begin(), init.end());
+        init.erase(std::unique(init.begin(), init.end()), init.end());
+        output_->set_initial(state(init));
+        unsigned nl = letters_.size();
+        subset_t next;
+        while (!todo_.empty()) {
+          auto p = todo_.back();
+          todo_.pop_back();
+          const subset_t& ss = *p.first;
+          for (unsigned i = 0; i < nl; ++i) {
+            if (++epoch_ == 0) {
+              // The counter wrapped: the marks are cleared.
+              std::fill(mark_.begin(), mark_.end(), 0);
+              epoch_ = 1;
+            }
+            next.clear();
+            for (auto s : ss)
+              for (unsigned k = succ_begin_[s * nl + i];
+                   k < succ_begin_[s * nl + i + 1]; ++k)
+                if (mark_[succ_[k]] != epoch_) {
+                  mark_[succ_[k]] = epoch_;
+                  next.emplace_back(succ_[k]);
+                }
+            std::sort(next.begin(), next.end());
+            output_->new_transition(p.second, state(next), letters_[i]);
+          }
+        }
+        return output_;
+      }
+
+      void set_history()
+      {
+        auto history
+          = std::make_shared<partition_history<automaton_t>>(input_);
+        output_->set_history(history);
+        for (const auto& p: map_)
+          history->add_state(p.second,
+                             std::set<state_t>(p.first.begin(),
+                                               p.first.end()));
+      }
+
+    private:
+      /// The state for the subset \a ss; schedule it for visit if new.
+      state_t state(const subset_t& ss)
+      {
+        auto i = map_.find(ss);
+        if (i != map_.end())
+          return i->second;
+        state_t res = output_->add_state();
+        bool final = true;
+        for (auto s : ss)
+          if (final_[s]) {
+            final = false;
+            break;
+          }
+        if (final)
+          output_->set_final(res);
+        // Keys of an unordered_map are not moved by rehashing.
+        i = map_.emplace(ss, res).first;
+        todo_.emplace_back(&i->first, res);
+        return res;
+      }
+
+      struct subset_hash
+      {
+        size_t operator()(const subset_t& ss) const
+        {
+          size_t res = 0;
+          for (auto s : ss)
+            std::hash_combine(res, s);
+          return res;
+        }
+      };
+
+      automaton_t input_;
+      automaton_nocv_t output_;
+      std::vector<label_t> letters_;
+      std::vector<bool> final_;
+      std::vector<unsigned> succ_begin_;
+      std::vector<state_t> succ_;
+      /// Input states already in the subset being built.
+      std::vector<unsigned> mark_;
+      unsigned epoch_ = 0;
+      std::unordered_map<subset_t, state_t, subset_hash> map_;
+      std::vector<std::pair<const subset_t*, state_t>> todo_;
+    };
+  }
+
+    /** Complementation of a Boolean automaton
+     *
+     * Computes a complete deterministic automaton which accepts the
+     * complement of the language of \a aut.  The sink state and the
+     * final states are set during the subset construction, hence
+     * neither the determinization nor the completion of \a aut is
+     * built.
+     *
+     * @tparam Aut the type of the automaton
+     * @param aut a Boolean automaton labelled by letters
+     * @param minimal if true, the result is minimized on the fly
+     * @param keep_history if true, every state of the result is linked to a set of states of \a aut
+     * @return a complete deterministic automaton
+     */
+  template <typename Aut>
+  auto
+  complement_nfa(const Aut& aut, bool minimal=false, bool keep_history=true)
+    -> mutable_automaton<context_t_of<Aut>>
+  {
+    if (minimal) {
+      internal::incremental_minimizer<Aut> algo(aut, true, keep_history);
+      return algo();
+    }
+    internal::nfa_complementer<Aut> algo(aut);
+    auto res = algo();
+    if (keep_history)
+      algo.set_history();
+    return res;
+  }
+
 }}//end of ns awali::stc
 
 #endif // !AWALI_ALGOS_COMPLEMENT_HH
@@ -26,6 +26,7 @@
 #include <awali/sttc/algos/product.hh> // join_automata
 #include <awali/sttc/algos/standard.hh>
 #include <awali/sttc/algos/sum.hh>
+#include <awali/sttc/core/cow_automaton.hh>
 #include <awali/sttc/core/mutable_automaton.hh>
 #include <awali/sttc/misc/raise.hh> // require
 
@@ -36,72 +37,85 @@ namespace awali {
       | concatenate(automaton, automaton). |
       `------------------------------------'*/
 
-  /// Append automaton \a b to \a res.
-  ///
     namespace internal {
+      /// Append automaton \a b to \a res without epsilon transition.
+      ///
+      /// The states of \a b are copied into \a res, except its
+      /// initial states without incoming transition.  The transitions
+      /// outgoing from the initial states of \a b are duplicated from
+      /// the final states of \a res, which are made non final (unless
+      /// an initial state of \a b is final).  Neither \a b nor \a res
+      /// need to be standard.
+      ///
       /// \pre The context of \a res must include that of \a b.
-      template <typename A, typename B, typename P>
+      template <typename A, typename B>
       A&
-      concatenate_here(A& res, B b, priority::ONE<P>)
+      concatenate_direct_here(A& res, const B& b)
       {
-        if(!is_standard(b))
-          b=standard(b);
-        //using automaton_t = A;
         auto& ws = *res->weightset();
         auto& ls = *res->labelset();
         auto& wsb = *b->weightset();
         auto& lsb = *b->labelset();
-        
+        using weight_t = typename std::decay<decltype(ws)>::type::value_t;
+
         // The set of the current (left-hand side) final transitions.
         auto ftr_ = res->final_transitions();
         // Store these transitions by copy.
         using transs_t = std::vector<transition_t>;
         transs_t ftr{ begin(ftr_), end(ftr_) };
-        
-        state_t b_initial = b->dst_of(*(b->initial_transitions().begin()));
+
+        // The initial states of b, with their weights.
+        std::vector<std::pair<state_t, weight_t>> initials;
+        for (auto t: b->initial_transitions())
+          initials.emplace_back(b->dst_of(t), ws.conv(wsb, b->weight_of(t)));
+
         // State in B -> state in Res.
-        // The initial state of b is not copied.
-        std::unordered_map<state_t, state_t> m;
-        m.emplace(b->post(), res->post());
-        for (auto s: b->states())
-          if (!b->is_initial(s))
-            m.emplace(s, res->add_state());
-        
-        // Import all the B transitions, except the initial ones
-        // and those from its (genuine) initial state.
-        //
-        // FIXME: provide generalized copy() that returns the map of
-        // states orig -> copy.
-        for (auto t: b->all_transitions())
-          if (b->src_of(t) != b->pre() && b->src_of(t) != b_initial)
-            res->new_transition_copy(m[b->src_of(t)], m[b->dst_of(t)], b, t);
-        
-        // Branch all the final transitions of res to the successors of
-        // b's initial state.
+        auto m = copy_into_map(b, res, [&b](state_t s) {
+            return !b->is_initial(s) || b->all_in(s).size() > 1;
+          });
+        for (const auto& p: initials)
+          if (m[p.first] != res->null_state())
+            res->unset_initial(m[p.first]);
+
+        // With a single initial state in b, the new transitions cannot
+        // collide and are created without lookup.
+        bool single = initials.size() == 1;
         for (auto t1: ftr)
           {
-            // Remove the previous final transition first, as we might add
-            // a final transition for the same state later.
-            //
-            // For instance on "{2}a+({3}\e+{5}a)", the final state s1 of
-            // {2}a will be made final thanks to {3}\e.  So if we compute
-            // the new transitions from s1 and then remove t1, we will
-            // have removed the fact that s1 is final thanks to {3}\e.
-            //
-            // Besides, s1 will become final with weight {3}, which might
-            // interfere with {5}a too.
+            // Remove the final transition first, as the state may be
+            // made final again below.
             auto s1 = res->src_of(t1);
             auto w1 = res->weight_of(t1);
             res->del_transition(t1);
-            for (auto t2: b->all_out(b_initial))
-              res->set_transition(s1,
-                                  m[b->dst_of(t2)],
-                                  ls.conv(lsb,b->label_of(t2)),
-                                  ws.mul(w1, ws.conv(wsb,b->weight_of(t2))));
+            for (const auto& p: initials)
+              {
+                auto w = ws.mul(w1, p.second);
+                for (auto t2: b->all_out(p.first))
+                  {
+                    auto dst = m[b->dst_of(t2)];
+                    auto wt = ws.mul(w, ws.conv(wsb, b->weight_of(t2)));
+                    if (dst == res->post())
+                      res->add_final(s1, wt);
+                    else if (single)
+                      res->new_transition(s1, dst,
+                                          ls.conv(lsb, b->label_of(t2)), wt);
+                    else
+                      res->add_transition(s1, dst,
+                                          ls.conv(lsb, b->label_of(t2)), wt);
+                  }
+              }
           }
         return res;
       }
 
+      /// \pre The context of \a res must include that of \a b.
+      template <typename A, typename B, typename P>
+      A&
+      concatenate_here(A& res, B b, priority::ONE<P>)
+      {
+        return concatenate_direct_here(res, b);
+      }
+
       template <typename A, typename B, typename P>
       auto
       concatenate_here(A& res, B b, priority::TWO<P>) -> typename std::enable_if<labelset_t_of<A>::has_one(),A&>::type
@@ -117,13 +131,11 @@ namespace awali {
         using transs_t = std::vector<transition_t>;
         transs_t ftr{ begin(ftr_), end(ftr_) };
         
-        copier<B,A> cp(b,res);
-        cp([](state_t) { return true; },false,false);
-        const auto& iom=cp.in_out_map();
+        auto m = copy_into_map(b, res);
         //The set of initial states of b in res
           std::unordered_set<state_t> ist;
           for(auto itb : b->initial_transitions())
-            ist.emplace(iom.at(b->dst_of(itb)));
+            ist.emplace(m[b->dst_of(itb)]);
           // The set of the initial transitions of the copy of b in res;
           transs_t itr;
           for(auto tr : res->initial_transitions())
@@ -154,12 +166,16 @@ namespace awali {
      * @tparam B the type of the added automaton
      * @param res the modifed automaton
      * @param aut the added automaton
+     * @param epsilon_free if `true`, no epsilon transition is added,
+     *        even if the labelset of \a res admits them
      * @return the automaton \a res
      */
   template <typename A, typename B>
   A&
-  concatenate_here(A& res, const B& aut)
+  concatenate_here(A& res, const B& aut, bool epsilon_free=false)
   {
+    if (epsilon_free)
+      return internal::concatenate_direct_here(res, aut);
     return internal::concatenate_here(res, aut, priority::value);
   }
     
@@ -176,6 +192,7 @@ namespace awali {
      * by the initial weight in \a aut2.     
      * Otherwise, transitions outgoing from initial states of \a aut2 are
      * duplicated as transitions outgoing from final states of \a aut1, with the same labels and destinations; the weight of the transition is multiplied left by the initial weight in \a aut2 and the final weight in \a aut1.    
+     * The latter construction is also used if \a epsilon_free is `true`.
      * In any case, the final states of \a aut1 are made non final and the
      * initial state of \a aut2 are made non initial.
      *
@@ -183,17 +200,100 @@ namespace awali {
      * @tparam Aut2 the type of the second automaton
      * @param aut1 the first automaton
      * @param aut2 the second automaton
+     * @param epsilon_free if `true`, no epsilon transition is added
      * @return the concatenation of the automata
      */
   template <typename Aut1, typename Aut2>
   inline
   auto
-  concatenate(const Aut1& aut1, const Aut2& aut2)
+  concatenate(const Aut1& aut1, const Aut2& aut2, bool epsilon_free=false)
     -> decltype(join_automata(aut1, aut2))
   {
     auto res = join_automata(aut1, aut2);
     copy_into(aut1, res, false);
-    concatenate_here(res, aut2);
+    concatenate_here(res, aut2, epsilon_free);
+    return res;
+  }
+
+    namespace internal {
+      /// \a aut1 cannot be reused: it has not the type of the result.
+      template <typename Aut1, typename Aut2>
+      auto
+      concatenate_cow(cow_automaton<Aut1>& aut1, const Aut2& aut2,
+                      bool epsilon_free, std::false_type)
+        -> decltype(join_automata(aut1.get(), aut2))
+      {
+        return concatenate(aut1.get(), aut2, epsilon_free);
+      }
+
+      template <typename Aut1, typename Aut2>
+      Aut1
+      concatenate_cow(cow_automaton<Aut1>& aut1, const Aut2& aut2,
+                      bool epsilon_free, std::true_type)
+      {
+        if (aut1.is_shared()
+            || join(aut1->context(), aut2->context()).vname(true)
+               != aut1->context().vname(true))
+          return concatenate(aut1.get(), aut2, epsilon_free);
+        Aut1 res = aut1.get();
+        concatenate_here(res, aut2, epsilon_free);
+        return res;
+      }
+    }
+
+    /** Concatenates two automata, reusing the first one if possible
+     *
+     * This function computes the same automaton as {@link concatenate}.
+     * If the handle \a aut1 is the only owner of its automaton, and if
+     * this automaton has the context of the result, \a aut2 is appended
+     * to it in place and no copy is made; the handle must not be used
+     * afterwards.  Otherwise, \a aut1 is copied.
+     *
+     * @tparam Aut1 the type of the first automaton
+     * @tparam Aut2 the type of the second automaton
+     * @param aut1 a copy-on-write handle on the first automaton
+     * @param aut2 the second automaton
+     * @param epsilon_free if `true`, no epsilon transition is added
+     * @return the concatenation of the automata
+     */
+  template <typename Aut1, typename Aut2>
+  auto
+  concatenate(cow_automaton<Aut1> aut1, const Aut2& aut2,
+              bool epsilon_free=false)
+    -> decltype(join_automata(aut1.get(), aut2))
+  {
+    using res_t = decltype(join_automata(aut1.get(), aut2));
+    return internal::concatenate_cow(aut1, aut2, epsilon_free,
+                                     std::is_same<Aut1, res_t>{});
+  }
+
+    /** Concatenates a list of automata
+     *
+     * The result realizes the Cauchy product of the series realized by
+     * the automata of \a auts, in this order.  It is built in one pass:
+     * the first automaton is copied, then each of the following ones is
+     * appended with the construction without epsilon transitions
+     * described in {@link concatenate}.  Hence, unlike a sequence of
+     * calls to {@link concatenate}, no intermediate result is copied.
+     *
+     * @tparam Aut the type of the automata
+     * @param auts a non empty list of automata
+     * @return the concatenation of the automata
+     * @throw runtime_error if \a auts is empty
+     */
+  template <typename Aut>
+  auto
+  concatenate_all(const std::vector<Aut>& auts)
+    -> decltype(join_automata(auts.front()))
+  {
+    require(!auts.empty(), __func__, ": at least one automaton is needed");
+    auto ctx = auts.front()->context();
+    for (const auto& aut: auts)
+      ctx = join(ctx, aut->context());
+    auto res = make_mutable_automaton(ctx);
+    copy_into(auts.front(), res, false);
+    for (size_t i = 1; i < auts.size(); ++i)
+      internal::concatenate_direct_here(res, auts[i]);
     return res;
   }
 
@@ -225,7 +325,7 @@ namespace awali {
       {
         res = star(aut);
         if (min != 0)
-          res = concatenate(chain(aut, min, min), res);
+          res = concatenate(make_cow_automaton(chain(aut, min, min)), res);
       }
     else
       {
@@ -254,7 +354,7 @@ namespace awali {
             }
             for (int n = 1; n <= max - min; ++n)
               sum = sttc::sum(sum, chain(aut, n, n));
-            res = sttc::concatenate(res, sum);
+            res = sttc::concatenate(make_cow_automaton(std::move(res)), sum);
           }
       }
     return res;
@@ -148,6 +148,49 @@ namespace awali { namespace sttc {
       /// input state -> output state.
       InOutMap out_state;
     };
+
+    /// Fast copy of an automaton; only available between mutable
+    /// automata of the same type, see below.
+    ///
+    /// @return false if the fast copy was not performed.
+    template <typename AutIn, typename AutOut>
+    bool
+    fast_copy(const AutIn&, AutOut&, bool, bool)
+    {
+      return false;
+    }
+
+    /// Index-preserving copy of \a in into the empty automaton \a out.
+    ///
+    /// When the states of \a in are dense, the copier above would
+    /// assign to each state its own index; the state and transition
+    /// tables are therefore copied as a whole instead, which avoids
+    /// the state map and the per-transition insertions.
+    ///
+    /// @return false if the fast copy was not applicable.
+    template <typename Context, typename Storage>
+    bool
+    fast_copy(const std::shared_ptr<mutable_automaton_impl<Context, Storage>>& in,
+              std::shared_ptr<mutable_automaton_impl<Context, Storage>>& out,
+              bool keep_history, bool same_index)
+    {
+      using automaton_t = std::shared_ptr<mutable_automaton_impl<Context, Storage>>;
+      if (!in->has_dense_states() || out->num_all_states() != 2
+          || out->num_initials() != 0 || out->num_finals() != 0)
+        return false;
+      out->copy_content(*in);
+      if (keep_history) {
+        auto history = std::make_shared<single_history<automaton_t>>(in);
+        out->set_history(history);
+        for (auto s : in->all_states())
+          history->add_state(s, s);
+      }
+      if (keep_history || same_index)
+        for (auto s : in->states())
+          if (in->has_name(s))
+            out->set_state_name(s, in->get_state_name(s));
+      return true;
+    }
   }
 
   /// Copy an automaton.
@@ -168,9 +211,48 @@ namespace awali { namespace sttc {
   void
   copy_into(const AutIn& in, AutOut& out, bool keep_history=true, bool transpose=false, bool same_index=false)
   {
+    if (!transpose && internal::fast_copy(in, out, keep_history, same_index))
+      return;
     copy_into(in, out, [](state_t) { return true; }, keep_history, transpose, same_index);
   }
 
+  /// Copy \a in into \a out and return the map of states.
+  ///
+  /// The result is indexed by the states of \a in (including pre() and
+  /// post()) and gives their copy in \a out; the states of \a in
+  /// rejected by \a keep_state are mapped to null_state().  Neither
+  /// the history nor the state names are copied.
+  /// \pre AutIn <: AutOut.
+  template <typename AutIn, typename AutOut, typename Pred>
+  std::vector<state_t>
+  copy_into_map(const AutIn& in, AutOut& out, Pred keep_state)
+  {
+    state_t max = in->post();
+    for (auto s : in->states())
+      if (s > max)
+        max = s;
+    std::vector<state_t> map(max + 1, out->null_state());
+    map[in->pre()] = out->pre();
+    map[in->post()] = out->post();
+    for (auto s : in->states())
+      if (keep_state(s))
+        map[s] = out->add_state();
+    for (auto t : in->all_transitions()) {
+      state_t src = map[in->src_of(t)];
+      state_t dst = map[in->dst_of(t)];
+      if (src != out->null_state() && dst != out->null_state())
+        out->new_transition_copy(src, dst, in, t);
+    }
+    return map;
+  }
+
+  template <typename AutIn, typename AutOut>
+  std::vector<state_t>
+  copy_into_map(const AutIn& in, AutOut& out)
+  {
+    return copy_into_map(in, out, [](state_t) { return true; });
+  }
+
   template <typename AutIn, typename AutOut, typename Pred>
   inline
   void
@@ -219,8 +301,11 @@ namespace awali { namespace sttc {
   AutOut
   copy(const AutIn& input, bool keep_history=true, bool transpose=false, bool same_index=false)
   {
-    return sttc::copy<AutIn, AutOut>(input,
-				     [](state_t) { return true; }, keep_history, transpose, same_index);
+    auto res = make_mutable_automaton(input->context());
+    sttc::copy_into(input, res, keep_history, transpose, same_index);
+    res->set_name(input->get_name());
+    res->set_desc(input->get_desc());
+    return res;
   }
 
   /// A copy of \a input keeping only its states that are members of
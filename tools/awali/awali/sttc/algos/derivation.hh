@@ -26,6 +26,8 @@
 #include <awali/sttc/misc/raise.hh>
 #include <awali/sttc/weightset/polynomialset.hh>
 #include <awali/sttc/labelset/traits.hh>
+#include <awali/sttc/misc/map.hh>
+# include <map>
 # include <stack>
 # include <iostream>
 # include <unordered_map>
@@ -203,6 +205,196 @@ namespace awali { namespace sttc {
       weight_t cst_;
     };
 
+    /// The expansion (or linear form) of a ratexp: its constant
+    /// term, and its derivatives wrt the letters for which they are
+    /// not zero.
+    template <typename RatExpSet>
+    struct expansion
+    {
+      using labelset_t = labelset_t_of<RatExpSet>;
+      using label_t = label_t_of<RatExpSet>;
+      using weight_t = weight_t_of<RatExpSet>;
+      using polynomial_t = ratexp_polynomial_t<RatExpSet>;
+      using polynomials_t = std::map<label_t, polynomial_t,
+                                     internal::less<labelset_t>>;
+
+      weight_t constant;
+      polynomials_t polynomials;
+    };
+
+    /// Compute the expansion of a ratexp, that is all its derivatives
+    /// in a single traversal.
+    ///
+    /// The expansions of the subexpressions are memoized, keyed by
+    /// node: with an interning ratexpset, a subterm shared by several
+    /// ratexps (typically, the derived terms of a same ratexp) is
+    /// expanded only once.
+    template <typename RatExpSet>
+    class expansion_visitor
+      : public RatExpSet::const_visitor
+    {
+    public:
+      using ratexpset_t = RatExpSet;
+      using ratexp_t = typename ratexpset_t::value_t;
+      using weightset_t = weightset_t_of<ratexpset_t>;
+      using weight_t = typename weightset_t::value_t;
+      using polynomialset_t = ratexp_polynomialset_t<ratexpset_t>;
+      using polynomial_t = typename polynomialset_t::value_t;
+      using expansion_t = expansion<ratexpset_t>;
+      using polynomials_t = typename expansion_t::polynomials_t;
+
+      using super_type = typename ratexpset_t::const_visitor;
+      using node_t = typename super_type::node_t;
+
+      constexpr static const char* me() { return "expansion"; }
+
+      expansion_visitor(const ratexpset_t& rs)
+        : rs_(rs)
+      {}
+
+      /// The expansion of \a v; it remains valid as long as this
+      /// visitor.
+      const expansion_t&
+      operator()(const ratexp_t& v)
+      {
+        auto i = memo_.find(v);
+        if (i != memo_.end())
+          return i->second;
+        v->accept(*this);
+        return memo_.emplace(v, std::move(res_)).first->second;
+      }
+
+      AWALI_RAT_UNSUPPORTED(ldiv)
+      AWALI_RAT_UNSUPPORTED(transposition)
+      AWALI_RAT_UNSUPPORTED(conjunction)
+      AWALI_RAT_UNSUPPORTED(shuffle)
+      AWALI_RAT_UNSUPPORTED(complement)
+
+      AWALI_RAT_VISIT(zero, )
+      {
+        res_ = expansion_t{ws_.zero(), {}};
+      }
+
+      AWALI_RAT_VISIT(one, )
+      {
+        res_ = expansion_t{ws_.one(), {}};
+      }
+
+      AWALI_RAT_VISIT(atom, e)
+      {
+        expansion_t res{ws_.zero(), {}};
+        res.polynomials[e.value()] = ps_.one();
+        res_ = std::move(res);
+      }
+
+      AWALI_RAT_VISIT(sum, e)
+      {
+        expansion_t res{ws_.zero(), {}};
+        for (const auto& v: e)
+          {
+            const expansion_t& x = (*this)(v);
+            res.constant = ws_.add(res.constant, x.constant);
+            for (const auto& p: x.polynomials)
+              add_here_(res.polynomials, p.first, p.second);
+          }
+        res_ = std::move(res);
+      }
+
+      AWALI_RAT_VISIT(prod, e)
+      {
+        expansion_t res{ws_.zero(), {}};
+        // The product of the constant terms of the previous factors.
+        weight_t w = ws_.one();
+        for (unsigned i = 0, n = e.size(); i < n && !ws_.is_zero(w); ++i)
+          {
+            const expansion_t& x = (*this)(e[i]);
+            for (const auto& p: x.polynomials)
+              {
+                polynomial_t d = p.second;
+                for (unsigned j = i + 1; j < n; ++j)
+                  d = ps_.rmul_letter(d, e[j]);
+                add_here_(res.polynomials, p.first, ps_.lmul(w, d));
+              }
+            w = ws_.mul(w, x.constant);
+          }
+        res.constant = w;
+        res_ = std::move(res);
+      }
+
+      AWALI_RAT_VISIT(star, e)
+      {
+        const expansion_t& x = (*this)(e.sub());
+        expansion_t res{ws_.star(x.constant), {}};
+        for (const auto& p: x.polynomials)
+          add_here_(res.polynomials, p.first,
+                    ps_.lmul(res.constant,
+                             ps_.rmul_letter(p.second, e.shared_from_this())));
+        res_ = std::move(res);
+      }
+
+      AWALI_RAT_VISIT(maybe, e)
+      {
+        expansion_t res = (*this)(e.sub());
+        res.constant = ws_.add(res.constant, ws_.one());
+        res_ = std::move(res);
+      }
+
+      AWALI_RAT_VISIT(plus, e)
+      {
+        const expansion_t& x = (*this)(e.sub());
+        expansion_t res{ws_.plus(x.constant), {}};
+        ratexp_t star = rs_.star(e.sub());
+        for (const auto& p: x.polynomials)
+          res.polynomials[p.first] = ps_.rmul_letter(p.second, star);
+        res_ = std::move(res);
+      }
+
+      AWALI_RAT_VISIT(lweight, e)
+      {
+        const expansion_t& x = (*this)(e.sub());
+        expansion_t res{ws_.mul(e.weight(), x.constant), {}};
+        for (const auto& p: x.polynomials)
+          add_here_(res.polynomials, p.first, ps_.lmul(e.weight(), p.second));
+        res_ = std::move(res);
+      }
+
+      AWALI_RAT_VISIT(rweight, e)
+      {
+        const expansion_t& x = (*this)(e.sub());
+        expansion_t res{ws_.mul(x.constant, e.weight()), {}};
+        for (const auto& p: x.polynomials)
+          {
+            polynomial_t d;
+            for (const auto& m: p.second)
+              ps_.add_here(d, rs_.rmul(m.first, e.weight()), m.second);
+            add_here_(res.polynomials, p.first, d);
+          }
+        res_ = std::move(res);
+      }
+
+    private:
+      /// Add \a p to the derivative wrt \a l, and drop it if null.
+      void add_here_(polynomials_t& ps, const label_t_of<ratexpset_t>& l,
+                     const polynomial_t& p)
+      {
+        if (p.empty())
+          return;
+        auto& d = ps[l];
+        ps_.add_here(d, p);
+        if (d.empty())
+          ps.erase(l);
+      }
+
+      ratexpset_t rs_;
+      /// Shorthand to the weightset.
+      weightset_t ws_ = *rs_.weightset();
+      polynomialset_t ps_ = make_ratexp_polynomialset(rs_);
+      /// The result of the last visit.
+      expansion_t res_;
+      /// Node -> its expansion.
+      std::unordered_map<ratexp_t, expansion_t> memo_;
+    };
+
   } // rat::
 
   /// Derive a ratexp wrt to a letter.
@@ -288,7 +480,9 @@ namespace awali { namespace sttc {
                                       utils::equal_to<ratexpset_t>>;
 
       derived_termer(const ratexpset_t& rs, bool breaking = false, bool keep_history = true)
-        : rs_(rs)
+          // Derived terms are hashed and compared over and over:
+          // intern them.
+        : rs_(rs.context(), rs.identities(), true)
         , breaking_(breaking)        
         , res_{make_shared_ptr<automaton_t>(rs_.context())}
         , keep_history_(keep_history)
@@ -319,29 +513,33 @@ namespace awali { namespace sttc {
         weightset_t ws = *rs_.weightset();
         // Turn the ratexp into a polynomial.
         {
+          ratexp_t r = rs_.intern(ratexp);
           polynomial_t initial
-            = breaking_ ? split(rs_, ratexp)
-            : polynomial_t{{ratexp, ws.one()}};
+            = breaking_ ? split(rs_, r)
+            : polynomial_t{{r, ws.one()}};
           for (const auto& p: initial)
             // Also loads todo_.
             res_->set_initial(state(p.first), p.second);
         }
 
-        const auto& ls = rs_.labelset()->genset();
-        rat::derivation_visitor<RatExpSet> derivator{rs_};
+        // All the derivatives of a state are computed at once, hence
+        // the letters with a null derivative cost nothing.
+        rat::expansion_visitor<RatExpSet> expand{rs_};
         while (!todo_.empty())
           {
             ratexp_t src = todo_.top();
             auto s = map_[src];
             todo_.pop();
-            res_->set_final(s, constant_term(rs_, src));
-            for (auto l : ls) {
-              auto der = derivator(src, l);
-              if (breaking_)
-                der = split(rs_, der);
- 
-              for (const auto& m: der)
-                res_->add_transition(s, state(m.first), l, m.second);
+            const auto& x = expand(src);
+            res_->set_final(s, x.constant);
+            for (const auto& p : x.polynomials) {
+              if (breaking_) {
+                for (const auto& m: split(rs_, p.second))
+                  res_->add_transition(s, state(m.first), p.first, m.second);
+              }
+              else
+                for (const auto& m: p.second)
+                  res_->add_transition(s, state(m.first), p.first, m.second);
             }
           }
           if(keep_history_) {
@@ -372,6 +570,9 @@ namespace awali { namespace sttc {
   }
 
   /// Derive a ratexp wrt to a string.
+  ///
+  /// The states are computed with the expansions of the derived
+  /// terms, see rat::expansion_visitor.
   template <typename RatExpSet>
   inline
   mutable_automaton<typename RatExpSet::context_t>
@@ -387,7 +387,8 @@ namespace awali { namespace sttc {
         automaton_t aut_;
       };
 
-      using state_nameset_t = polynomialset<context<stateset, weightset_t>>;
+      using state_nameset_t = polynomialset<context<stateset, weightset_t>,
+                                            poly_repr::flat>;
       using state_name_t = typename state_nameset_t::value_t;
 
       /// Build the weighted determinizer.
@@ -19,13 +19,16 @@
 
 # include <algorithm>
 # include <iostream>
-# include <list>
+# include <iterator>
+# include <limits>
 # include <map>
 # include <queue>
+# include <type_traits>
 # include <vector>
 
 #include <awali/sttc/ctx/context.hh>
 //#include <awali/sttc/labelset/labelset.hh>
+#include <awali/sttc/weightset/b.hh>
 #include <awali/sttc/weightset/polynomialset.hh>
 #include <awali/sttc/labelset/traits.hh>
 #include <awali/sttc/algos/accessible.hh>
@@ -40,6 +43,18 @@ namespace awali { namespace sttc {
 
   namespace internal
   {
+    /// Enumeration of the words accepted by an automaton, by
+    /// increasing length.
+    ///
+    /// The automaton is trimmed first, then explored layer by layer:
+    /// the layer of depth n maps every state to the polynomial of the
+    /// words of length n that reach it.  Paths with the same label and
+    /// the same destination are therefore merged, and the size of a
+    /// layer is bounded by the number of distinct words, not by the
+    /// number of paths.
+    ///
+    /// Words are delimited by the special letters carried by the
+    /// initial and final transitions.
     template <typename Aut>
     class enumerater
     {
@@ -59,91 +74,238 @@ namespace awali { namespace sttc {
       using weight_t = weight_t_of<automaton_t>;
       using genset_t = typename labelset_t_of<automaton_t>::genset_t;
       using word_t = typename labelset_t::word_t;
+      using trimmed_t = typename automaton_t::element_type::automaton_nocv_t;
 
       /// Same as polynomial_t::value_type.
       using monomial_t = std::pair<word_t, weight_t>;
-      using queue_t = std::list<std::pair<state_t, monomial_t>>;
+      /// A layer: the polynomial of the words reaching every state.
+      using layer_t = std::map<state_t, polynomial_t>;
 
       enumerater(const automaton_t& aut)
-        : aut_(aut) {}
+        : aut_(trim(aut, false))
+        , ws_(*aut_->weightset())
+        , ps_(get_wordset_context(aut_->context()))
+        , ls_(*ps_.labelset())
+      {
+        if (!is_empty(aut_))
+          layer_[aut_->pre()] = ps_.one();
+      }
 
       /// The weighted accepted word with length at most \a max.
       polynomial_t enumerate(unsigned max)
       {
-        if(is_empty(trim(aut_)))
-          return ps_.zero();
-        queue_t queue;
-        queue.emplace_back(aut_->pre(), ps_.monomial_one());
-
+        polynomial_t res;
         // We match words that include the initial and final special
         // characters.
-        max += 2;
-        for (unsigned i = 0; i < max && !queue.empty(); ++i)
-          propagate_(queue);
-
-        polynomial_t res;
-        // Return the past of post(), but remove the initial and final
-        // special characters for the words.
-        for (const auto& m: achieved_)
-          ps_.add_here(res, ls_.undelimit(m.first), m.second);
+        for (unsigned i = 0; i < max + 2 && !layer_.empty(); ++i)
+          for (const auto& m: next_layer())
+            ps_.add_here(res, ls_.undelimit(m.first), m.second);
         return res;
       }
 
-      /// The shortest accepted weighted words, or throw an exception.
-      // FIXME: code duplication.
+      /// The \a num shortest accepted weighted words.
       polynomial_t shortest(unsigned num)
       {
-        if(is_empty(trim(aut_)))
-          return ps_.zero();
-        queue_t queue;
-        queue.emplace_back(aut_->pre(), ps_.monomial_one());
+        return shortest_(num, std::is_same<weightset_t, b>());
+      }
 
-        polynomial_t res;
-        while (achieved_.size() < num && !queue.empty())
-          propagate_(queue);
+      /// Whether a further call to next_layer() may produce words.
+      bool done() const
+      {
+        return layer_.empty();
+      }
 
-        // Return the past of post(), but remove the initial and final
-        // special characters for the words.
-        for (const auto& m: achieved_)
-          {
+      /// The number of layers computed so far.
+      unsigned depth() const
+      {
+        return depth_;
+      }
+
+      /// Remove the special letters of a word returned by next_layer().
+      word_t undelimit(const word_t& w) const
+      {
+        return ls_.undelimit(w);
+      }
+
+      /// Compute the next layer and return the (delimited) words
+      /// that it accepts.
+      polynomial_t next_layer()
+      {
+        layer_t next;
+        polynomial_t achieved;
+        for (const auto& p: layer_)
+          for (const auto t: aut_->all_out(p.first))
+            {
+              state_t dst = aut_->dst_of(t);
+              polynomial_t& target = dst == aut_->post() ? achieved : next[dst];
+              for (const auto& m: p.second)
+                ps_.add_here(target,
+                             ls_.concat(m.first, aut_->label_of(t)),
+                             ws_.mul(m.second, aut_->weight_of(t)));
+            }
+        // Weights may cancel out.
+        for (auto i = next.begin(); i != next.end(); )
+          if (i->second.empty())
+            i = next.erase(i);
+          else
+            ++i;
+        layer_.swap(next);
+        ++depth_;
+        return achieved;
+      }
+
+    private:
+      /// Weighted automata: the weight of a word is only known once
+      /// all the paths of its length are computed, hence the layers.
+      polynomial_t shortest_(unsigned num, std::false_type)
+      {
+        polynomial_t res;
+        while (res.size() < num && !layer_.empty())
+          for (const auto& m: next_layer())
             ps_.add_here(res, ls_.undelimit(m.first), m.second);
-            if (--num == 0)
-              break;
-          }
+        // The last layer may contain too many words.
+        while (res.size() > num)
+          res.erase(std::prev(res.end()));
         return res;
       }
 
-    private:
-      /// Process once all the states of \a q1.
-      /// Save into q1 the new states to visit.
-      void propagate_(queue_t& q1)
+      /// Boolean automata: best-first exploration of the pairs (word,
+      /// state) in shortlex order.  If \a num words v < w already
+      /// reached a state q, then for every u, the words v.u are
+      /// smaller than w.u, so w.u cannot be one of the \a num
+      /// shortest words: every state is visited by at most \a num
+      /// words.
+      polynomial_t shortest_(unsigned num, std::true_type)
       {
-        queue_t q2;
-        while (!q1.empty())
+        polynomial_t res;
+        if (num == 0 || layer_.empty())
+          return res;
+        using entry_t = std::pair<word_t, state_t>;
+        auto greater = [](const entry_t& e, const entry_t& f) {
+          return wordset_t::less_than(f.first, e.first)
+          || (!wordset_t::less_than(e.first, f.first) && f.second < e.second);
+        };
+        std::priority_queue<entry_t, std::vector<entry_t>, decltype(greater)>
+          queue(greater);
+        state_t max = aut_->post();
+        for (auto s : aut_->states())
+          if (s > max)
+            max = s;
+        std::vector<unsigned> count(max + 1, 0);
+        std::vector<word_t> last(max + 1);
+        queue.emplace(ps_.monomial_one().first, aut_->pre());
+        while (!queue.empty())
           {
-            state_t s;
-            monomial_t m;
-            tie(s, m) = std::move(q1.front());
-            q1.pop_front();
-            for (const auto t: aut_->all_out(s))
+            entry_t e = queue.top();
+            queue.pop();
+            state_t s = e.second;
+            // Pairs are popped in order: duplicates are consecutive.
+            if (count[s] > 0 && last[s] == e.first)
+              continue;
+            if (count[s] == num)
+              continue;
+            ++count[s];
+            last[s] = e.first;
+            if (s == aut_->post())
               {
-                // FIXME: monomial mul.
-                monomial_t n(ls_.concat(m.first, aut_->label_of(t)),
-                             ws_.mul(m.second, aut_->weight_of(t)));
-		if(aut_->dst_of(t) == aut_->post())
-		  ps_.add_here(achieved_, n);
-                q2.emplace_back(aut_->dst_of(t), n);
+                ps_.add_here(res, ls_.undelimit(e.first), ws_.one());
+                if (count[s] == num)
+                  break;
+                continue;
               }
+            for (const auto t: aut_->all_out(s))
+              if (count[aut_->dst_of(t)] < num)
+                queue.emplace(ls_.concat(e.first, aut_->label_of(t)),
+                              aut_->dst_of(t));
           }
-        q1.swap(q2);
+        layer_.clear();
+        return res;
       }
 
-      const automaton_t& aut_;
-      const weightset_t& ws_ = *aut_->weightset();
-      const polynomialset_t ps_{get_wordset_context(aut_->context())};
-      const labelset_t_of<polynomialset_t>& ls_ = *ps_.labelset();
-      /// For each state, the first orders of its past.
-      polynomial_t achieved_;
+      const trimmed_t aut_;
+      const weightset_t& ws_;
+      const polynomialset_t ps_;
+      const labelset_t_of<polynomialset_t>& ls_;
+      /// The current layer.
+      layer_t layer_;
+      unsigned depth_ = 0;
+    };
+
+    /// Lazy enumeration of the words accepted by an automaton, in
+    /// shortlex order.
+    ///
+    /// Layers are computed on demand, hence the enumeration of an
+    /// infinite language can be interrupted at any time.
+    ///
+    /// Weights of paths may cancel out, so that every layer is non
+    /// empty while no word has a non zero weight.  If the series is
+    /// zero on all the words of n consecutive lengths, where n is the
+    /// number of states, it is zero on all the longer words: the
+    /// enumeration stops there.  This holds if the weights are in a
+    /// field or a subring of a field, or if non zero weights never sum
+    /// or multiply to zero.
+    template <typename Aut>
+    class lazy_enumerater
+    {
+    public:
+      using enumerater_t = enumerater<Aut>;
+      using polynomial_t = typename enumerater_t::polynomial_t;
+      using word_t = typename enumerater_t::word_t;
+      using weight_t = typename enumerater_t::weight_t;
+
+      lazy_enumerater(const Aut& aut, unsigned max_length)
+        : enumerater_(aut)
+          // Take the special letters into account.
+        , max_depth_(max_length > std::numeric_limits<unsigned>::max() - 2
+                     ? std::numeric_limits<unsigned>::max()
+                     : max_length + 2)
+          // The special letters shift the first word by two layers.
+        , max_empty_(aut->num_states() + 2)
+        , current_(pending_.end())
+      {}
+
+      lazy_enumerater(const lazy_enumerater& that)
+        : enumerater_(that.enumerater_)
+        , max_depth_(that.max_depth_)
+        , max_empty_(that.max_empty_)
+        , empty_(that.empty_)
+        , pending_(that.pending_)
+        , current_(pending_.begin())
+      {
+        std::advance(current_,
+                     std::distance(that.pending_.begin(), that.current_));
+      }
+
+      /// Get the next word and its weight.
+      /// @return false if there is no more words.
+      bool next(word_t& word, weight_t& weight)
+      {
+        while (current_ == pending_.end())
+          {
+            if (enumerater_.done() || enumerater_.depth() >= max_depth_
+                || empty_ >= max_empty_)
+              return false;
+            pending_ = enumerater_.next_layer();
+            current_ = pending_.begin();
+            empty_ = pending_.empty() ? empty_ + 1 : 0;
+          }
+        word = enumerater_.undelimit(current_->first);
+        weight = current_->second;
+        ++current_;
+        return true;
+      }
+
+    private:
+      enumerater_t enumerater_;
+      unsigned max_depth_;
+      /// The number of consecutive layers without word after which the
+      /// series is zero.
+      size_t max_empty_;
+      /// The number of consecutive layers without word so far.
+      size_t empty_ = 0;
+      /// The words of the last layer, and the next one to return.
+      polynomial_t pending_;
+      typename polynomial_t::const_iterator current_;
     };
   }
 
@@ -166,7 +328,8 @@ namespace awali { namespace sttc {
 
     /** Computes the weight of the \p num smallest words accepted by the automaton.
      *
-     * If less than \p num words are accepted by the automaton \p aut,
+     * The words are ordered by length, then lexicographically.  If
+     * less than \p num words are accepted by the automaton \p aut,
      * the map is partially filled. In particular, if there is no
      * accepted word, the map is empty.
      *
@@ -185,6 +348,35 @@ namespace awali { namespace sttc {
     return enumerater.shortest(num);
   }
 
+    /** Lazily enumerates the words accepted by \p aut, in shortlex order.
+     *
+     * The words are computed on demand by the `next` method of the
+     * result, which returns false when the enumeration is over:
+     * @code
+     * auto it = lazy_enumerate(aut);
+     * word_t w; weight_t k;
+     * while (it.next(w, k))
+     *   ...
+     * @endcode
+     *
+     * @tparam Automaton
+     * @param aut
+     * @param max_length the maximal length of the enumerated words;
+     * unbounded by default.  The enumeration also stops once the
+     * series is shown to be zero on all the longer words; see
+     * internal::lazy_enumerater.
+     * @return an object which gives the words one at a time.
+     * @pre The labelset of the automaton \p aut must be free.
+     */
+  template <typename Automaton>
+  inline
+  internal::lazy_enumerater<Automaton>
+  lazy_enumerate(const Automaton& aut,
+                 unsigned max_length = std::numeric_limits<unsigned>::max())
+  {
+    return internal::lazy_enumerater<Automaton>(aut, max_length);
+  }
+
 }}//end of ns awali::stc
 
 #endif // !AWALI_ALGOS_ENUMERATE_HH
@@ -17,6 +17,7 @@
 #ifndef AWALI_ALGOS_HAS_TWINS_PROPERTY_HH
 # define AWALI_ALGOS_HAS_TWINS_PROPERTY_HH
 
+# include <algorithm>
 # include <stack>
 # include <vector>
 # include <unordered_set>
@@ -27,6 +28,7 @@
 #include <awali/sttc/algos/transpose.hh>
 #include <awali/sttc/algos/product.hh>
 #include <awali/sttc/algos/accessible.hh>
+#include <awali/sttc/misc/pair.hh>
 
 namespace awali { namespace sttc {
 
@@ -48,7 +50,7 @@ namespace awali { namespace sttc {
   template <typename Aut>
   auto
   inverse(const Aut& aut)
-    -> decltype(::sttc::copy(aut))
+    -> decltype(sttc::copy(aut))
   {
     auto res = copy(aut);
     return inverse_here(res);
@@ -271,24 +273,233 @@ namespace awali { namespace sttc {
   | has_twins_property.  |
   `---------------------*/
 
-  /// Whether \a aut has the twins property.
+  /// Witness of the failure of the twins property: a pair of states of
+  /// the automaton, in a strongly connected component of its square,
+  /// with two distinct delays (quotients of the weights of the two
+  /// computations reaching them).
   template <typename Aut>
-  bool has_twins_property(const Aut& aut)
+  struct twins_witness
   {
-    // TODO: Check cycle-unambiguous.
-    auto trim = sttc::trim(aut);
-    auto inv = inverse(trim);
-    auto a = sttc::product(inv, trim);
+    state_t state1;
+    state_t state2;
+    weight_t_of<Aut> delay1;
+    weight_t_of<Aut> delay2;
+  };
+
+  namespace internal
+  {
+    /// On-the-fly check of the twins property.
+    ///
+    /// The square of the trim part of the automaton, whose
+    /// transitions are weighted by the quotient of the weights of the
+    /// two transitions, is built on demand by Tarjan's algorithm.
+    /// Every time a strongly connected component is completed, the
+    /// weights of its cycles are checked, and the exploration stops at
+    /// the first component that fails.
+    template <typename Aut>
+    class twins_checker
+    {
+      using weightset_t = weightset_t_of<Aut>;
+      using weight_t = weight_t_of<Aut>;
+      using labelset_t = labelset_t_of<Aut>;
+      using pair_t = std::pair<state_t, state_t>;
+      using edge_t = std::pair<unsigned, weight_t>;
+      static constexpr unsigned none = -1U;
+
+    public:
+      twins_checker(const Aut& aut)
+        : aut_(aut)
+        , ws_(*aut->weightset())
+      {
+        state_t max = aut_->post();
+        for (auto s : aut_->states())
+          if (s > max)
+            max = s;
+        std::vector<bool> useful(max + 1, false);
+        for (auto s : useful_states(aut_))
+          useful[s] = true;
+        out_.resize(max + 1);
+        for (auto s : aut_->states())
+          if (useful[s]) {
+            for (auto t : aut_->out(s))
+              if (useful[aut_->dst_of(t)])
+                out_[s].emplace_back(t);
+            std::sort(out_[s].begin(), out_[s].end(),
+                      [this](transition_t t, transition_t u) {
+                        return labelset_t::less_than(aut_->label_of(t),
+                                                     aut_->label_of(u));
+                      });
+          }
+        for (auto t : aut_->initial_transitions())
+          if (useful[aut_->dst_of(t)])
+            initials_.emplace_back(aut_->dst_of(t));
+      }
+
+      bool operator()(twins_witness<Aut>& witness)
+      {
+        for (auto p : initials_)
+          for (auto q : initials_) {
+            unsigned root = state_({p, q});
+            if (index_[root] == none && !tarjan_(root, witness))
+              return false;
+          }
+        return true;
+      }
+
+    private:
+      unsigned state_(const pair_t& pq)
+      {
+        auto i = map_.find(pq);
+        if (i != map_.end())
+          return i->second;
+        unsigned res = states_.size();
+        map_.emplace(pq, res);
+        states_.emplace_back(pq);
+        index_.push_back(none);
+        low_.push_back(0);
+        component_.push_back(none);
+        edges_.emplace_back();
+        return res;
+      }
+
+      /// Compute the transitions of the square leaving \a s.
+      void expand_(unsigned s)
+      {
+        const auto& lo = out_[states_[s].first];
+        const auto& ro = out_[states_[s].second];
+        std::vector<edge_t> res;
+        auto j = ro.begin();
+        for (auto t : lo) {
+          const auto& l = aut_->label_of(t);
+          while (j != ro.end() && labelset_t::less_than(aut_->label_of(*j), l))
+            ++j;
+          for (auto k = j; k != ro.end() && labelset_t::equals(aut_->label_of(*k), l); ++k)
+            res.emplace_back(state_({aut_->dst_of(t), aut_->dst_of(*k)}),
+                             ws_.mul(ws_.rdiv(ws_.one(), aut_->weight_of(t)),
+                                     aut_->weight_of(*k)));
+        }
+        edges_[s] = std::move(res);
+      }
 
-    // Find all components of automate a.
-    auto cs = components(a);
+      /// Iterative Tarjan algorithm from \a root; false if a component
+      /// fails the check.
+      bool tarjan_(unsigned root, twins_witness<Aut>& witness)
+      {
+        std::vector<unsigned> call_stack, next;
+        auto visit = [&](unsigned v) {
+          index_[v] = low_[v] = count_++;
+          expand_(v);
+          stack_.emplace_back(v);
+          call_stack.emplace_back(v);
+          if (next.size() < states_.size())
+            next.resize(states_.size());
+          next[v] = 0;
+        };
+        visit(root);
+        while (!call_stack.empty()) {
+          unsigned v = call_stack.back();
+          if (next[v] < edges_[v].size()) {
+            unsigned w = edges_[v][next[v]++].first;
+            if (index_[w] == none)
+              visit(w);
+            else if (component_[w] == none)
+              low_[v] = std::min(low_[v], index_[w]);
+            continue;
+          }
+          call_stack.pop_back();
+          if (!call_stack.empty())
+            low_[call_stack.back()] = std::min(low_[call_stack.back()], low_[v]);
+          if (low_[v] == index_[v]) {
+            unsigned w;
+            do {
+              w = stack_.back();
+              stack_.pop_back();
+              component_[w] = num_components_;
+            } while (w != v);
+            if (!check_(v, witness))
+              return false;
+            ++num_components_;
+          }
+        }
+        return true;
+      }
 
-    // Check unique weight of two states on each component.
-    for (auto c : cs)
-      if (!cycle_identity(c, a))
-        return false;
+      /// Whether the cycles of the component of \a root have weight
+      /// one, that is, whether every state of the component has a
+      /// single delay w.r.t. \a root.
+      bool check_(unsigned root, twins_witness<Aut>& witness)
+      {
+        unsigned c = component_[root];
+        std::unordered_map<unsigned, weight_t> delay;
+        delay.emplace(root, ws_.one());
+        std::vector<unsigned> todo{root};
+        while (!todo.empty()) {
+          unsigned s = todo.back();
+          todo.pop_back();
+          for (const auto& e : edges_[s]) {
+            if (component_[e.first] != c)
+              continue;
+            weight_t w = ws_.mul(delay[s], e.second);
+            auto i = delay.find(e.first);
+            if (i == delay.end()) {
+              delay.emplace(e.first, w);
+              todo.emplace_back(e.first);
+            }
+            else if (!ws_.equals(i->second, w)) {
+              witness = {states_[e.first].first, states_[e.first].second,
+                         i->second, w};
+              return false;
+            }
+          }
+        }
+        return true;
+      }
 
-    return true;
+      const Aut& aut_;
+      const weightset_t& ws_;
+      /// Outgoing transitions to useful states, sorted by label.
+      std::vector<std::vector<transition_t>> out_;
+      std::vector<state_t> initials_;
+      /// States of the square.
+      std::vector<pair_t> states_;
+      std::unordered_map<pair_t, unsigned> map_;
+      std::vector<std::vector<edge_t>> edges_;
+      /// Tarjan's algorithm.
+      std::vector<unsigned> index_;
+      std::vector<unsigned> low_;
+      std::vector<unsigned> component_;
+      std::vector<unsigned> stack_;
+      unsigned count_ = 0;
+      unsigned num_components_ = 0;
+    };
+
+    template <typename Aut>
+    constexpr unsigned twins_checker<Aut>::none;
+  }
+
+  /** Whether \a aut has the twins property
+   *
+   * The square of the automaton is explored on the fly, and the
+   * exploration stops at the first strongly connected component that
+   * does not satisfy the property.
+   *
+   * @param aut an automaton over a weightset with division
+   * @param witness set if \a aut does not have the twins property
+   */
+  template <typename Aut>
+  bool has_twins_property(const Aut& aut, twins_witness<Aut>& witness)
+  {
+    // TODO: Check cycle-unambiguous.
+    internal::twins_checker<Aut> check(aut);
+    return check(witness);
+  }
+
+  /// Whether \a aut has the twins property.
+  template <typename Aut>
+  bool has_twins_property(const Aut& aut)
+  {
+    twins_witness<Aut> witness;
+    return has_twins_property(aut, witness);
   }
 
 }}//end of ns awali::stc
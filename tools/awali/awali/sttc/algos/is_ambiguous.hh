@@ -17,31 +17,442 @@
 #ifndef AWALI_ALGOS_IS_AMBIGUOUS_HH
 # define AWALI_ALGOS_IS_AMBIGUOUS_HH
 
-#include <awali/sttc/algos/accessible.hh>
-#include <awali/sttc/algos/product.hh>
-#include <awali/sttc/history/tuple_history.hh>
+# include <algorithm>
+# include <unordered_map>
+# include <unordered_set>
+# include <utility>
+# include <vector>
+
+#include <awali/common/enums.hh>
+#include <awali/sttc/ctx/traits.hh>
+#include <awali/sttc/misc/pair.hh>
 
 namespace awali { namespace sttc {
 
+  namespace internal
+  {
+    /// Transitions of the useful part of an automaton, sorted by
+    /// label, as used by the explorations of its square and cube.
+    template <typename Aut>
+    class ambiguity_base
+    {
+    protected:
+      using labelset_t = labelset_t_of<Aut>;
+      using label_t = label_t_of<Aut>;
+      static constexpr unsigned none = -1U;
+
+      ambiguity_base(const Aut& aut)
+        : aut_(aut)
+      {
+        state_t max = aut_->post();
+        for (auto s : aut_->states())
+          if (s > max)
+            max = s;
+        // Coaccessible states, then useful states.
+        std::vector<char> coacc(max + 1, false);
+        std::vector<state_t> todo{aut_->post()};
+        coacc[aut_->post()] = true;
+        while (!todo.empty()) {
+          state_t s = todo.back();
+          todo.pop_back();
+          for (auto t : aut_->all_in(s))
+            if (!coacc[aut_->src_of(t)]) {
+              coacc[aut_->src_of(t)] = true;
+              todo.emplace_back(aut_->src_of(t));
+            }
+        }
+        useful_.assign(max + 1, false);
+        for (auto t : aut_->initial_transitions())
+          if (coacc[aut_->dst_of(t)] && !useful_[aut_->dst_of(t)]) {
+            useful_[aut_->dst_of(t)] = true;
+            todo.emplace_back(aut_->dst_of(t));
+            initials_.emplace_back(aut_->dst_of(t));
+          }
+        while (!todo.empty()) {
+          state_t s = todo.back();
+          todo.pop_back();
+          for (auto t : aut_->out(s))
+            if (coacc[aut_->dst_of(t)] && !useful_[aut_->dst_of(t)]) {
+              useful_[aut_->dst_of(t)] = true;
+              todo.emplace_back(aut_->dst_of(t));
+            }
+        }
+        out_.resize(max + 1);
+        for (auto s : aut_->states())
+          if (useful_[s]) {
+            for (auto t : aut_->out(s))
+              if (useful_[aut_->dst_of(t)])
+                out_[s].emplace_back(t);
+            std::sort(out_[s].begin(), out_[s].end(),
+                      [this](transition_t t, transition_t u) {
+                        return labelset_t::less_than(aut_->label_of(t),
+                                                     aut_->label_of(u));
+                      });
+          }
+      }
+
+      /// Call \a f(label, dst1, dst2) for every pair of transitions
+      /// with the same label leaving \a p and \a q.
+      template <typename F>
+      void pairs_(state_t p, state_t q, F f) const
+      {
+        const auto& po = out_[p];
+        const auto& qo = out_[q];
+        auto j = qo.begin();
+        for (auto t : po) {
+          const auto& l = aut_->label_of(t);
+          while (j != qo.end() && labelset_t::less_than(aut_->label_of(*j), l))
+            ++j;
+          for (auto k = j;
+               k != qo.end() && labelset_t::equals(aut_->label_of(*k), l); ++k)
+            f(l, aut_->dst_of(t), aut_->dst_of(*k));
+        }
+      }
+
+      const Aut& aut_;
+      /// Whether a state is accessible and coaccessible.
+      std::vector<char> useful_;
+      /// Useful initial states.
+      std::vector<state_t> initials_;
+      /// Transitions to useful states, sorted by label.
+      std::vector<std::vector<transition_t>> out_;
+    };
+
+    template <typename Aut>
+    constexpr unsigned ambiguity_base<Aut>::none;
+
+    /// On-the-fly search of an ambiguous word.
+    ///
+    /// The square of the automaton is explored breadth-first from the
+    /// pairs of initial states, only through pairs of useful states.
+    /// Every time a pair outside of the diagonal is reached, a search
+    /// for a pair of final states is run from it; the pairs that fail
+    /// are remembered, so that the whole exploration remains linear in
+    /// the size of the square, and it stops at the first success.
+    template <typename Aut>
+    class ambiguity_checker : protected ambiguity_base<Aut>
+    {
+      using super_t = ambiguity_base<Aut>;
+      using typename super_t::label_t;
+      using super_t::none;
+      using super_t::aut_;
+      using super_t::initials_;
+      using pair_t = std::pair<state_t, state_t>;
+
+    public:
+      using word_t = typename labelset_t_of<Aut>::word_t;
+
+      ambiguity_checker(const Aut& aut)
+        : super_t(aut)
+      {}
+
+      /// Whether the automaton is ambiguous; if so, \a witness is a
+      /// word with two accepting runs.
+      bool operator()(word_t& witness)
+      {
+        for (auto p : initials_)
+          for (auto q : initials_)
+            if (visit_({p, q}, none, nullptr) && p != q
+                && found_(states_.size() - 1, witness))
+              return true;
+        for (unsigned i = 0; i < states_.size(); ++i) {
+          bool res = false;
+          pair_t pq = states_[i];
+          // The successors of a dead pair are dead.
+          if (dead_.find(pq) != dead_.end())
+            continue;
+          this->pairs_(pq.first, pq.second,
+                       [&](const label_t& l, state_t p, state_t q) {
+                         if (!res && visit_({p, q}, i, &l) && p != q)
+                           res = found_(states_.size() - 1, witness);
+                       });
+          if (res)
+            return true;
+        }
+        return false;
+      }
+
+    private:
+      /// Add \a pq to the exploration if it is new.
+      bool visit_(const pair_t& pq, unsigned parent, const label_t* l)
+      {
+        if (!map_.emplace(pq, states_.size()).second)
+          return false;
+        states_.emplace_back(pq);
+        parent_.emplace_back(parent, l ? *l : label_t());
+        return true;
+      }
+
+      /// Whether a pair of final states is reachable from the pair
+      /// \a i; if so, set \a witness.
+      bool found_(unsigned i, word_t& witness)
+      {
+        if (dead_.find(states_[i]) != dead_.end())
+          return false;
+        std::vector<pair_t> todo{states_[i]};
+        std::vector<std::pair<unsigned, label_t>> from{{none, label_t()}};
+        std::unordered_set<pair_t> seen{states_[i]};
+        for (unsigned k = 0; k < todo.size(); ++k) {
+          pair_t pq = todo[k];
+          if (aut_->is_final(pq.first) && aut_->is_final(pq.second)) {
+            witness.clear();
+            for (unsigned j = i; parent_[j].first != none; j = parent_[j].first)
+              witness.push_back(parent_[j].second);
+            std::reverse(witness.begin(), witness.end());
+            word_t cont;
+            for (unsigned j = k; from[j].first != none; j = from[j].first)
+              cont.push_back(from[j].second);
+            witness.insert(witness.end(), cont.rbegin(), cont.rend());
+            return true;
+          }
+          this->pairs_(pq.first, pq.second,
+                       [&](const label_t& l, state_t p, state_t q) {
+                         pair_t d{p, q};
+                         if (dead_.find(d) == dead_.end()
+                             && seen.emplace(d).second) {
+                           todo.emplace_back(d);
+                           from.emplace_back(k, l);
+                         }
+                       });
+        }
+        for (const auto& pq : todo)
+          dead_.emplace(pq);
+        return false;
+      }
+
+      /// Explored pairs, with their parent and the label from it.
+      std::vector<pair_t> states_;
+      std::vector<std::pair<unsigned, label_t>> parent_;
+      std::unordered_map<pair_t, unsigned> map_;
+      /// Pairs from which no pair of final states is reachable.
+      std::unordered_set<pair_t> dead_;
+    };
+    /// Degree of ambiguity of an automaton.
+    ///
+    /// The automaton is exponentially ambiguous iff some strongly
+    /// connected component of its square contains a pair on the
+    /// diagonal and a pair outside of it (a state with two distinct
+    /// cycles with the same label).  Otherwise, it is polynomially
+    /// ambiguous iff there are two distinct states p and q and a word
+    /// v labelling a cycle on p, a cycle on q and a run from p to q,
+    /// that is, iff (p,q,q) is reachable from (p,p,q) in the cube.
+    template <typename Aut>
+    class ambiguity_classifier : protected ambiguity_base<Aut>
+    {
+      using super_t = ambiguity_base<Aut>;
+      using typename super_t::label_t;
+      using typename super_t::labelset_t;
+      using super_t::none;
+      using super_t::aut_;
+      using super_t::useful_;
+      using super_t::out_;
+
+    public:
+      ambiguity_classifier(const Aut& aut)
+        : super_t(aut)
+      {}
+
+      ambiguity_t operator()()
+      {
+        typename labelset_t::word_t witness;
+        if (!ambiguity_checker<Aut>(aut_)(witness))
+          return UNAMBIGUOUS;
+        if (is_exponential_())
+          return EXPONENTIALLY_AMBIGUOUS;
+        if (is_polynomial_())
+          return POLYNOMIALLY_AMBIGUOUS;
+        return FINITELY_AMBIGUOUS;
+      }
+
+    private:
+      using pair_t = std::pair<state_t, state_t>;
+
+      /// Iterative Tarjan algorithm on a graph given by adjacency
+      /// lists; returns the component of every vertex.
+      static std::vector<unsigned>
+      components_(const std::vector<std::vector<unsigned>>& succ)
+      {
+        unsigned n = succ.size();
+        std::vector<unsigned> res(n, none), index(n, none), low(n), next(n);
+        std::vector<unsigned> stack, call_stack;
+        unsigned count = 0, num = 0;
+        for (unsigned root = 0; root < n; ++root) {
+          if (index[root] != none)
+            continue;
+          index[root] = low[root] = count++;
+          next[root] = 0;
+          stack.emplace_back(root);
+          call_stack.emplace_back(root);
+          while (!call_stack.empty()) {
+            unsigned v = call_stack.back();
+            if (next[v] < succ[v].size()) {
+              unsigned w = succ[v][next[v]++];
+              if (index[w] == none) {
+                index[w] = low[w] = count++;
+                next[w] = 0;
+                stack.emplace_back(w);
+                call_stack.emplace_back(w);
+              }
+              else if (res[w] == none)
+                low[v] = std::min(low[v], index[w]);
+              continue;
+            }
+            call_stack.pop_back();
+            if (!call_stack.empty())
+              low[call_stack.back()] = std::min(low[call_stack.back()], low[v]);
+            if (low[v] == index[v]) {
+              unsigned w;
+              do {
+                w = stack.back();
+                stack.pop_back();
+                res[w] = num;
+              } while (w != v);
+              ++num;
+            }
+          }
+        }
+        return res;
+      }
+
+      /// Whether a component of the part of the square reachable from
+      /// the diagonal has pairs on and outside of the diagonal.
+      bool is_exponential_()
+      {
+        std::vector<pair_t> pairs;
+        std::unordered_map<pair_t, unsigned> map;
+        std::vector<std::vector<unsigned>> succ;
+        auto index = [&](const pair_t& pq) {
+          auto i = map.emplace(pq, pairs.size());
+          if (i.second) {
+            pairs.emplace_back(pq);
+            succ.emplace_back();
+          }
+          return i.first->second;
+        };
+        for (auto s : aut_->states())
+          if (useful_[s])
+            index({s, s});
+        for (unsigned i = 0; i < pairs.size(); ++i) {
+          pair_t pq = pairs[i];
+          this->pairs_(pq.first, pq.second,
+                       [&](const label_t&, state_t p, state_t q) {
+                         unsigned j = index({p, q});
+                         succ[i].emplace_back(j);
+                       });
+        }
+        auto comp = components_(succ);
+        std::vector<char> diag(pairs.size(), false), off(pairs.size(), false);
+        for (unsigned i = 0; i < pairs.size(); ++i) {
+          unsigned c = comp[i];
+          (pairs[i].first == pairs[i].second ? diag : off)[c] = true;
+          if (diag[c] && off[c])
+            return true;
+        }
+        return false;
+      }
+
+      /// Whether (p,q,q) is reachable from (p,p,q) in the cube, for
+      /// some p != q.  Since the automaton is not exponentially
+      /// ambiguous, p and q belong to distinct components, and the
+      /// first (resp. last) state of the triples may be restricted to
+      /// the component of p (resp. q).
+      bool is_polynomial_()
+      {
+        std::size_t n = useful_.size();
+        std::vector<std::vector<unsigned>> succ(n);
+        for (auto s : aut_->states())
+          if (useful_[s])
+            for (auto t : out_[s])
+              succ[s].emplace_back(aut_->dst_of(t));
+        auto comp = components_(succ);
+        // Whether the component of a state has a cycle.
+        std::vector<char> cyclic(n, false);
+        for (auto s : aut_->states())
+          if (useful_[s])
+            for (auto t : out_[s])
+              if (comp[aut_->dst_of(t)] == comp[s])
+                cyclic[comp[s]] = true;
+        using triple_t = std::pair<pair_t, state_t>;
+        std::unordered_set<triple_t> seen;
+        std::vector<triple_t> todo;
+        for (auto p : aut_->states())
+          if (useful_[p] && cyclic[comp[p]])
+            for (auto q : aut_->states())
+              if (useful_[q] && comp[q] != comp[p] && cyclic[comp[q]]) {
+                seen.clear();
+                todo.assign(1, {{p, p}, q});
+                seen.emplace(todo[0]);
+                while (!todo.empty()) {
+                  triple_t xyz = todo.back();
+                  todo.pop_back();
+                  if (xyz.first.first == p && xyz.first.second == q
+                      && xyz.second == q)
+                    return true;
+                  state_t y = xyz.first.second;
+                  const auto& yo = out_[y];
+                  this->pairs_(xyz.first.first, xyz.second,
+                               [&](const label_t& l, state_t x, state_t z) {
+                                 if (comp[x] != comp[p] || comp[z] != comp[q])
+                                   return;
+                                 auto j = std::lower_bound
+                                   (yo.begin(), yo.end(), l,
+                                    [this](transition_t t, const label_t& a) {
+                                     return labelset_t::less_than
+                                       (aut_->label_of(t), a);
+                                   });
+                                 for (; j != yo.end()
+                                        && labelset_t::equals(aut_->label_of(*j), l);
+                                      ++j) {
+                                   triple_t d{{x, aut_->dst_of(*j)}, z};
+                                   if (seen.emplace(d).second)
+                                     todo.emplace_back(d);
+                                 }
+                               });
+                }
+              }
+        return false;
+      }
+    };
+  }
+
+  /** Whether \a aut is ambiguous.
+   *
+   * An automaton is ambiguous if some word is the label of two
+   * distinct accepting runs.  The square of the automaton is explored
+   * on the fly, and the exploration stops at the first pair of states
+   * outside of the diagonal which is both accessible and coaccessible.
+   *
+   * @param aut an automaton labelled by letters
+   * @param witness set to a word with two accepting runs, if any
+   */
+  template <typename Aut>
+  bool is_ambiguous(const Aut& aut,
+                    typename labelset_t_of<Aut>::word_t& witness)
+  {
+    internal::ambiguity_checker<Aut> check(aut);
+    return check(witness);
+  }
+
+  /// Whether \a aut is ambiguous.
   template <typename Aut>
   bool is_ambiguous(const Aut& aut)
   {
-    auto prod = product(aut, aut);
-    // Check if there useful states outside of the diagonal.  Since
-    // the product is accessible, check only for coaccessibles states.
-    auto coaccessible = coaccessible_states(prod);
-    for (const auto& o: dynamic_cast<tuple_history<std::tuple<Aut,Aut>>*>(prod->history().get())->origins())
-      if (std::get<0>(o.second) != std::get<1>(o.second)
-          && coaccessible.find(o.first)!=coaccessible.end())
-        {
-          if (getenv("AWALI_DEBUG"))
-            std::cerr << "ambiguous: " << o.first - 2
-                      << " (" << std::get<0>(o.second) - 2
-                      << ", " << std::get<1>(o.second) - 2 << ")"
-                      << std::endl;
-          return true;
-        }
-    return false;
+    typename labelset_t_of<Aut>::word_t witness;
+    return is_ambiguous(aut, witness);
+  }
+
+  /** Degree of ambiguity of \a aut.
+   *
+   * The number of accepting runs of a word of length n is either at
+   * most one, bounded, polynomial in n, or exponential in n.  Only
+   * the support of \a aut is considered; the weights are ignored.
+   *
+   * @param aut an automaton labelled by letters
+   */
+  template <typename Aut>
+  ambiguity_t ambiguity_degree(const Aut& aut)
+  {
+    return internal::ambiguity_classifier<Aut>(aut)();
   }
 
 }}//end of ns awali::stc
@@ -17,8 +17,11 @@
 #ifndef AWALI_ALGOS_IS_FUNCTIONAL_HH
 #define AWALI_ALGOS_IS_FUNCTIONAL_HH
 
-# include <stack>
+# include <algorithm>
+# include <string>
 # include <unordered_map>
+# include <utility>
+# include <vector>
 
 #include <awali/sttc/labelset/tupleset.hh>
 //#include <awali/sttc/misc/sub-tuple.hh> // make_index_sequence
@@ -27,84 +30,331 @@
 #include <awali/sttc/algos/proper.hh>
 #include <awali/sttc/algos/partial_identity.hh>
 #include <awali/sttc/algos/compose.hh>
+#include <awali/sttc/algos/accessible.hh>
+#include <awali/sttc/misc/pair.hh>
 
 
 namespace awali { namespace sttc {
 
-  template <typename Tdc>
-  bool is_functional(Tdc& transducer)
+  /// Witness of the non-functionality of a transducer: an input word
+  /// with two distinct outputs.
+  struct functionality_witness
   {
-    auto inv = sttc::projections<1,0>(transducer);
-    auto tdc = compose(inv, transducer);
-    trim_here(tdc);
-    std::unordered_map<unsigned, std::pair<std::string,std::string>> valuations;
-    std::stack<unsigned> todo;
-
-    std::pair<std::string,std::string> base{"",""};
-    using labelset_t = typename labelset_t_of<Tdc>::template valueset_t<1>;
-
-    for(auto ti : tdc->initial_transitions()) {
-      //if the initial state has already been met
-      auto it1 = valuations.find(tdc->dst_of(ti));
-      if(it1 != valuations.end()) {
-        //it should have a trivial valuation
-        if(it1->second != base)
-          return false;
-      }
-      else {
-        valuations.emplace(std::make_pair(tdc->dst_of(ti),base));
-        todo.emplace(tdc->dst_of(ti));
-      }
-      while(!todo.empty()) {
-        unsigned s = todo.top();
-        todo.pop();
-        //retrieve the valuation of state s:
-        auto valuation = valuations.find(s)->second;
-        for(auto tr : tdc->all_out(s)) {
-          unsigned t = tdc->dst_of(tr);
-          if(t == tdc->post()) {
-            //if s is final it should have a trivial valuation
-            if(valuation != base)
-              return false;
+    std::string input;
+    std::string output1;
+    std::string output2;
+  };
+
+  namespace internal
+  {
+    /// On-the-fly check of the functionality of a transducer.
+    ///
+    /// The pairs of computations with the same input are explored in
+    /// the square of the transducer, built on demand; every pair of
+    /// states is labelled with the delay between the two outputs (the
+    /// outputs minus their longest common prefix).  The transducer is
+    /// not functional iff some useful pair of states has two delays,
+    /// or a delay with two non-empty components, or is final with a
+    /// non-trivial delay.  When a pair of states breaks this rule, its
+    /// coaccessibility is checked (on demand as well), and the
+    /// exploration stops at the first genuine failure.
+    ///
+    /// As in composition, a computation of the second component alone
+    /// on an epsilon input may not be followed by a computation of the
+    /// first one alone; this ensures that every pair of computations
+    /// is represented once.
+    template <typename Tdc>
+    class functionality_checker
+    {
+      using labelset_t = labelset_t_of<Tdc>;
+      using in_labelset_t = typename labelset_t::template valueset_t<0>;
+      using out_labelset_t = typename labelset_t::template valueset_t<1>;
+      using delay_t = std::pair<std::string, std::string>;
+      /// Two states of the transducer, and whether the second
+      /// computation moved alone since the last common input letter.
+      using triple_t = std::pair<std::pair<state_t, state_t>, bool>;
+
+      /// A transition of the square; one of its components is
+      /// null_transition() if the other computation moves alone.
+      struct move_t
+      {
+        unsigned dst;
+        transition_t t1;
+        transition_t t2;
+      };
+      using path_t = std::vector<move_t>;
+
+      static constexpr unsigned none = -1U;
+
+    public:
+      functionality_checker(const Tdc& tdc)
+        : tdc_(tdc)
+      {
+        state_t max = tdc_->post();
+        for (auto s : tdc_->states())
+          if (s > max)
+            max = s;
+        useful_.assign(max + 1, false);
+        for (auto s : useful_states(tdc_))
+          useful_[s] = true;
+        eps_out_.resize(max + 1);
+        letter_out_.resize(max + 1);
+        for (auto s : tdc_->states())
+          if (useful_[s]) {
+            for (auto t : tdc_->out(s))
+              if (!useful_[tdc_->dst_of(t)])
+                continue;
+              else if (is_epsilon<in_labelset_t>(input_(t)))
+                eps_out_[s].emplace_back(t);
+              else
+                letter_out_[s].emplace_back(t);
+            std::sort(letter_out_[s].begin(), letter_out_[s].end(),
+                      [this](transition_t t, transition_t u) {
+                        return in_labelset_t::less_than(input_(t), input_(u));
+                      });
           }
-          else {
-            auto l= tdc->label_of(tr);
-            //the valuation of t is the valuation of s...
-            std::pair<std::string,std::string> t_val{valuation};
-            //... plus the label of the transition
-            if(!is_epsilon<labelset_t>(std::get<0>(l))) {
-              auto c = std::get<0>(l);
-              t_val.first = t_val.first+c;
+      }
+
+      /// Whether the transducer is functional; if not, \a witness is
+      /// set.
+      bool operator()(functionality_witness& witness)
+      {
+        std::vector<unsigned> todo;
+        for (auto i : tdc_->initial_transitions())
+          for (auto j : tdc_->initial_transitions()) {
+            state_t p = tdc_->dst_of(i), q = tdc_->dst_of(j);
+            if (!useful_[p] || !useful_[q])
+              continue;
+            unsigned s = state_(p, q, false);
+            if (!has_delay_[s]) {
+              set_delay_(s, delay_t{}, none, {});
+              todo.emplace_back(s);
             }
-            if(!is_epsilon<labelset_t>(std::get<1>(l))) {
-              auto c = std::get<1>(l);
-              t_val.second = t_val.second+c;
+          }
+        while (!todo.empty()) {
+          unsigned s = todo.back();
+          todo.pop_back();
+          if (is_final_(s) && delays_[s] != delay_t{}) {
+            witness = make_witness_(path_(s));
+            return false;
+          }
+          for (const auto& m : moves_(s)) {
+            delay_t d = advance_(delays_[s], m);
+            unsigned t = m.dst;
+            bool invalid = !d.first.empty() && !d.second.empty();
+            if (!invalid && !has_delay_[t]) {
+              set_delay_(t, d, s, m);
+              todo.emplace_back(t);
+              continue;
             }
-            //compute the length p of the greater common prefix
-            unsigned p;
-            for(p=0; p< t_val.first.length() && p<t_val.second.length() && t_val.first[p]==t_val.second[p]; ++p)
-              ;
-            //... minus the greatest common prefix
-            t_val.first = t_val.first.substr(p);
-            t_val.second = t_val.second.substr(p);
-            //at least one component of the valuation should be empty
-            if(t_val.first.length() >0 && t_val.second.length()>0)
-              return false;
-            //if t has already been met, it should have the same valuation
-            auto it2 = valuations.find(t);
-            if(it2 != valuations.end()) {
-              if(it2->second != t_val)
-                return false;
+            if (!invalid && delays_[t] == d)
+              continue;
+            path_t cont;
+            if (!coaccessible_(t, cont))
+              continue;
+            path_t p = path_(s);
+            p.emplace_back(m);
+            p.insert(p.end(), cont.begin(), cont.end());
+            witness = make_witness_(p);
+            if (witness.output1 == witness.output2) {
+              // Then the first path to t, with the same
+              // continuation, yields two distinct outputs.
+              p = path_(t);
+              p.insert(p.end(), cont.begin(), cont.end());
+              witness = make_witness_(p);
             }
-            else {
-              valuations.emplace(std::make_pair(t,t_val));
-              todo.emplace(t);
+            return false;
+          }
+        }
+        return true;
+      }
+
+    private:
+      typename in_labelset_t::value_t input_(transition_t t) const
+      {
+        return std::get<0>(tdc_->label_of(t));
+      }
+
+      unsigned state_(state_t p, state_t q, bool flag)
+      {
+        triple_t k{{p, q}, flag};
+        auto i = map_.find(k);
+        if (i != map_.end())
+          return i->second;
+        unsigned res = states_.size();
+        map_.emplace(k, res);
+        states_.emplace_back(k);
+        has_delay_.push_back(false);
+        delays_.emplace_back();
+        parents_.emplace_back(none, move_t{});
+        status_.push_back(unknown);
+        return res;
+      }
+
+      void set_delay_(unsigned s, const delay_t& d, unsigned parent,
+                      const move_t& m)
+      {
+        has_delay_[s] = true;
+        delays_[s] = d;
+        parents_[s] = {parent, m};
+      }
+
+      bool is_final_(unsigned s) const
+      {
+        return (tdc_->is_final(states_[s].first.first)
+                && tdc_->is_final(states_[s].first.second));
+      }
+
+      /// The transitions of the square outgoing from \a s.
+      std::vector<move_t> moves_(unsigned s)
+      {
+        state_t p = states_[s].first.first;
+        state_t q = states_[s].first.second;
+        bool flag = states_[s].second;
+        std::vector<move_t> res;
+        transition_t null = tdc_->null_transition();
+        if (!flag)
+          for (auto t : eps_out_[p])
+            res.push_back({state_(tdc_->dst_of(t), q, false), t, null});
+        for (auto t : eps_out_[q])
+          res.push_back({state_(p, tdc_->dst_of(t), true), null, t});
+        const auto& lo = letter_out_[p];
+        const auto& ro = letter_out_[q];
+        auto j = ro.begin();
+        for (auto t : lo) {
+          while (j != ro.end() && in_labelset_t::less_than(input_(*j), input_(t)))
+            ++j;
+          for (auto k = j;
+               k != ro.end() && in_labelset_t::equals(input_(*k), input_(t));
+               ++k)
+            res.push_back({state_(tdc_->dst_of(t), tdc_->dst_of(*k), false),
+                  t, *k});
+        }
+        return res;
+      }
+
+      void append_output_(std::string& w, transition_t t) const
+      {
+        if (t != tdc_->null_transition()) {
+          auto l = std::get<1>(tdc_->label_of(t));
+          if (!is_epsilon<out_labelset_t>(l))
+            w += l;
+        }
+      }
+
+      delay_t advance_(delay_t d, const move_t& m) const
+      {
+        append_output_(d.first, m.t1);
+        append_output_(d.second, m.t2);
+        unsigned p;
+        for (p = 0; p < d.first.length() && p < d.second.length()
+               && d.first[p] == d.second[p]; ++p)
+          ;
+        d.first = d.first.substr(p);
+        d.second = d.second.substr(p);
+        return d;
+      }
+
+      /// The path from an initial pair of states to \a s that gave
+      /// its delay.
+      path_t path_(unsigned s) const
+      {
+        path_t res;
+        for (; parents_[s].first != none; s = parents_[s].first)
+          res.emplace_back(parents_[s].second);
+        std::reverse(res.begin(), res.end());
+        return res;
+      }
+
+      /// Whether a final pair of states is reachable from \a s; if so,
+      /// \a cont is set to a path to it.  States from which no final
+      /// pair is reachable are remembered.
+      bool coaccessible_(unsigned s, path_t& cont)
+      {
+        if (status_[s] == dead)
+          return false;
+        std::unordered_map<unsigned, std::pair<unsigned, move_t>> parent;
+        std::vector<unsigned> visited{s}, todo{s};
+        parent.emplace(s, std::make_pair(none, move_t{}));
+        while (!todo.empty()) {
+          unsigned t = todo.back();
+          todo.pop_back();
+          if (is_final_(t)) {
+            for (; parent[t].first != none; t = parent[t].first)
+              cont.emplace_back(parent[t].second);
+            std::reverse(cont.begin(), cont.end());
+            return true;
+          }
+          for (const auto& m : moves_(t))
+            if (status_[m.dst] != dead
+                && parent.emplace(m.dst, std::make_pair(t, m)).second) {
+              visited.emplace_back(m.dst);
+              todo.emplace_back(m.dst);
             }
         }
+        for (auto t : visited)
+          status_[t] = dead;
+        return false;
+      }
+
+      functionality_witness make_witness_(const path_t& path) const
+      {
+        functionality_witness res;
+        for (const auto& m : path) {
+          transition_t t = m.t1 != tdc_->null_transition() ? m.t1 : m.t2;
+          auto l = input_(t);
+          if (!is_epsilon<in_labelset_t>(l))
+            res.input += l;
+          append_output_(res.output1, m.t1);
+          append_output_(res.output2, m.t2);
         }
+        return res;
       }
-    }
-    return true;
+
+      enum status_t : char { unknown, dead };
+
+      const Tdc& tdc_;
+      /// Useful states of the transducer.
+      std::vector<bool> useful_;
+      /// Outgoing transitions to useful states, with epsilon input, and
+      /// with a letter input (sorted by input).
+      std::vector<std::vector<transition_t>> eps_out_;
+      std::vector<std::vector<transition_t>> letter_out_;
+      /// States of the square.
+      std::vector<triple_t> states_;
+      std::unordered_map<triple_t, unsigned> map_;
+      std::vector<bool> has_delay_;
+      std::vector<delay_t> delays_;
+      std::vector<std::pair<unsigned, move_t>> parents_;
+      std::vector<status_t> status_;
+    };
+
+    template <typename Tdc>
+    constexpr unsigned functionality_checker<Tdc>::none;
+  }
+
+  /** Whether a transducer is functional
+   *
+   * The square of the transducer is explored on the fly, and the
+   * exploration stops at the first pair of computations with the same
+   * input and distinct outputs.
+   *
+   * @param transducer a transducer with two tapes of characters
+   * @param witness if the transducer is not functional, set to an
+   * input with two distinct outputs
+   */
+  template <typename Tdc>
+  bool is_functional(const Tdc& transducer, functionality_witness& witness)
+  {
+    internal::functionality_checker<Tdc> check(transducer);
+    return check(witness);
+  }
+
+  template <typename Tdc>
+  bool is_functional(const Tdc& transducer)
+  {
+    functionality_witness witness;
+    return is_functional(transducer, witness);
   }
 
 }}//end of ns awali::stc
@@ -23,6 +23,17 @@
 namespace awali {
   namespace sttc {
     namespace internal {
+      /// A copy of \a aut with the same storage, unlike copy(), which
+      /// always builds a vector-backed automaton.
+      template<typename Aut>
+      Aut copy_same_storage(const Aut& aut, bool keep_history, bool same_index) {
+        auto res = make_shared_ptr<Aut>(aut->context());
+        sttc::copy_into(aut, res, keep_history, false, same_index);
+        res->set_name(aut->get_name());
+        res->set_desc(aut->get_desc());
+        return res;
+      }
+
       template<typename Aut, typename L> struct dispatch_lal_lan{
         using l_automaton_t = Aut;
         using n_automaton_t = Aut;
@@ -43,7 +54,7 @@ namespace awali {
         using n_automaton_t = mutable_automaton<n_context_t>;
         
         static const Aut proper_(const Aut& aut, direction_t, bool /*prune*/, bool keep_history) {
-          return copy(aut, keep_history,false,true);
+          return copy_same_storage(aut, keep_history, true);
         }
         
         static n_automaton_t allow_eps_(const Aut&  aut, bool keep_history) {
@@ -77,7 +88,7 @@ namespace awali {
         }
         
         static const Aut allow_eps_(const Aut& aut, bool keep_history) {
-          return copy(aut, keep_history);
+          return copy_same_storage(aut, keep_history, false);
         }
       };
     }
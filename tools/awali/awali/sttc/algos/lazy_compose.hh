@@ -0,0 +1,508 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AWALI_ALGOS_LAZY_COMPOSE_HH
+# define AWALI_ALGOS_LAZY_COMPOSE_HH
+
+# include <algorithm>
+# include <deque>
+# include <memory>
+# include <stdexcept>
+# include <unordered_map>
+# include <utility>
+# include <vector>
+
+#include <awali/sttc/algos/compose.hh>
+#include <awali/sttc/algos/accessible.hh>
+#include <awali/sttc/misc/pair.hh>
+
+namespace awali { namespace sttc {
+
+  /** @brief Transducer whose states are computed on demand.
+   *
+   * The states are integers; the outgoing transitions of a state are
+   * computed the first time they are requested, and kept afterwards.
+   * Unlike in a mutable_automaton, the initial and final weights are
+   * not represented as transitions from pre() or to post().
+   *
+   * @tparam Context the context of the transducer
+   */
+  template <typename Context>
+  class lazy_transducer
+  {
+  public:
+    using context_t = Context;
+    using labelset_t = labelset_t_of<context_t>;
+    using weightset_t = weightset_t_of<context_t>;
+    using label_t = typename labelset_t::value_t;
+    using weight_t = typename weightset_t::value_t;
+
+    /// A transition, seen from its source.
+    struct edge_t
+    {
+      state_t dst;
+      label_t label;
+      weight_t weight;
+    };
+    using edges_t = std::vector<edge_t>;
+    using initials_t = std::vector<std::pair<state_t, weight_t>>;
+
+    virtual ~lazy_transducer() {}
+
+    virtual const context_t& context() const = 0;
+
+    /// The initial states, with their initial weights.
+    virtual const initials_t& initials() = 0;
+
+    /// The final weight of \a s (zero if \a s is not final).
+    virtual weight_t final_weight(state_t s) = 0;
+
+    /// The transitions outgoing from \a s, with pairwise distinct
+    /// destinations and labels.  The result remains valid as long as
+    /// the transducer.
+    virtual const edges_t& out(state_t s) = 0;
+
+    /// The number of states whose transitions have been computed.
+    virtual size_t num_expanded() const = 0;
+  };
+
+  template <typename Context>
+  using lazy_transducer_ptr = std::shared_ptr<lazy_transducer<Context>>;
+
+  namespace internal
+  {
+    /// A mutable automaton seen as a lazy_transducer; its states keep
+    /// their indices.
+    template <typename Aut>
+    class lazy_automaton
+      : public lazy_transducer<context_t_of<Aut>>
+    {
+      using super_t = lazy_transducer<context_t_of<Aut>>;
+    public:
+      using typename super_t::context_t;
+      using typename super_t::weight_t;
+      using typename super_t::edges_t;
+      using typename super_t::initials_t;
+
+      lazy_automaton(const Aut& aut)
+        : aut_(aut)
+      {
+        for (auto t : aut_->initial_transitions())
+          initials_.emplace_back(aut_->dst_of(t), aut_->weight_of(t));
+      }
+
+      const context_t& context() const override
+      {
+        return aut_->context();
+      }
+
+      const initials_t& initials() override
+      {
+        return initials_;
+      }
+
+      weight_t final_weight(state_t s) override
+      {
+        return aut_->get_final_weight(s);
+      }
+
+      const edges_t& out(state_t s) override
+      {
+        auto i = outs_.find(s);
+        if (i != outs_.end())
+          return i->second;
+        edges_t& res = outs_[s];
+        for (auto t : aut_->out(s))
+          res.push_back({aut_->dst_of(t), aut_->label_of(t),
+                aut_->weight_of(t)});
+        return res;
+      }
+
+      size_t num_expanded() const override
+      {
+        return outs_.size();
+      }
+
+    private:
+      Aut aut_;
+      initials_t initials_;
+      std::unordered_map<state_t, edges_t> outs_;
+    };
+
+
+    /*--------------------------------------.
+    | lazy_composer<transducer, transducer>. |
+    `--------------------------------------*/
+
+    /// Lazy composition of two lazy transducers, on tape \a I of the
+    /// left one and tape \a J of the right one.
+    ///
+    /// A state is a pair of states of the operands and a flag.  In
+    /// order to represent every pair of matching computations only
+    /// once, the moves of \a lhs with epsilon on tape \a I have to
+    /// come before the moves of \a rhs with epsilon on tape \a J: the
+    /// flag records that a move of the latter kind happened since the
+    /// last synchronized move.  This replaces the outsplit performed
+    /// by composeIJ, which cannot be applied to a lazy operand.
+    template <typename LCtx, typename RCtx, size_t I, size_t J>
+    class lazy_composer
+      : public lazy_transducer<
+          context<typename concat_tupleset<
+                    typename rem_in_tupleset<labelset_t_of<LCtx>, I>::type,
+                    typename rem_in_tupleset<labelset_t_of<RCtx>, J>::type>::type,
+                  join_t<weightset_t_of<LCtx>, weightset_t_of<RCtx>>>>
+    {
+      using l_labelset_t = labelset_t_of<LCtx>;
+      using r_labelset_t = labelset_t_of<RCtx>;
+      using I_labelset_t = typename l_labelset_t::template valueset_t<I>;
+      using J_labelset_t = typename r_labelset_t::template valueset_t<J>;
+      using minusI_labelset_t = typename rem_in_tupleset<l_labelset_t, I>::type;
+      using minusJ_labelset_t = typename rem_in_tupleset<r_labelset_t, J>::type;
+      using lhs_t = lazy_transducer_ptr<LCtx>;
+      using rhs_t = lazy_transducer_ptr<RCtx>;
+
+    public:
+      using labelset_t = typename concat_tupleset<minusI_labelset_t,
+                                                  minusJ_labelset_t>::type;
+      using weightset_t = join_t<weightset_t_of<LCtx>, weightset_t_of<RCtx>>;
+      using context_t = sttc::context<labelset_t, weightset_t>;
+      using super_t = lazy_transducer<context_t>;
+      using typename super_t::weight_t;
+      using typename super_t::edge_t;
+      using typename super_t::edges_t;
+      using typename super_t::initials_t;
+
+      /// States of the lhs and of the rhs, and the flag.
+      using triple_t = std::pair<std::pair<state_t, state_t>, bool>;
+
+      lazy_composer(const lhs_t& lhs, const rhs_t& rhs)
+        : lhs_(lhs)
+        , rhs_(rhs)
+        , ctx_(labelset_t{concat_and_remove<I, J>
+                          (lhs->context().labelset()->sets(),
+                           rhs->context().labelset()->sets())},
+               join(*lhs->context().weightset(),
+                    *rhs->context().weightset()))
+        , ws_(*ctx_.weightset())
+      {}
+
+      const context_t& context() const override
+      {
+        return ctx_;
+      }
+
+      const initials_t& initials() override
+      {
+        if (initials_.empty())
+          for (const auto& i : lhs_->initials())
+            for (const auto& j : rhs_->initials())
+              initials_.emplace_back(state_(i.first, j.first, false),
+                                     ws_.mul(i.second, j.second));
+        return initials_;
+      }
+
+      weight_t final_weight(state_t s) override
+      {
+        const auto& t = states_[s];
+        weight_t w = lhs_->final_weight(t.first.first);
+        if (ws_.is_zero(w))
+          return w;
+        return ws_.mul(w, rhs_->final_weight(t.first.second));
+      }
+
+      const edges_t& out(state_t s) override
+      {
+        if (!expanded_[s])
+          expand_(s);
+        return outs_[s];
+      }
+
+      size_t num_expanded() const override
+      {
+        return num_expanded_;
+      }
+
+      /// The number of states discovered so far.
+      size_t num_states() const
+      {
+        return states_.size();
+      }
+
+      /// The states of the operands that \a s stands for.
+      std::pair<state_t, state_t> origins(state_t s) const
+      {
+        return states_[s].first;
+      }
+
+    private:
+      state_t state_(state_t p, state_t q, bool flag)
+      {
+        triple_t t{{p, q}, flag};
+        auto i = map_.find(t);
+        if (i != map_.end())
+          return i->second;
+        state_t res = states_.size();
+        map_.emplace(t, res);
+        states_.emplace_back(t);
+        outs_.emplace_back();
+        expanded_.push_back(false);
+        return res;
+      }
+
+      void expand_(state_t s)
+      {
+        state_t p = states_[s].first.first;
+        state_t q = states_[s].first.second;
+        bool flag = states_[s].second;
+        const auto& lo = lhs_->out(p);
+        const auto& ro = rhs_->out(q);
+        edges_t res;
+        // Moves of the lhs alone.
+        if (!flag)
+          for (const auto& e : lo)
+            if (is_epsilon<I_labelset_t>(std::get<I>(e.label)))
+              res.push_back({state_(e.dst, q, false),
+                    std::tuple_cat(rem_in_tuple<I>::get(e.label),
+                                   get_epsilon<minusJ_labelset_t>()),
+                    e.weight});
+        // Moves of the rhs alone, and rhs transitions to synchronize,
+        // sorted by their label on tape J.
+        std::vector<const typename lazy_transducer<RCtx>::edge_t*> sync;
+        for (const auto& e : ro)
+          if (is_epsilon<J_labelset_t>(std::get<J>(e.label)))
+            res.push_back({state_(p, e.dst, true),
+                  std::tuple_cat(get_epsilon<minusI_labelset_t>(),
+                                 rem_in_tuple<J>::get(e.label)),
+                  e.weight});
+          else
+            sync.push_back(&e);
+        auto less = [](const typename lazy_transducer<RCtx>::edge_t* e,
+                       const typename lazy_transducer<RCtx>::edge_t* f) {
+          return J_labelset_t::less_than(std::get<J>(e->label),
+                                         std::get<J>(f->label));
+        };
+        std::sort(sync.begin(), sync.end(), less);
+        // Synchronized moves.
+        for (const auto& e : lo)
+          {
+            const auto& l = std::get<I>(e.label);
+            if (is_epsilon<I_labelset_t>(l))
+              continue;
+            auto f = std::lower_bound(sync.begin(), sync.end(), l,
+                                      [](const typename lazy_transducer<RCtx>::edge_t* g,
+                                         const typename I_labelset_t::value_t& a) {
+                                        return J_labelset_t::less_than(std::get<J>(g->label), a);
+                                      });
+            for (; f != sync.end() && J_labelset_t::equals(std::get<J>((*f)->label), l); ++f)
+              res.push_back({state_(e.dst, (*f)->dst, false),
+                    std::tuple_cat(rem_in_tuple<I>::get(e.label),
+                                   rem_in_tuple<J>::get((*f)->label)),
+                    ws_.mul(e.weight, (*f)->weight)});
+          }
+        merge_(res);
+        outs_[s] = std::move(res);
+        expanded_[s] = true;
+        ++num_expanded_;
+      }
+
+      /// Sum the weights of the edges with same destination and label.
+      void merge_(edges_t& es) const
+      {
+        auto less = [](const edge_t& e, const edge_t& f) {
+          return e.dst < f.dst
+          || (e.dst == f.dst && labelset_t::less_than(e.label, f.label));
+        };
+        std::sort(es.begin(), es.end(), less);
+        size_t n = 0;
+        for (size_t i = 0; i < es.size(); ++i)
+          if (n > 0 && !less(es[n - 1], es[i]))
+            es[n - 1].weight = ws_.add(es[n - 1].weight, es[i].weight);
+          else
+            es[n++] = std::move(es[i]);
+        es.resize(n);
+        es.erase(std::remove_if(es.begin(), es.end(),
+                                [this](const edge_t& e) {
+                                  return ws_.is_zero(e.weight);
+                                }),
+                 es.end());
+      }
+
+      lhs_t lhs_;
+      rhs_t rhs_;
+      context_t ctx_;
+      weightset_t ws_;
+      initials_t initials_;
+      /// State -> triple, and conversely.
+      std::vector<triple_t> states_;
+      std::unordered_map<triple_t, state_t> map_;
+      /// The transitions of the states; a deque, so that references
+      /// remain valid when states are added.
+      std::deque<edges_t> outs_;
+      std::vector<bool> expanded_;
+      size_t num_expanded_ = 0;
+    };
+  }
+
+  /// A mutable automaton (or transducer) seen as a lazy transducer.
+  template <typename Aut>
+  lazy_transducer_ptr<context_t_of<Aut>>
+  make_lazy_transducer(const Aut& aut)
+  {
+    return std::make_shared<internal::lazy_automaton<Aut>>(aut);
+  }
+
+  /*--------------------------------------.
+  | lazy_compose(transducer, transducer).  |
+  `--------------------------------------*/
+
+  /** Lazy composition of two transducers on given tapes
+   *
+   * Nothing is computed by this function: the states of the
+   * composition, and the states of the operands if they are lazy
+   * themselves, are expanded when they are traversed.  The operands
+   * need neither be sorted nor outsplit.
+   *
+   * The tapes of the result are the same as with {@link composeIJ}.
+   * Transitions with epsilon on every tape may occur; {@link
+   * materialize} removes them.
+   *
+   * @tparam I the index of the composing tape of the first transducer
+   * @tparam J the index of the composing tape of the second transducer
+   */
+  template <size_t I, size_t J, typename LCtx, typename RCtx>
+  lazy_transducer_ptr<typename internal::lazy_composer<LCtx, RCtx, I, J>::context_t>
+  lazy_composeIJ(const lazy_transducer_ptr<LCtx>& tdc1,
+                 const lazy_transducer_ptr<RCtx>& tdc2)
+  {
+    return std::make_shared<internal::lazy_composer<LCtx, RCtx, I, J>>
+      (tdc1, tdc2);
+  }
+
+  /// Lazy composition of the second tape of \a tdc1 with the first
+  /// tape of \a tdc2.
+  template <typename LCtx, typename RCtx>
+  lazy_transducer_ptr<typename internal::lazy_composer<LCtx, RCtx, 1, 0>::context_t>
+  lazy_compose(const lazy_transducer_ptr<LCtx>& tdc1,
+               const lazy_transducer_ptr<RCtx>& tdc2)
+  {
+    return lazy_composeIJ<1, 0>(tdc1, tdc2);
+  }
+
+  /// Lazy composition of two mutable transducers.
+  template <typename TDC1, typename TDC2>
+  lazy_transducer_ptr<typename internal::lazy_composer
+                      <context_t_of<TDC1>, context_t_of<TDC2>, 1, 0>::context_t>
+  lazy_compose(const TDC1& tdc1, const TDC2& tdc2)
+  {
+    return lazy_compose(make_lazy_transducer(tdc1),
+                        make_lazy_transducer(tdc2));
+  }
+
+  /** Lazy composition of a cascade of transducers
+   *
+   * The transducers are composed from left to right, the second tape
+   * of each one with the first tape of the next one; no intermediate
+   * transducer is built.
+   *
+   * @param tdcs a non empty list of transducers whose tapes have the
+   * same type
+   */
+  template <typename Tdc>
+  lazy_transducer_ptr<context_t_of<Tdc>>
+  compose_all(const std::vector<Tdc>& tdcs)
+  {
+    using context_t = context_t_of<Tdc>;
+    static_assert(std::is_same<typename internal::lazy_composer
+                               <context_t, context_t, 1, 0>::context_t,
+                               context_t>::value,
+                  "compose_all: requires tapes of the same type");
+    require(!tdcs.empty(), "compose_all: empty list of transducers");
+    lazy_transducer_ptr<context_t> res = make_lazy_transducer(tdcs[0]);
+    for (size_t i = 1; i < tdcs.size(); ++i)
+      res = lazy_compose(res, make_lazy_transducer(tdcs[i]));
+    return res;
+  }
+
+  /** The accessible part of a lazy transducer, as a mutable transducer
+   *
+   * Only the accessible states are expanded.  The transitions with
+   * epsilon on every tape are removed.
+   *
+   * @param tdc the lazy transducer
+   * @param trim if true, the result is trimmed
+   */
+  template <typename Context>
+  mutable_automaton<Context>
+  materialize(const std::shared_ptr<lazy_transducer<Context>>& tdc,
+              bool trim = true)
+  {
+    auto res = make_mutable_automaton(tdc->context());
+    std::vector<state_t> map;
+    std::vector<state_t> todo;
+    auto state = [&](state_t s) {
+      if (map.size() <= s)
+        map.resize(s + 1, res->null_state());
+      if (map[s] == res->null_state()) {
+        map[s] = res->add_state();
+        todo.emplace_back(s);
+      }
+      return map[s];
+    };
+    const auto& ws = *res->weightset();
+    for (const auto& i : tdc->initials())
+      res->set_initial(state(i.first), i.second);
+    while (!todo.empty()) {
+      state_t s = todo.back();
+      todo.pop_back();
+      state_t src = map[s];
+      auto w = tdc->final_weight(s);
+      if (!ws.is_zero(w))
+        res->set_final(src, w);
+      for (const auto& e : tdc->out(s))
+        res->new_transition(src, state(e.dst), e.label, e.weight);
+    }
+    proper_here(res);
+    if (trim)
+      trim_here(res);
+    return res;
+  }
+
+  /** Evaluation of an automaton by a lazy transducer
+   *
+   * Same as {@link eval_tdc}, but only the states of \a tdc that are
+   * reached while reading \a aut are expanded.
+   *
+   * @param aut the automaton
+   * @param tdc a lazy transducer with two tapes
+   * @return a trim automaton over the second tape of \a tdc
+   */
+  template <typename Aut, typename Context>
+  auto
+  lazy_eval_tdc(const Aut& aut,
+                const std::shared_ptr<lazy_transducer<Context>>& tdc)
+    -> decltype(projection<0>(std::declval<mutable_automaton<
+                typename internal::lazy_composer<
+                  typename internal::partial_identiter<Aut, 1>::out_context_t,
+                  Context, 0, 0>::context_t>>()))
+  {
+    auto l = make_lazy_transducer(partial_identity<1>(aut, false));
+    auto r = materialize(lazy_composeIJ<0, 0>(l, tdc));
+    return projection<0>(r, false);
+  }
+
+}}//end of ns awali::stc
+
+#endif // !AWALI_ALGOS_LAZY_COMPOSE_HH
@@ -0,0 +1,503 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AWALI_ALGOS_MINIMIZE_INCREMENTAL_HH
+# define AWALI_ALGOS_MINIMIZE_INCREMENTAL_HH
+
+# include <algorithm>
+# include <cstddef>
+# include <memory>
+# include <set>
+# include <unordered_map>
+# include <utility>
+# include <vector>
+
+#include <awali/common/enums.hh>
+#include <awali/sttc/core/mutable_automaton.hh>
+#include <awali/sttc/ctx/traits.hh>
+#include <awali/sttc/algos/min_quotient.hh>
+#include <awali/sttc/history/partition_history.hh>
+#include <awali/sttc/weightset/b.hh>
+#include <awali/utils/hash.hh>
+
+namespace awali { namespace sttc {
+
+
+  /*----------------------------------------------.
+  | determinization and minimization at once.     |
+  `----------------------------------------------*/
+
+  namespace internal {
+
+    /// Subset construction which merges equivalent states on the fly.
+    ///
+    /// The subsets are explored in depth first, and the strongly
+    /// connected components of the deterministic automaton are
+    /// detected with Tarjan's algorithm.  When a component is
+    /// complete, all the successors of its states out of the
+    /// component are already in the result, and pairwise
+    /// inequivalent.  The component is then reduced by Moore's
+    /// algorithm, and its states are looked up by their signature
+    /// (finality and successors, a loop being written "self") among
+    /// the states of the result; only new classes are added to the
+    /// result.
+    ///
+    /// Once a component is merged, the data of Tarjan's algorithm for
+    /// its subsets is dropped, and every subset is only kept with its
+    /// state in the result; hence every subset is explored once.
+    ///
+    /// Merges are always sound.  The lookup is exact for components
+    /// which are reduced to a single class; a component with several
+    /// classes may be equivalent to states out of it (for instance, a
+    /// non final cycle which leads to the sink), hence, if there is
+    /// any, a Moore minimization is run on the (already reduced)
+    /// result as a last step.
+    ///
+    /// The empty subset is the sink state, hence the result is
+    /// complete.  If \a complement is set, the final states are
+    /// swapped.  If \a keep_history is set, every state of the result
+    /// is linked to the set of the states of the input which belong to
+    /// the subsets of its class.
+    template <typename Aut>
+    class incremental_minimizer
+    {
+      static_assert(labelset_t_of<Aut>::is_free(),
+                    "minimize: requires free labelset");
+      static_assert(std::is_same<weightset_t_of<Aut>, b>::value,
+                    "minimize: requires Boolean weights");
+
+    public:
+      using automaton_t = Aut;
+      using automaton_nocv_t = mutable_automaton<context_t_of<Aut>>;
+      using context_t = context_t_of<automaton_t>;
+      using label_t = label_t_of<automaton_t>;
+      using subset_t = std::vector<state_t>;
+
+      incremental_minimizer(const automaton_t& a, bool complement = false,
+                            bool keep_history = false)
+        : input_(a)
+        , output_(make_mutable_automaton<context_t>(a->context()))
+        , complement_(complement)
+        , keep_history_(keep_history)
+      {
+        std::unordered_map<label_t, unsigned> index;
+        for (auto l : a->labelset()->genset()) {
+          index.emplace(l, letters_.size());
+          letters_.emplace_back(l);
+        }
+        unsigned n = a->max_state() + 1, nl = letters_.size();
+        final_.assign(n, false);
+        for (auto t : a->final_transitions())
+          final_[a->src_of(t)] = true;
+        mark_.assign(n, 0);
+        // Successors of s by the i-th letter:
+        // succ_[succ_begin_[s*nl+i]] to succ_[succ_begin_[s*nl+i+1]-1].
+        succ_begin_.assign(n * nl + 1, 0);
+        for (auto t : a->transitions())
+          ++succ_begin_[a->src_of(t) * nl + index[a->label_of(t)] + 1];
+        for (unsigned i = 0; i < n * nl; ++i)
+          succ_begin_[i + 1] += succ_begin_[i];
+        succ_.resize(succ_begin_[n * nl]);
+        std::vector<unsigned> pos(succ_begin_.begin(), succ_begin_.end() - 1);
+        for (auto t : a->transitions())
+          succ_[pos[a->src_of(t) * nl + index[a->label_of(t)]]++]
+            = a->dst_of(t);
+      }
+
+      automaton_nocv_t operator()()
+      {
+        subset_t init;
+        for (auto t : input_->initial_transitions())
+          init.emplace_back(input_->dst_of(t));
+        std::sort(init.begin(), init.end());
+        init.erase(std::unique(init.begin(), init.end()), init.end());
+
+        // Iterative Tarjan algorithm; a frame is a slot and the index
+        // of the next letter to follow.  The successors are computed
+        // when they are followed.
+        unsigned nl = letters_.size();
+        unsigned count = 0;
+        std::vector<std::pair<unsigned, unsigned>> call_stack;
+        std::vector<unsigned> stack;
+        auto visit = [&](const subset_t& ss) {
+          unsigned k = open_slot_(ss);
+          slots_[k].index = slots_[k].low = count++;
+          stack.emplace_back(k);
+          call_stack.emplace_back(k, 0);
+        };
+        visit(init);
+        state_t init_out = output_->null_state();
+        subset_t next;
+        while (!call_stack.empty()) {
+          unsigned k = call_stack.back().first;
+          unsigned i = call_stack.back().second;
+          if (i < nl) {
+            ++call_stack.back().second;
+            successor_(k, i, next);
+            auto o = open_.find(next);
+            if (o != open_.end()) {
+              // On the stack, hence in the component of k.
+              slots_[k].succ[i] = {true, o->second};
+              slots_[k].low = std::min(slots_[k].low,
+                                       slots_[o->second].index);
+              continue;
+            }
+            auto c = closed_.find(next);
+            if (c != closed_.end())
+              slots_[k].succ[i] = {false, c->second};
+            else
+              visit(next);
+            continue;
+          }
+          call_stack.pop_back();
+          std::vector<unsigned> comp;
+          if (slots_[k].low == slots_[k].index) {
+            auto it = std::find(stack.rbegin(), stack.rend(), k);
+            comp.assign(stack.rbegin(), it + 1);
+            stack.resize(stack.size() - comp.size());
+            finalize_(comp);
+          }
+          if (call_stack.empty())
+            init_out = slots_[k].out;
+          else {
+            unsigned p = call_stack.back().first;
+            unsigned j = call_stack.back().second - 1;
+            if (comp.empty()) {
+              slots_[p].succ[j] = {true, k};
+              slots_[p].low = std::min(slots_[p].low, slots_[k].low);
+            }
+            else
+              slots_[p].succ[j] = {false, slots_[k].out};
+          }
+          if (!comp.empty())
+            release_(comp);
+        }
+        output_->set_initial(init_out);
+        auto res = output_;
+        if (num_multi_ != 0)
+          res = minimize(output_, MOORE, keep_history_);
+        if (keep_history_)
+          set_history_(res);
+        return res;
+      }
+
+      /// The number of subsets explored by the last run.
+      std::size_t num_explored() const
+      {
+        return num_explored_;
+      }
+
+    private:
+      static constexpr unsigned unvisited = -1U;
+
+      /// A successor: either an open subset (its slot), or a state of
+      /// the result.
+      struct target_t
+      {
+        bool inside;
+        unsigned id;
+      };
+
+      /// Data of an open subset.
+      struct slot_t
+      {
+        /// The key in open_ (the keys of an unordered_map do not move).
+        const subset_t* subset;
+        /// Data of Tarjan's algorithm.
+        unsigned index;
+        unsigned low;
+        bool is_final;
+        /// Successors by every letter, as far as they were followed.
+        std::vector<target_t> succ;
+        /// State of the result, once the component is closed.
+        state_t out;
+      };
+
+      /// A new slot for the subset \a ss.
+      unsigned open_slot_(const subset_t& ss)
+      {
+        unsigned k;
+        if (free_slots_.empty()) {
+          k = slots_.size();
+          slots_.emplace_back();
+        }
+        else {
+          k = free_slots_.back();
+          free_slots_.pop_back();
+        }
+        slot_t& slot = slots_[k];
+        slot.subset = &open_.emplace(ss, k).first->first;
+        slot.index = slot.low = unvisited;
+        slot.is_final = final_of_(ss);
+        slot.succ.assign(letters_.size(), target_t{false, 0});
+        slot.out = output_->null_state();
+        ++num_explored_;
+        return k;
+      }
+
+      /// Drop the slots of the closed component \a comp; its subsets
+      /// are kept with their state of the result.
+      void release_(const std::vector<unsigned>& comp)
+      {
+        for (unsigned k : comp) {
+          slot_t& slot = slots_[k];
+          closed_.emplace(*slot.subset, slot.out);
+          open_.erase(*slot.subset);
+          slot.subset = nullptr;
+          std::vector<target_t>().swap(slot.succ);
+          free_slots_.emplace_back(k);
+        }
+      }
+
+      /// Link every state of \a res to the states of the input in the
+      /// subsets of its class; if the last Moore minimization was run,
+      /// \a res is a quotient of output_.
+      void set_history_(automaton_nocv_t& res)
+      {
+        using state_set_t = std::set<state_t>;
+        std::unordered_map<state_t, state_set_t> origins;
+        for (const auto& p : closed_)
+          origins[p.second].insert(p.first.begin(), p.first.end());
+        auto history
+          = std::make_shared<partition_history<automaton_t>>(input_);
+        if (res == output_)
+          for (auto& p : origins)
+            history->add_state(p.first, std::move(p.second));
+        else {
+          // The history set by the minimization of output_.
+          auto moore = std::static_pointer_cast
+            <partition_history<automaton_nocv_t>>(res->history());
+          for (const auto& p : moore->origins()) {
+            state_set_t from;
+            for (auto s : p.second) {
+              const state_set_t& o = origins[s];
+              from.insert(o.begin(), o.end());
+            }
+            history->add_state(p.first, from);
+          }
+        }
+        res->set_history(history);
+      }
+
+      bool final_of_(const subset_t& ss) const
+      {
+        for (auto s : ss)
+          if (final_[s])
+            return !complement_;
+        return complement_;
+      }
+
+      /// The successor of the subset of slot \a k by the \a i-th letter.
+      void successor_(unsigned k, unsigned i, subset_t& next)
+      {
+        unsigned nl = letters_.size();
+        if (++epoch_ == 0) {
+          // The counter wrapped: the marks are cleared.
+          std::fill(mark_.begin(), mark_.end(), 0);
+          epoch_ = 1;
+        }
+        next.clear();
+        for (auto s : *slots_[k].subset)
+          for (unsigned j = succ_begin_[s * nl + i];
+               j < succ_begin_[s * nl + i + 1]; ++j)
+            if (mark_[succ_[j]] != epoch_) {
+              mark_[succ_[j]] = epoch_;
+              next.emplace_back(succ_[j]);
+            }
+        std::sort(next.begin(), next.end());
+      }
+
+      /// Reduce the component \a comp and add its classes to the result.
+      void finalize_(const std::vector<unsigned>& comp)
+      {
+        unsigned nl = letters_.size();
+        // Local indices of the states of the component.
+        std::unordered_map<unsigned, unsigned> local;
+        for (unsigned j = 0; j < comp.size(); ++j)
+          local.emplace(comp[j], j);
+        // Moore's algorithm; a successor out of the component is
+        // written (0, its state in the result), a successor inside
+        // is written (1, its class).
+        std::vector<unsigned> block(comp.size(), 0);
+        unsigned num_blocks = comp.size() == 1 ? 1 : 0;
+        for (bool first = true; num_blocks != 1; first = false) {
+          std::unordered_map<std::vector<unsigned>, unsigned, key_hash> keys;
+          std::vector<unsigned> nblock(comp.size());
+          for (unsigned j = 0; j < comp.size(); ++j) {
+            const slot_t& slot = slots_[comp[j]];
+            std::vector<unsigned> key{first ? unsigned(slot.is_final)
+                                            : block[j]};
+            for (const target_t& t : slot.succ)
+              if (!t.inside) {
+                key.emplace_back(0);
+                key.emplace_back(t.id);
+              }
+              else {
+                key.emplace_back(1);
+                key.emplace_back(first ? 0 : block[local.at(t.id)]);
+              }
+            nblock[j] = keys.emplace(std::move(key), keys.size()).first->second;
+          }
+          bool stable = !first && keys.size() == num_blocks;
+          num_blocks = keys.size();
+          block = std::move(nblock);
+          if (stable)
+            break;
+        }
+
+        // A representative of every class.
+        std::vector<unsigned> rep(num_blocks, unvisited);
+        for (unsigned j = 0; j < comp.size(); ++j)
+          if (rep[block[j]] == unvisited)
+            rep[block[j]] = j;
+        std::vector<state_t> cls(num_blocks);
+        std::vector<bool> fresh(num_blocks, true);
+
+        if (num_blocks == 1) {
+          // Every inside successor is the state itself; the equivalent
+          // state, if any, is either one of the outside successors
+          // (then written "self" as well) or none of them.
+          const slot_t& slot = slots_[comp[rep[0]]];
+          std::vector<unsigned> key{unsigned(slot.is_final)};
+          for (const target_t& t : slot.succ)
+            key.emplace_back(t.inside ? self : t.id);
+          auto found = signatures_.find(key);
+          for (unsigned i = 1; found == signatures_.end() && i <= nl; ++i) {
+            unsigned d = key[i];
+            if (d == self || std::find(key.begin() + 1, key.begin() + i, d)
+                             != key.begin() + i)
+              continue;
+            std::vector<unsigned> self_key = key;
+            std::replace(self_key.begin() + 1, self_key.end(), d, self);
+            found = signatures_.find(self_key);
+            if (found != signatures_.end() && found->second != d)
+              found = signatures_.end();
+          }
+          if (found != signatures_.end()) {
+            cls[0] = found->second;
+            fresh[0] = false;
+          }
+          else
+            cls[0] = output_->add_state();
+        }
+        else {
+          ++num_multi_;
+          for (auto& c : cls)
+            c = output_->add_state();
+        }
+
+        for (unsigned j = 0; j < comp.size(); ++j)
+          slots_[comp[j]].out = cls[block[j]];
+        for (unsigned b = 0; b < num_blocks; ++b) {
+          if (!fresh[b])
+            continue; // Already in the result.
+          state_t s = cls[b];
+          const slot_t& slot = slots_[comp[rep[b]]];
+          if (slot.is_final)
+            output_->set_final(s);
+          std::vector<unsigned> key{unsigned(slot.is_final)};
+          std::vector<unsigned> self_key{unsigned(slot.is_final)};
+          bool loop = false;
+          for (unsigned i = 0; i < nl; ++i) {
+            const target_t& t = slot.succ[i];
+            state_t d = t.inside ? slots_[t.id].out : t.id;
+            output_->new_transition(s, d, letters_[i]);
+            key.emplace_back(d);
+            self_key.emplace_back(d == s ? self : d);
+            loop |= d == s;
+          }
+          signatures_.emplace(std::move(key), s);
+          if (loop)
+            signatures_.emplace(std::move(self_key), s);
+        }
+      }
+
+      static constexpr unsigned self = -2U;
+
+      struct key_hash
+      {
+        size_t operator()(const std::vector<unsigned>& v) const
+        {
+          size_t res = 0;
+          for (auto x : v)
+            std::hash_combine(res, x);
+          return res;
+        }
+      };
+
+      using subset_hash = key_hash;
+
+      automaton_t input_;
+      automaton_nocv_t output_;
+      bool complement_;
+      bool keep_history_;
+      std::vector<label_t> letters_;
+      std::vector<bool> final_;
+      std::vector<unsigned> succ_begin_;
+      std::vector<state_t> succ_;
+      /// Input states already in the subset being built.
+      std::vector<unsigned> mark_;
+      unsigned epoch_ = 0;
+
+      /// Open subset -> slot.
+      std::unordered_map<subset_t, unsigned, subset_hash> open_;
+      /// Slot -> data of the open subset; slots are reused.
+      std::vector<slot_t> slots_;
+      std::vector<unsigned> free_slots_;
+      /// Closed subset -> state of the result.
+      std::unordered_map<subset_t, state_t, subset_hash> closed_;
+      /// Signature -> state of the result.
+      std::unordered_map<std::vector<unsigned>, state_t, key_hash> signatures_;
+      /// Number of components with several classes.
+      unsigned num_multi_ = 0;
+      std::size_t num_explored_ = 0;
+    };
+
+    template <typename Aut>
+    constexpr unsigned incremental_minimizer<Aut>::unvisited;
+
+    template <typename Aut>
+    constexpr unsigned incremental_minimizer<Aut>::self;
+  }
+
+  /** Minimal automaton, by determinization with incremental minimization
+   *
+   * The subset construction of \a a is explored in depth first, and
+   * every strongly connected component is reduced, and merged with the
+   * equivalent states already built, as soon as it is complete.  Every
+   * subset is explored once.  The result is the minimal complete
+   * deterministic automaton of \a a; it is built without building the
+   * determinization of \a a first.  If a strongly connected component
+   * of the determinization is not reduced to a single class, a Moore
+   * minimization of the (already reduced) result is run as a last step.
+   *
+   * @tparam Aut the type of the automaton
+   * @param a a Boolean automaton labelled by letters
+   * @return the minimal complete deterministic automaton equivalent to \a a
+   */
+  template <typename Aut>
+  inline
+  auto
+  minimize_incremental(const Aut& a)
+    -> mutable_automaton<context_t_of<Aut>>
+  {
+    internal::incremental_minimizer<Aut> algo(a);
+    return algo();
+  }
+
+}}//end of ns awali::stc
+
+#endif // !AWALI_ALGOS_MINIMIZE_INCREMENTAL_HH
@@ -29,10 +29,13 @@
 #include <awali/sttc/algos/is_eps_acyclic.hh>
 #include <awali/sttc/algos/is_proper.hh>
 #include <awali/sttc/algos/is_valid.hh>
+#include <awali/sttc/algos/proper_boolean.hh>
 #include <awali/sttc/algos/transpose.hh>
 #include <awali/sttc/core/kind.hh>
 #include <awali/sttc/misc/attributes.hh>
+#include <awali/sttc/weightset/b.hh>
 #include <awali/common/enums.hh>
+#include <awali/common/priority.hh>
 #include <awali/utils/heap.hh>
 #include <awali/common/ato.cc>
 
@@ -404,8 +407,25 @@ namespace awali { namespace sttc {
       {}
     };
 
-  }
 
+    /// Generic epsilon-removal.
+    template <typename Aut, typename P>
+    void proper_dispatch(Aut& aut, bool prune, priority::ONE<P>)
+    {
+      properer<Aut>::proper_here(aut, prune);
+    }
+
+    /// Boolean automata with epsilon transitions use the closure-based
+    /// algorithm, unless they are too large for it.
+    template <typename Aut, typename P>
+    auto proper_dispatch(Aut& aut, bool prune, priority::TWO<P>)
+      -> typename std::enable_if<labelset_t_of<Aut>::has_one()
+                                 && std::is_same<weightset_t_of<Aut>, b>::value>::type
+    {
+      if (!is_proper(aut) && !boolean_proper_here(aut, prune))
+        properer<Aut>::proper_here(aut, prune);
+    }
+  }
 
   /*---------.
   | proper.  |
@@ -428,11 +448,11 @@ namespace awali { namespace sttc {
   {
     switch(dir) {
       case BACKWARD:
-        internal::properer<Aut>::proper_here(aut, prune);
+        internal::proper_dispatch(aut, prune, priority::value);
         break;
       case FORWARD:
         transpose_here(aut);
-        internal::properer<Aut>::proper_here(aut, prune);
+        internal::proper_dispatch(aut, prune, priority::value);
         transpose_here(aut);
     }
   }
@@ -445,7 +465,7 @@ namespace awali { namespace sttc {
          bool prune = true, bool keep_history = true)
     -> decltype(copy(aut))
   {
-    auto res = aut;
+    decltype(copy(aut)) res;
     switch (dir)
     {
     case direction_t::BACKWARD:
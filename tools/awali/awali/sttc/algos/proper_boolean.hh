@@ -0,0 +1,298 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AWALI_ALGOS_PROPER_BOOLEAN_HH
+# define AWALI_ALGOS_PROPER_BOOLEAN_HH
+
+# include <algorithm>
+# include <cstdint>
+# include <limits>
+# include <utility>
+# include <vector>
+
+#include <awali/sttc/ctx/traits.hh>
+
+namespace awali { namespace sttc {
+
+  namespace internal
+  {
+    /// Backward epsilon-removal for Boolean automata.
+    ///
+    /// Since weights are Boolean, the result only depends on the
+    /// epsilon-closure of every state.  The graph of epsilon
+    /// transitions is condensed into its strongly connected
+    /// components, and the closure of every component is computed
+    /// as a bitset over the components, in the (reverse topological)
+    /// order in which Tarjan's algorithm produces them.  The letter
+    /// transitions are then added in one pass, state by state, and
+    /// all the epsilon transitions are removed.
+    ///
+    /// The closures require a quadratic number of bits in the number
+    /// of components; the algorithm refuses to run (and the caller
+    /// should fall back to the generic algorithm) above #max_bits.
+    template <typename Aut>
+    class boolean_properer
+    {
+      using automaton_t = typename std::remove_cv<Aut>::type;
+      using label_t = label_t_of<automaton_t>;
+      using labelset_t = labelset_t_of<automaton_t>;
+      using word_t = std::uint64_t;
+      static constexpr unsigned word_bits = 64;
+      static constexpr unsigned none = std::numeric_limits<unsigned>::max();
+
+    public:
+      /// Maximal number of bits of the table of closures.
+      static constexpr std::size_t max_bits = std::size_t(1) << 30;
+
+      boolean_properer(automaton_t& aut, bool prune)
+        : aut_(aut)
+        , prune_(prune)
+      {}
+
+      /// Remove the epsilon transitions of the automaton.
+      /// @return false if the automaton is too large for this
+      /// algorithm; the automaton is then left untouched.
+      bool operator()()
+      {
+        build_graph_();
+        if (num_nodes_ == 0)
+          return true;
+        tarjan_();
+        std::size_t words = (num_sccs_ + word_bits - 1) / word_bits;
+        if (words * word_bits * num_sccs_ > max_bits)
+          return false;
+        closures_.assign(words * num_sccs_, 0);
+        words_ = words;
+        compute_closures_();
+        add_transitions_();
+        remove_epsilons_();
+        return true;
+      }
+
+    private:
+      /// Index in the epsilon graph of the states with an incident
+      /// epsilon transition, and adjacency (without loops) in CSR form.
+      void build_graph_()
+      {
+        state_t max = aut_->post();
+        for (auto s : aut_->states())
+          if (s > max)
+            max = s;
+        node_of_.assign(max + 1, none);
+        for (auto t : aut_->transitions())
+          if (labelset_t::is_one(aut_->label_of(t))) {
+            eps_.emplace_back(t);
+            for (state_t s : {aut_->src_of(t), aut_->dst_of(t)})
+              if (node_of_[s] == none) {
+                node_of_[s] = states_.size();
+                states_.emplace_back(s);
+              }
+          }
+        num_nodes_ = states_.size();
+        succ_begin_.assign(num_nodes_ + 1, 0);
+        for (auto t : eps_)
+          if (aut_->src_of(t) != aut_->dst_of(t))
+            ++succ_begin_[node_of_[aut_->src_of(t)] + 1];
+        for (unsigned i = 0; i < num_nodes_; ++i)
+          succ_begin_[i + 1] += succ_begin_[i];
+        succ_.resize(succ_begin_[num_nodes_]);
+        std::vector<unsigned> pos(succ_begin_.begin(), succ_begin_.end() - 1);
+        for (auto t : eps_)
+          if (aut_->src_of(t) != aut_->dst_of(t))
+            succ_[pos[node_of_[aut_->src_of(t)]]++] = node_of_[aut_->dst_of(t)];
+      }
+
+      /// Iterative Tarjan algorithm on the epsilon graph; the
+      /// components are numbered in the order they are completed,
+      /// that is, successors first.
+      void tarjan_()
+      {
+        scc_of_.assign(num_nodes_, none);
+        std::vector<unsigned> index(num_nodes_, none), low(num_nodes_);
+        std::vector<unsigned> stack, call_stack, next(num_nodes_);
+        unsigned count = 0;
+        num_sccs_ = 0;
+        for (unsigned root = 0; root < num_nodes_; ++root) {
+          if (index[root] != none)
+            continue;
+          call_stack.emplace_back(root);
+          index[root] = low[root] = count++;
+          next[root] = succ_begin_[root];
+          stack.emplace_back(root);
+          while (!call_stack.empty()) {
+            unsigned v = call_stack.back();
+            if (next[v] < succ_begin_[v + 1]) {
+              unsigned w = succ_[next[v]++];
+              if (index[w] == none) {
+                index[w] = low[w] = count++;
+                next[w] = succ_begin_[w];
+                stack.emplace_back(w);
+                call_stack.emplace_back(w);
+              }
+              else if (scc_of_[w] == none)
+                low[v] = std::min(low[v], index[w]);
+              continue;
+            }
+            call_stack.pop_back();
+            if (!call_stack.empty())
+              low[call_stack.back()] = std::min(low[call_stack.back()], low[v]);
+            if (low[v] == index[v]) {
+              unsigned w;
+              do {
+                w = stack.back();
+                stack.pop_back();
+                scc_of_[w] = num_sccs_;
+              } while (w != v);
+              ++num_sccs_;
+            }
+          }
+        }
+      }
+
+      word_t* closure_(unsigned c)
+      {
+        return closures_.data() + c * words_;
+      }
+
+      /// Closure of a component: itself and the closures of the
+      /// components it reaches with one epsilon transition.  These
+      /// have smaller numbers, hence are already computed.
+      void compute_closures_()
+      {
+        std::vector<std::vector<unsigned>> members(num_sccs_);
+        for (unsigned v = 0; v < num_nodes_; ++v)
+          members[scc_of_[v]].emplace_back(v);
+        for (unsigned c = 0; c < num_sccs_; ++c) {
+          word_t* cl = closure_(c);
+          cl[c / word_bits] |= word_t(1) << (c % word_bits);
+          for (unsigned v : members[c])
+            for (unsigned i = succ_begin_[v]; i < succ_begin_[v + 1]; ++i) {
+              unsigned d = scc_of_[succ_[i]];
+              if (d != c) {
+                const word_t* dl = closure_(d);
+                for (std::size_t k = 0; k < words_; ++k)
+                  cl[k] |= dl[k];
+              }
+            }
+        }
+        members_ = std::move(members);
+      }
+
+      /// For every state p with an outgoing epsilon transition, add
+      /// p --a--> r for every letter transition q --a--> r (including
+      /// final transitions) with q in the closure of p.
+      void add_transitions_()
+      {
+        const auto& ls = *aut_->labelset();
+        using edge_t = std::pair<state_t, label_t>;
+        auto less = [&ls](const edge_t& e, const edge_t& f) {
+          return e.first < f.first
+          || (e.first == f.first && ls.less_than(e.second, f.second));
+        };
+        std::vector<edge_t> edges, existing;
+        for (unsigned v = 0; v < num_nodes_; ++v) {
+          if (succ_begin_[v] == succ_begin_[v + 1])
+            continue;
+          state_t p = states_[v];
+          edges.clear();
+          const word_t* cl = closure_(scc_of_[v]);
+          for (std::size_t k = 0; k < words_; ++k)
+            for (word_t w = cl[k]; w != 0; w &= w - 1) {
+              unsigned c = k * word_bits + __builtin_ctzll(w);
+              for (unsigned u : members_[c]) {
+                state_t q = states_[u];
+                if (q == p)
+                  continue;
+                for (auto t : aut_->all_out(q))
+                  if (!labelset_t::is_one(aut_->label_of(t)))
+                    edges.emplace_back(aut_->dst_of(t), aut_->label_of(t));
+              }
+            }
+          if (edges.empty())
+            continue;
+          std::sort(edges.begin(), edges.end(), less);
+          existing.clear();
+          for (auto t : aut_->all_out(p))
+            existing.emplace_back(aut_->dst_of(t), aut_->label_of(t));
+          std::sort(existing.begin(), existing.end(), less);
+          auto e = existing.begin();
+          for (std::size_t i = 0; i < edges.size(); ++i) {
+            if (i > 0 && !less(edges[i - 1], edges[i]))
+              continue;
+            while (e != existing.end() && less(*e, edges[i]))
+              ++e;
+            if (e != existing.end() && !less(edges[i], *e))
+              continue;
+            aut_->new_transition(p, edges[i].first, edges[i].second);
+          }
+        }
+      }
+
+      /// Remove the epsilon transitions, then, if required, the states
+      /// that they made inaccessible.
+      void remove_epsilons_()
+      {
+        for (auto t : eps_)
+          aut_->del_transition(t);
+        if (prune_)
+          for (auto s : states_)
+            if (aut_->all_in(s).empty())
+              aut_->del_state(s);
+      }
+
+      automaton_t& aut_;
+      bool prune_;
+      /// Epsilon transitions.
+      std::vector<transition_t> eps_;
+      /// Node of the epsilon graph -> state, and conversely.
+      std::vector<state_t> states_;
+      std::vector<unsigned> node_of_;
+      unsigned num_nodes_ = 0;
+      /// Adjacency of the epsilon graph.
+      std::vector<unsigned> succ_begin_;
+      std::vector<unsigned> succ_;
+      /// Node -> component, and component -> nodes.
+      std::vector<unsigned> scc_of_;
+      std::vector<std::vector<unsigned>> members_;
+      unsigned num_sccs_ = 0;
+      /// Closures, #words_ words per component.
+      std::vector<word_t> closures_;
+      std::size_t words_ = 0;
+    };
+
+    template <typename Aut>
+    constexpr unsigned boolean_properer<Aut>::word_bits;
+    template <typename Aut>
+    constexpr unsigned boolean_properer<Aut>::none;
+    template <typename Aut>
+    constexpr std::size_t boolean_properer<Aut>::max_bits;
+  }
+
+  /// Eliminate epsilon transitions of a Boolean automaton in place,
+  /// with the closure-based algorithm.
+  ///
+  /// @return false if the automaton has too many epsilon components
+  /// for this algorithm, in which case it is left untouched.
+  template <typename Aut>
+  inline
+  bool boolean_proper_here(Aut& aut, bool prune = true)
+  {
+    return internal::boolean_properer<Aut>(aut, prune)();
+  }
+
+}}//end of ns awali::stc
+
+#endif // !AWALI_ALGOS_PROPER_BOOLEAN_HH
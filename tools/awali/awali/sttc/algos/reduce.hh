@@ -18,7 +18,9 @@
 #ifndef AWALI_ALGOS_REDUCE_HH
 # define AWALI_ALGOS_REDUCE_HH
 
+# include <cstdint>
 # include <map>
+# include <tuple>
 # include <unordered_map>
 # include <vector>
 # include <cmath>
@@ -27,8 +29,10 @@
 #include <awali/sttc/algos/transpose.hh>
 #include <awali/sttc/core/mutable_automaton.hh>
 #include <awali/sttc/weightset/q.hh>
+#include <awali/sttc/weightset/q64.hh>
 #include <awali/sttc/weightset/r.hh>
 #include <awali/sttc/weightset/z.hh>
+#include <awali/sttc/weightset/z64.hh>
 
 namespace awali { namespace sttc {
 
@@ -101,6 +105,10 @@ namespace awali { namespace sttc {
     template<typename Weightset>
     struct select
     {
+      /// Whether vectors are reduced on contiguous rows, rather than
+      /// following the permutation; only useful for machine numbers.
+      static constexpr bool dense_rows = false;
+
       template<typename Reduc, typename Vector>
       static unsigned
       find_pivot(Reduc* that, const Vector& v,
@@ -157,6 +165,8 @@ namespace awali { namespace sttc {
     template <>
     struct select<r> : select<void>
     {
+      static constexpr bool dense_rows = true;
+
       template<typename Reduc, typename Vector>
       static unsigned
       find_pivot(Reduc* that, const Vector& v,
@@ -203,6 +213,31 @@ namespace awali { namespace sttc {
       }
     };
 
+    template <>
+    struct select<z64> : select<z>
+    {};
+
+    template <>
+    struct select<q64> : select<q>
+    {};
+
+    /** Transition matrix of a letter in the linear representation.
+
+        The matrix is stored in compressed sparse rows.  Over R, a
+        matrix which is dense enough is rather stored row by row in
+        \p dense, and vector-matrix products run on contiguous rows.
+    */
+    template <typename Weight>
+    struct reduce_matrix
+    {
+      /// The entries of row i are in [row_begin[i], row_begin[i+1]).
+      std::vector<unsigned> row_begin;
+      std::vector<unsigned> cols;
+      std::vector<Weight> vals;
+      /// Row-major entries; empty if the matrix is sparse.
+      std::vector<Weight> dense;
+    };
+
     template <typename Aut, typename AutOutput>
     class reductioner
     {
@@ -216,9 +251,14 @@ namespace awali { namespace sttc {
       using label_t = label_t_of<automaton_t>;
       using weight_t = typename context_t::weight_t;
       using vector_t = std::vector<weight_t>;
-      using matrix_t = std::vector<std::map<std::size_t, weight_t> > ;
+      using matrix_t = reduce_matrix<weight_t>;
       using matrix_set_t = std::map<label_t, matrix_t>;
 
+      /// Dense storage is used above this density (entries / dimension^2)...
+      static constexpr unsigned dense_ratio = 4;
+      /// ... and below this dimension.
+      static constexpr unsigned dense_max_dimension = 4096;
+
     public:
       reductioner(const automaton_t& input)
         : input_(input)
@@ -243,15 +283,54 @@ namespace awali { namespace sttc {
         // Computation of the final vector.
         for (auto t : input_->final_transitions())
           final[state_to_index[input_->src_of(t)]] = input_->weight_of(t);
-        // For each letter, we define an adjency matrix.
+        // For each letter, we define an adjency matrix: the entries
+        // of each row are counted, then placed.
         for (auto t : input_->transitions())
           {
             auto it = letter_matrix_set.find(input_->label_of(t));
             if (it == letter_matrix_set.end())
-              it = letter_matrix_set.emplace(input_->label_of(t),
-                                             matrix_t(dimension)).first;
-            it->second[state_to_index[input_->src_of(t)]]
-              [state_to_index[input_->dst_of(t)]] = input_->weight_of(t);
+              {
+                it = letter_matrix_set.emplace(input_->label_of(t),
+                                               matrix_t()).first;
+                it->second.row_begin.assign(dimension + 1, 0);
+              }
+            ++it->second.row_begin[state_to_index[input_->src_of(t)] + 1];
+          }
+        for (auto& mu : letter_matrix_set)
+          {
+            matrix_t& m = mu.second;
+            for (unsigned r = 0; r < dimension; ++r)
+              m.row_begin[r + 1] += m.row_begin[r];
+            m.cols.resize(m.row_begin[dimension]);
+            m.vals.resize(m.row_begin[dimension]);
+          }
+        // row_begin[r] is used as the insertion point of row r, then
+        // shifted back.
+        for (auto t : input_->transitions())
+          {
+            matrix_t& m = letter_matrix_set[input_->label_of(t)];
+            unsigned k = m.row_begin[state_to_index[input_->src_of(t)]]++;
+            m.cols[k] = state_to_index[input_->dst_of(t)];
+            m.vals[k] = input_->weight_of(t);
+          }
+        for (auto& mu : letter_matrix_set)
+          {
+            matrix_t& m = mu.second;
+            for (unsigned r = dimension; 0 < r; --r)
+              m.row_begin[r] = m.row_begin[r - 1];
+            m.row_begin[0] = 0;
+            if (select<weightset_t>::dense_rows
+                && dimension <= dense_max_dimension
+                && dense_ratio * m.cols.size()
+                   >= std::size_t(dimension) * dimension)
+              {
+                m.dense.assign(std::size_t(dimension) * dimension,
+                               ws_.zero());
+                for (unsigned r = 0; r < dimension; ++r)
+                  for (unsigned k = m.row_begin[r]; k < m.row_begin[r+1]; ++k)
+                    m.dense[std::size_t(r) * dimension + m.cols[k]]
+                      = m.vals[k];
+              }
           }
       }
 
@@ -263,11 +342,20 @@ namespace awali { namespace sttc {
                                  vector_t& res)
       {
         for (unsigned i = 0; i < dimension; i++)
-          for (auto it : m[i])
-            {
-              unsigned j = it.first;
-              res[j] = ws_.add(res[j], ws_.mul(v[i], it.second));
-            }
+          {
+            if (ws_.is_zero(v[i]))
+              continue;
+            if (!m.dense.empty())
+              {
+                const weight_t* row = &m.dense[std::size_t(i) * dimension];
+                for (unsigned j = 0; j < dimension; ++j)
+                  res[j] = ws_.add(res[j], ws_.mul(v[i], row[j]));
+              }
+            else
+              for (unsigned k = m.row_begin[i]; k < m.row_begin[i+1]; ++k)
+                res[m.cols[k]] = ws_.add(res[m.cols[k]],
+                                         ws_.mul(v[i], m.vals[k]));
+          }
       }
 
       /// Computes the scalar product of two vectors.
@@ -284,6 +372,8 @@ namespace awali { namespace sttc {
       using z_weight_t = sttc::z::value_t; // int or long
       using q_weight_t = sttc::q::value_t;
       using r_weight_t = sttc::r::value_t; // = double
+      using z64_weight_t = sttc::z64::value_t;
+      using q64_weight_t = sttc::q64::value_t;
 
       /*
         The pivot is the entry x of the vector such that norm(x) is minimal.
@@ -312,6 +402,16 @@ namespace awali { namespace sttc {
         return abs(w);
       }
 
+      static z64_weight_t norm(const q64_weight_t& w)
+      {
+        return w.den+abs(w.num);
+      }
+
+      static z64_weight_t norm(const z64_weight_t& w)
+      {
+        return abs(w);
+      }
+
       // Works for both Q and R.
       unsigned
       find_pivot_by_norm(const vector_t& v, unsigned begin,
@@ -343,30 +443,31 @@ namespace awali { namespace sttc {
 
       // Gcd function that also computes the Bezout coefficients.
       // Used in the z reduction.
-      static z_weight_t
-      gcd(z_weight_t x, z_weight_t y, z_weight_t& a, z_weight_t& b)
+      // Z is either z_weight_t or z64_weight_t.
+      template <typename Z>
+      static Z
+      gcd(Z x, Z y, Z& a, Z& b)
       {
-        //z_weight_t res = 0;
         //gcd = ax + by
         int sx=(x<0)?-1:1, sy=(y<0)?-1:1;
         bool inv=false;
         if(x<0) x=-x;
         if(y<0) y=-y;
         if(x>y){
-          z_weight_t t=x; x=y; y=t;
+          Z t=x; x=y; y=t;
           inv=true;
         }
         a=1; b=0;
-        int a0=0, b0=1;
+        Z a0=0, b0=1;
         while(y!=0) {
-          z_weight_t q=x/y, r=x%y;
-          z_weight_t a1=a0, b1=b0;
+          Z q=x/y, r=x%y;
+          Z a1=a0, b1=b0;
           a0=a-q*a0; b0=b-q*b0;
           a=a1;      b=b1;
           x=y;  y=r;
         }
         if(inv) {
-          int c=a; a=b; b=c;
+          Z c=a; a=b; b=c;
         }
         a*=sx; b*=sy;
         return x;
@@ -452,6 +553,17 @@ namespace awali { namespace sttc {
         weight_t ratio = current[pivot];//  vbasis[pivot] is one
         if (ws_.is_zero(ratio))
           return ratio;
+        if (select<weightset_t>::dense_rows)
+          {
+            // The entries of vbasis which come before the pivot are
+            // zero, hence the whole row may be processed.
+            weight_t* c = current.data();
+            const weight_t* v = vbasis.data();
+            for (unsigned i = 0; i < dimension; ++i)
+              c[i] = ws_.sub(c[i], ws_.mul(ratio, v[i]));
+            current[pivot] = ws_.zero();
+            return ratio;
+          }
         // This is safer than current[p] = current[p]-ratio*vbasis[p];
         current[pivot] = ws_.zero();
         for (unsigned i = b+1; i < dimension; ++i)
@@ -534,7 +646,7 @@ namespace awali { namespace sttc {
         // itself.
         for (unsigned nb = 0; nb < basis.size(); ++nb)
           // All the vectors basis[nb].mu(a) are processed
-          for (auto mu : letter_matrix_set) //mu is a pair (letter,matrix)
+          for (const auto& mu : letter_matrix_set) //mu is a pair (letter,matrix)
             {
               vector_t current(dimension);
               product_vector_matrix(basis[nb], mu.second, current);
@@ -578,7 +690,7 @@ namespace awali { namespace sttc {
             weight_t k = scalar_product(basis[v],final);
             if(!ws_.is_zero(k))
               res_->set_final(states[v],k);
-            for (auto mu : letter_matrix_set)
+            for (const auto& mu : letter_matrix_set)
               {
                 // mu is a pair (letter,matrix).
                 vector_t current(dimension);
@@ -613,29 +725,369 @@ namespace awali { namespace sttc {
 
     };
 
+
+    /*
+      Linear algebra modulo a prime.
+
+      The image of a weight of Z or Q in Z/pZ is computed (it exists
+      if p does not divide the denominator), and the spaces spanned by
+      the vectors I.mu(w) (forward) and mu(w).F (backward) are computed
+      modulo p, with machine integers.  No exact result may be read
+      from these computations, but:
+
+      - vectors which are independent modulo p are independent;
+        hence, if both spaces have full dimension modulo p, the
+        automaton is already reduced;
+
+      - if I.mu(w).F is not zero modulo p for some w, the series
+        realised by the automaton is not zero.
+    */
+
+    /// The inverse of \a x modulo the prime \a p, that is x^(p-2).
+    inline uint64_t inverse_mod(uint64_t x, uint64_t p)
+    {
+      uint64_t res = 1;
+      for (uint64_t e = p - 2; e != 0; e >>= 1, x = x * x % p)
+        if (e & 1)
+          res = res * x % p;
+      return res;
+    }
+
+    template <typename Weightset>
+    struct modular_weight
+    {
+      static constexpr bool enabled = false;
+
+      template <typename Weight>
+      static bool image(const Weight&, uint64_t, uint64_t&)
+      {
+        return false;
+      }
+    };
+
+    template <>
+    struct modular_weight<z>
+    {
+      static constexpr bool enabled = true;
+
+      static bool image(z::value_t w, uint64_t p, uint64_t& res)
+      {
+        long long x = w % (long long) p;
+        res = x < 0 ? x + p : x;
+        return true;
+      }
+    };
+
+    template <>
+    struct modular_weight<q>
+    {
+      static constexpr bool enabled = true;
+
+      static bool image(const q::value_t& w, uint64_t p, uint64_t& res)
+      {
+        uint64_t num, den = w.den % p;
+        if (den == 0)
+          return false;
+        modular_weight<z>::image(w.num, p, num);
+        res = num * inverse_mod(den, p) % p;
+        return true;
+      }
+    };
+
+    template <>
+    struct modular_weight<z64>
+    {
+      static constexpr bool enabled = true;
+
+      static bool image(const z64::value_t& w, uint64_t p, uint64_t& res)
+      {
+        res = w.mod(p);
+        return true;
+      }
+    };
+
+    template <>
+    struct modular_weight<q64>
+    {
+      static constexpr bool enabled = true;
+
+      static bool image(const q64::value_t& w, uint64_t p, uint64_t& res)
+      {
+        uint64_t den = w.den.mod(p);
+        if (den == 0)
+          return false;
+        res = w.num.mod(p) * inverse_mod(den, p) % p;
+        return true;
+      }
+    };
+
+    template <typename Aut>
+    class modular_reductioner
+    {
+      using automaton_t = Aut;
+      using weightset_t = weightset_t_of<automaton_t>;
+      using modular_t = modular_weight<weightset_t>;
+      using vector_t = std::vector<uint64_t>;
+
+    public:
+      modular_reductioner(const automaton_t& input)
+        : input_(input)
+      {}
+
+      /// Whether the representation modulo some prime could be built.
+      bool represent()
+      {
+        if (!modular_t::enabled)
+          return false;
+        // Primes below 2^31, so that products fit in 64 bits.
+        for (uint64_t p : {2147483647ull, 2147483629ull, 2147483587ull})
+          if (represent(p))
+            return true;
+        return false;
+      }
+
+      /// Dimension of the forward (or backward) space modulo p.
+      ///
+      /// Also records whether the series is not zero modulo p.
+      unsigned span(bool forward)
+      {
+        vector_t v = forward ? init_ : final_;
+        const vector_t& other = forward ? final_ : init_;
+        std::vector<vector_t> basis;
+        std::vector<unsigned> pivots;
+        if (!insert(basis, pivots, v))
+          return 0;
+        vector_t current(dimension_);
+        for (unsigned nb = 0; nb < basis.size(); ++nb)
+          {
+            uint64_t k = 0;
+            for (unsigned i = 0; i < dimension_; ++i)
+              k = (k + basis[nb][i] * other[i]) % p_;
+            nonzero_ |= k != 0;
+            for (const auto& m : matrices_)
+              {
+                std::fill(current.begin(), current.end(), 0);
+                product(basis[nb], forward ? m.first : m.second, current);
+                insert(basis, pivots, current);
+              }
+          }
+        return basis.size();
+      }
+
+      /// Whether I.mu(w).F is not zero modulo p for some word w.
+      bool nonzero_series() const
+      {
+        return nonzero_;
+      }
+
+      unsigned dimension() const
+      {
+        return dimension_;
+      }
+
+    private:
+      /// Compressed sparse rows (see reduce_matrix).
+      struct matrix_t
+      {
+        std::vector<unsigned> row_begin;
+        std::vector<unsigned> cols;
+        std::vector<uint64_t> vals;
+      };
+
+      bool represent(uint64_t p)
+      {
+        p_ = p;
+        std::unordered_map<state_t, unsigned> state_to_index;
+        dimension_ = 0;
+        for (auto s: input_->states())
+          state_to_index[s] = dimension_++;
+        init_.assign(dimension_, 0);
+        final_.assign(dimension_, 0);
+        for (auto t : input_->initial_transitions())
+          if (!modular_t::image(input_->weight_of(t), p_,
+                                init_[state_to_index[input_->dst_of(t)]]))
+            return false;
+        for (auto t : input_->final_transitions())
+          if (!modular_t::image(input_->weight_of(t), p_,
+                                final_[state_to_index[input_->src_of(t)]]))
+            return false;
+        // Each letter has its matrix (first) and its transpose (second).
+        std::map<label_t_of<automaton_t>, std::pair<matrix_t, matrix_t>> ms;
+        std::map<label_t_of<automaton_t>,
+                 std::vector<std::tuple<unsigned, unsigned, uint64_t>>> es;
+        for (auto t : input_->transitions())
+          {
+            uint64_t w;
+            if (!modular_t::image(input_->weight_of(t), p_, w))
+              return false;
+            es[input_->label_of(t)].emplace_back
+              (state_to_index[input_->src_of(t)],
+               state_to_index[input_->dst_of(t)], w);
+          }
+        matrices_.clear();
+        for (auto& e : es)
+          {
+            matrices_.emplace_back();
+            fill(matrices_.back().first, e.second, false);
+            fill(matrices_.back().second, e.second, true);
+          }
+        return true;
+      }
+
+      void fill(matrix_t& m,
+                const std::vector<std::tuple<unsigned, unsigned, uint64_t>>& es,
+                bool transposed)
+      {
+        m.row_begin.assign(dimension_ + 1, 0);
+        for (const auto& e : es)
+          ++m.row_begin[(transposed ? std::get<1>(e) : std::get<0>(e)) + 1];
+        for (unsigned r = 0; r < dimension_; ++r)
+          m.row_begin[r + 1] += m.row_begin[r];
+        m.cols.resize(es.size());
+        m.vals.resize(es.size());
+        std::vector<unsigned> pos(m.row_begin.begin(), m.row_begin.end() - 1);
+        for (const auto& e : es)
+          {
+            unsigned src = transposed ? std::get<1>(e) : std::get<0>(e);
+            m.cols[pos[src]] = transposed ? std::get<0>(e) : std::get<1>(e);
+            m.vals[pos[src]++] = std::get<2>(e);
+          }
+      }
+
+      void product(const vector_t& v, const matrix_t& m, vector_t& res) const
+      {
+        for (unsigned i = 0; i < dimension_; ++i)
+          if (v[i] != 0)
+            for (unsigned k = m.row_begin[i]; k < m.row_begin[i+1]; ++k)
+              res[m.cols[k]] = (res[m.cols[k]] + v[i] * m.vals[k]) % p_;
+      }
+
+      /// Reduce \a v w.r.t. the basis, and insert it if it is not zero.
+      bool insert(std::vector<vector_t>& basis, std::vector<unsigned>& pivots,
+                  vector_t& v)
+      {
+        for (unsigned b = 0; b < basis.size(); ++b)
+          {
+            uint64_t ratio = v[pivots[b]];
+            if (ratio == 0)
+              continue;
+            // Every row of the basis is normalised (pivot equal to 1).
+            ratio = p_ - ratio;
+            const uint64_t* row = basis[b].data();
+            uint64_t* c = v.data();
+            for (unsigned i = 0; i < dimension_; ++i)
+              c[i] = (c[i] + ratio * row[i]) % p_;
+          }
+        unsigned pivot = 0;
+        while (pivot < dimension_ && v[pivot] == 0)
+          ++pivot;
+        if (pivot == dimension_)
+          return false;
+        uint64_t inv = inverse_mod(v[pivot], p_);
+        for (unsigned i = pivot; i < dimension_; ++i)
+          v[i] = v[i] * inv % p_;
+        pivots.emplace_back(pivot);
+        basis.emplace_back(v);
+        return true;
+      }
+
+      automaton_t input_;
+      uint64_t p_;
+      unsigned dimension_;
+      vector_t init_;
+      vector_t final_;
+      std::vector<std::pair<matrix_t, matrix_t>> matrices_;
+      bool nonzero_ = false;
+    };
+
   }
 
-  template<typename Aut>
-  Aut reduce(const Aut& input)
+  namespace internal
   {
-    auto tmp = transpose_view(input);
-    internal::reductioner<decltype(tmp), Aut> algo(tmp);
-    algo.left_reduce();
-    auto tmp2=transpose_view(algo.get_output());
-    internal::reductioner<decltype(tmp2), Aut> algo2(tmp2);
-    algo2.left_reduce();
-    auto ret=copy(algo2.get_output());
-    if(ret->num_states() >= input->num_states())
-      ret= copy(input);
-    if(!input->get_name().empty()) {
-      ret->set_desc("Reduction of "+input->get_name());
-      ret->set_name("red-"+input->get_name());
+    /// What linear algebra modulo a prime shows about an automaton.
+    struct modular_check_t
+    {
+      /// The realised series is not zero.
+      bool nonzero = false;
+      /// The automaton is reduced.
+      bool reduced = false;
+    };
+
+    /// Linear algebra modulo a prime on \a input; a property is false
+    /// if it does not hold or if it cannot be shown.  The backward space
+    /// is only computed if the forward one has full dimension.
+    template<typename Aut>
+    modular_check_t check_modular(const Aut& input)
+    {
+      modular_check_t res;
+      modular_reductioner<Aut> algo(input);
+      if (!algo.represent())
+        return res;
+      unsigned forward = algo.span(true);
+      res.nonzero = algo.nonzero_series();
+      res.reduced = algo.dimension() != 0
+        && forward == algo.dimension()
+        && algo.span(false) == algo.dimension();
+      return res;
+    }
+
+    /// Whether \a input is shown to be reduced by linear algebra
+    /// modulo a prime; false if it is not or if it cannot be shown.
+    template<typename Aut>
+    bool is_reduced_modular(const Aut& input)
+    {
+      return check_modular(input).reduced;
     }
-    else {
-      ret->set_desc("Reduction");
-      ret->set_name("red");
+
+    /// Reduction of \a input, which is copied if \a reduced is set,
+    /// that is, if it is already known to be reduced.
+    template<typename Aut>
+    Aut reduce(const Aut& input, bool reduced)
+    {
+      Aut ret;
+      if (reduced)
+        ret = copy(input);
+      else {
+        auto tmp = transpose_view(input);
+        internal::reductioner<decltype(tmp), Aut> algo(tmp);
+        algo.left_reduce();
+        auto tmp2=transpose_view(algo.get_output());
+        internal::reductioner<decltype(tmp2), Aut> algo2(tmp2);
+        algo2.left_reduce();
+        ret=copy(algo2.get_output());
+        if(ret->num_states() >= input->num_states())
+          ret= copy(input);
+      }
+      if(!input->get_name().empty()) {
+        ret->set_desc("Reduction of "+input->get_name());
+        ret->set_name("red-"+input->get_name());
+      }
+      else {
+        ret->set_desc("Reduction");
+        ret->set_name("red");
+      }
+      return ret;
     }
-    return ret;
+  }
+
+  /** Reduction of a weighted automaton
+   *
+   * Computes an automaton with a minimal number of states which
+   * realises the same series as \a input, by computing bases of the
+   * spaces spanned by the vectors I.mu(w), then mu(w).F.
+   *
+   * Over Z and Q, the ranks are first computed modulo a prime: if
+   * \a input is shown to be reduced, it is copied without any exact
+   * computation.
+   *
+   * @tparam Aut the type of the automaton
+   * @param input an automaton over a field or Z, labelled by letters
+   * @return a reduced automaton
+   */
+  template<typename Aut>
+  Aut reduce(const Aut& input)
+  {
+    return internal::reduce(input, internal::is_reduced_modular(input));
   }
 
   template<typename Aut>
@@ -17,15 +17,401 @@
 #ifndef STTC_ALGOS_FACTOR_HH
 #define STTC_ALGOS_FACTOR_HH
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stack>
+#include <thread>
 #include <vector>
 #include <unordered_map>
 
+#include <awali/common/enums.hh>
 #include <awali/sttc/history/partition_history.hh>
 
 namespace awali { namespace sttc {
 
   namespace internal {
 
+    /// Flat snapshot of the transition graph of an automaton.
+    ///
+    /// The states (without pre() and post()) are numbered from 0 in
+    /// the order of aut->states(); the successors and the predecessors
+    /// of every vertex are stored contiguously (compressed sparse rows).
+    struct flat_graph_t {
+      /// Vertex -> state.
+      std::vector<state_t> states;
+      /// Successors of v: succ[succ_begin[v]] to succ[succ_begin[v+1]-1].
+      std::vector<unsigned> succ_begin;
+      std::vector<unsigned> succ;
+      /// Predecessors, likewise.
+      std::vector<unsigned> pred_begin;
+      std::vector<unsigned> pred;
+
+      unsigned size() const { return states.size(); }
+    };
+
+    template <typename Aut>
+    flat_graph_t
+    flat_graph(const Aut& aut)
+    {
+      flat_graph_t res;
+      state_t max = aut->post();
+      for (auto s : aut->states()) {
+        res.states.emplace_back(s);
+        if (s > max)
+          max = s;
+      }
+      unsigned n = res.states.size();
+      std::vector<unsigned> index(max + 1);
+      for (unsigned v = 0; v < n; ++v)
+        index[res.states[v]] = v;
+      res.succ_begin.assign(n + 1, 0);
+      res.pred_begin.assign(n + 1, 0);
+      for (unsigned v = 0; v < n; ++v)
+        for (auto t : aut->out(res.states[v])) {
+          ++res.succ_begin[v + 1];
+          ++res.pred_begin[index[aut->dst_of(t)] + 1];
+        }
+      for (unsigned v = 0; v < n; ++v) {
+        res.succ_begin[v + 1] += res.succ_begin[v];
+        res.pred_begin[v + 1] += res.pred_begin[v];
+      }
+      res.succ.resize(res.succ_begin[n]);
+      res.pred.resize(res.pred_begin[n]);
+      std::vector<unsigned> pos(res.pred_begin.begin(), res.pred_begin.end() - 1);
+      for (unsigned v = 0; v < n; ++v) {
+        unsigned i = res.succ_begin[v];
+        for (auto t : aut->out(res.states[v])) {
+          unsigned w = index[aut->dst_of(t)];
+          res.succ[i++] = w;
+          res.pred[pos[w]++] = v;
+        }
+      }
+      return res;
+    }
+
+    /// Parallel computation of the strongly connected components of
+    /// a flat graph, by the forward-backward algorithm with trimming.
+    ///
+    /// The vertices without predecessor or without successor are
+    /// first trimmed: they are trivial components.  Then, every task
+    /// is a set of vertices which is a union of components.  The
+    /// vertices of the set reachable from a pivot and the vertices
+    /// co-reachable from it are computed simultaneously; their
+    /// intersection is the component of the pivot, and the three other
+    /// parts are unions of components, which become new tasks for the
+    /// pool of threads.  Small sets are decomposed by the iterative
+    /// Tarjan algorithm.  No recursion is involved.
+    ///
+    /// Every vertex has the color of the task it belongs to; colors are
+    /// never reused, so that a task only sees its own vertices even
+    /// while other tasks recolor theirs.
+    class parallel_scc_t {
+      static constexpr unsigned none = -1U;
+      /// Sets with at most this number of vertices are handled by the
+      /// Tarjan algorithm.
+      static constexpr std::size_t small_size = 1024;
+
+    public:
+      parallel_scc_t(const flat_graph_t& g, unsigned num_threads)
+        : g_(g)
+        , color_(g.size())
+        , mark_(g.size())
+        , comp_(g.size(), unsigned(none))
+        , index_(g.size(), unsigned(none))
+        , low_(g.size())
+        , num_threads_(num_threads ? num_threads
+                       : std::max(1u, std::thread::hardware_concurrency()))
+      {
+        for (unsigned v = 0; v < g.size(); ++v) {
+          color_[v].store(none, std::memory_order_relaxed);
+          mark_[v].store(0, std::memory_order_relaxed);
+        }
+      }
+
+      /// The component of every vertex; the components are numbered
+      /// from 0 in the order of their smallest vertex.
+      std::vector<unsigned> operator()()
+      {
+        task_t rest = trim_();
+        if (!rest.empty()) {
+          unsigned c = new_color_();
+          for (unsigned v : rest)
+            color_[v].store(c, std::memory_order_relaxed);
+          push_(std::move(rest));
+          std::vector<std::thread> workers;
+          for (unsigned i = 1; i < num_threads_; ++i)
+            workers.emplace_back([this] { work_(); });
+          work_();
+          for (auto& w : workers)
+            w.join();
+        }
+        std::vector<unsigned> renum(num_comps_, unsigned(none)), res(g_.size());
+        unsigned num = 0;
+        for (unsigned v = 0; v < g_.size(); ++v) {
+          unsigned& c = renum[comp_[v]];
+          if (c == none)
+            c = num++;
+          res[v] = c;
+        }
+        return res;
+      }
+
+    private:
+      using task_t = std::vector<unsigned>;
+
+      /// A forward reach posted by split_ for another worker.
+      struct reach_job_t {
+        unsigned pivot;
+        unsigned color;
+        /// Set, under the mutex, by the worker that ran the job.
+        bool done;
+      };
+
+      unsigned new_component_()
+      {
+        return num_comps_.fetch_add(1);
+      }
+
+      unsigned new_color_()
+      {
+        return num_colors_.fetch_add(1);
+      }
+
+      unsigned color_of_(unsigned v) const
+      {
+        return color_[v].load(std::memory_order_relaxed);
+      }
+
+      /// Remove iteratively the vertices with no predecessor or no
+      /// successor (self-loops aside); return the remaining vertices.
+      task_t trim_()
+      {
+        unsigned n = g_.size();
+        std::vector<unsigned> in(n), out(n), todo;
+        for (unsigned v = 0; v < n; ++v) {
+          in[v] = g_.pred_begin[v + 1] - g_.pred_begin[v];
+          out[v] = g_.succ_begin[v + 1] - g_.succ_begin[v];
+          for (unsigned i = g_.succ_begin[v]; i < g_.succ_begin[v + 1]; ++i)
+            if (g_.succ[i] == v) {
+              --in[v];
+              --out[v];
+            }
+          if (in[v] == 0 || out[v] == 0) {
+            comp_[v] = new_component_();
+            todo.emplace_back(v);
+          }
+        }
+        while (!todo.empty()) {
+          unsigned v = todo.back();
+          todo.pop_back();
+          for (unsigned i = g_.succ_begin[v]; i < g_.succ_begin[v + 1]; ++i) {
+            unsigned w = g_.succ[i];
+            if (comp_[w] == none && --in[w] == 0) {
+              comp_[w] = new_component_();
+              todo.emplace_back(w);
+            }
+          }
+          for (unsigned i = g_.pred_begin[v]; i < g_.pred_begin[v + 1]; ++i) {
+            unsigned w = g_.pred[i];
+            if (comp_[w] == none && --out[w] == 0) {
+              comp_[w] = new_component_();
+              todo.emplace_back(w);
+            }
+          }
+        }
+        task_t res;
+        for (unsigned v = 0; v < n; ++v)
+          if (comp_[v] == none)
+            res.emplace_back(v);
+        return res;
+      }
+
+      void push_(task_t&& t)
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          tasks_.emplace_back(std::move(t));
+          ++pending_;
+        }
+        cond_.notify_one();
+      }
+
+      void work_()
+      {
+        while (true) {
+          task_t t;
+          {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this] {
+                return !reaches_.empty() || !tasks_.empty() || pending_ == 0;
+              });
+            if (!reaches_.empty()) {
+              reach_job_t* job = reaches_.back();
+              reaches_.pop_back();
+              lock.unlock();
+              reach_(job->pivot, job->color, 1, true);
+              lock.lock();
+              job->done = true;
+              cond_.notify_all();
+              continue;
+            }
+            if (tasks_.empty())
+              return;
+            t = std::move(tasks_.back());
+            tasks_.pop_back();
+          }
+          if (t.size() <= small_size)
+            tarjan_(t);
+          else
+            split_(t);
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (--pending_ == 0)
+            cond_.notify_all();
+        }
+      }
+
+      /// Set \a bit in the marks of the vertices of color \a c that are
+      /// reachable from \a pivot, forward or backward.
+      void reach_(unsigned pivot, unsigned c, char bit, bool forward)
+      {
+        const auto& begin = forward ? g_.succ_begin : g_.pred_begin;
+        const auto& adj = forward ? g_.succ : g_.pred;
+        std::vector<unsigned> todo{pivot};
+        mark_[pivot].fetch_or(bit, std::memory_order_relaxed);
+        while (!todo.empty()) {
+          unsigned v = todo.back();
+          todo.pop_back();
+          for (unsigned i = begin[v]; i < begin[v + 1]; ++i) {
+            unsigned w = adj[i];
+            if (color_of_(w) == c
+                && !(mark_[w].fetch_or(bit, std::memory_order_relaxed) & bit))
+              todo.emplace_back(w);
+          }
+        }
+      }
+
+      /// One step of the forward-backward algorithm.
+      ///
+      /// The forward reach is offered to an idle worker of the pool
+      /// while this one computes the backward reach; if no worker took
+      /// it in the meantime, this one runs it as well.
+      void split_(const task_t& t)
+      {
+        unsigned c = color_of_(t[0]);
+        unsigned pivot = t[t.size() / 2];
+        if (num_threads_ == 1) {
+          reach_(pivot, c, 1, true);
+          reach_(pivot, c, 2, false);
+        }
+        else {
+          reach_job_t job{pivot, c, false};
+          {
+            std::lock_guard<std::mutex> lock(mutex_);
+            reaches_.emplace_back(&job);
+          }
+          cond_.notify_all();
+          reach_(pivot, c, 2, false);
+          std::unique_lock<std::mutex> lock(mutex_);
+          auto i = std::find(reaches_.begin(), reaches_.end(), &job);
+          if (i != reaches_.end()) {
+            reaches_.erase(i);
+            lock.unlock();
+            reach_(pivot, c, 1, true);
+          }
+          else
+            cond_.wait(lock, [&job] { return job.done; });
+        }
+        task_t parts[3];
+        unsigned comp = new_component_();
+        for (unsigned v : t) {
+          char m = mark_[v].exchange(0, std::memory_order_relaxed);
+          if (m == 3)
+            comp_[v] = comp;
+          else
+            parts[int(m)].emplace_back(v);
+        }
+        for (auto& p : parts)
+          if (!p.empty()) {
+            unsigned d = new_color_();
+            for (unsigned v : p)
+              color_[v].store(d, std::memory_order_relaxed);
+            push_(std::move(p));
+          }
+      }
+
+      /// Iterative Tarjan algorithm on the vertices of \a t.
+      void tarjan_(const task_t& t)
+      {
+        unsigned c = color_of_(t[0]);
+        std::vector<unsigned> stack, call_stack, next;
+        unsigned count = 0;
+        for (unsigned root : t) {
+          if (index_[root] != none)
+            continue;
+          index_[root] = low_[root] = count++;
+          stack.emplace_back(root);
+          call_stack.emplace_back(root);
+          next.emplace_back(g_.succ_begin[root]);
+          while (!call_stack.empty()) {
+            unsigned v = call_stack.back();
+            unsigned& i = next.back();
+            if (i < g_.succ_begin[v + 1]) {
+              unsigned w = g_.succ[i++];
+              if (color_of_(w) != c)
+                continue;
+              if (index_[w] == none) {
+                index_[w] = low_[w] = count++;
+                stack.emplace_back(w);
+                call_stack.emplace_back(w);
+                next.emplace_back(g_.succ_begin[w]);
+              }
+              else if (comp_[w] == none)
+                low_[v] = std::min(low_[v], index_[w]);
+              continue;
+            }
+            call_stack.pop_back();
+            next.pop_back();
+            if (!call_stack.empty())
+              low_[call_stack.back()] = std::min(low_[call_stack.back()],
+                                                 low_[v]);
+            if (low_[v] == index_[v]) {
+              unsigned comp = new_component_();
+              unsigned w;
+              do {
+                w = stack.back();
+                stack.pop_back();
+                comp_[w] = comp;
+              } while (w != v);
+            }
+          }
+        }
+      }
+
+      const flat_graph_t& g_;
+      /// Vertex -> color of its task.
+      std::vector<std::atomic<unsigned>> color_;
+      /// Vertex -> 1 if reached forward, 2 if reached backward.
+      std::vector<std::atomic<char>> mark_;
+      /// Vertex -> component (not canonical).
+      std::vector<unsigned> comp_;
+      /// Tarjan's algorithm.
+      std::vector<unsigned> index_;
+      std::vector<unsigned> low_;
+      std::atomic<unsigned> num_comps_{0};
+      std::atomic<unsigned> num_colors_{0};
+      unsigned num_threads_;
+      /// Pool of tasks.
+      std::mutex mutex_;
+      std::condition_variable cond_;
+      std::vector<task_t> tasks_;
+      /// Forward reaches waiting for a worker.
+      std::vector<reach_job_t*> reaches_;
+      unsigned pending_ = 0;
+    };
+
+
     template <typename Aut>
     class tarjaner_t {
 
@@ -207,6 +593,37 @@ namespace awali { namespace sttc {
       }
 
 
+      void
+      compute_sccs_parallel (unsigned num_threads)
+      {
+        flat_graph_t g = flat_graph(aut);
+        std::vector<unsigned> comp = parallel_scc_t(g, num_threads)();
+        unsigned num = 0;
+        for (unsigned c : comp)
+          num = std::max(num, c + 1);
+        data.states_of.resize(num);
+        for (unsigned v = 0; v < g.size(); ++v) {
+          data.states_of[comp[v]].push_back(g.states[v]);
+          data.scc_of[g.states[v]] = comp[v] + data.cur_scc;
+        }
+        data.cur_scc += num;
+      }
+
+      void
+      compute_sccs (scc_algo_t algo, unsigned num_threads = 0)
+      {
+        switch (algo) {
+        case TARJAN_RECURSIVE:
+          compute_sccs_recursive();
+          break;
+        case FORWARD_BACKWARD:
+          compute_sccs_parallel(num_threads);
+          break;
+        default:
+          compute_sccs_iterative();
+        }
+      }
+
       //This function should not be called before iterative or recursive
       void
       add_subliminal_sccs ()
@@ -319,6 +736,49 @@ namespace awali { namespace sttc {
   }
 
 
+    /** Parallel computation of strongly connected components
+     *
+     * The components are computed by the forward-backward algorithm
+     * on a flat snapshot of the transitions, with a pool of threads;
+     * the algorithm is not recursive, hence suitable for very large
+     * automata.  The components are numbered in the order of their
+     * first state in `aut->states()`.
+     *
+     * @tparam Aut the type of the automaton
+     * @param aut the automaton
+     * @param num_threads the number of threads; 0 means as many as
+     * there are cores
+     * @return a pair where the first component is a map from states into strongly connected components, and the second component gives, for each scc, the list of its states.
+     */
+  template <typename Aut>
+  std::pair< std::unordered_map<state_t, unsigned int>,
+             std::vector<std::vector<state_t>> >
+  scc_parallel (Aut aut, unsigned num_threads = 0)
+  {
+    internal::tarjaner_t<Aut> tarjaner(aut);
+    tarjaner.compute_sccs_parallel(num_threads);
+    return tarjaner.get_result();
+  }
+
+
+    /** Computation of strongly connected components
+     *
+     * @tparam Aut the type of the automaton
+     * @param aut the automaton
+     * @param algo the algorithm
+     * @return a pair where the first component is a map from states into strongly connected components, and the second component gives, for each scc, the list of its states.
+     */
+  template <typename Aut>
+  std::pair< std::unordered_map<state_t, unsigned int>,
+             std::vector<std::vector<state_t>> >
+  scc (Aut aut, scc_algo_t algo)
+  {
+    internal::tarjaner_t<Aut> tarjaner(aut);
+    tarjaner.compute_sccs(algo);
+    return tarjaner.get_result();
+  }
+
+
     /** Condense each strongly connected component to a state
      *
      * A new automaton is created, where every state corresponds to a
@@ -334,16 +794,17 @@ namespace awali { namespace sttc {
      *
      * @tparam Aut the type of the automaton
      * @param aut the automaton
+     * @param algo the algorithm computing the components
      * @return a pair where the first component is the condensed automaton, and the second one is a pair
 where the first component is a map from states into strongly connected components, and the second component gives, for each scc, the list of its states.
      */
   template <typename Aut>
   std::pair<  Aut, std::pair< std::unordered_map<state_t, unsigned int>,
                               std::vector<std::vector<state_t>> >  >
-  condensation (Aut aut)
+  condensation (Aut aut, scc_algo_t algo = TARJAN_ITERATIVE)
   {
     internal::tarjaner_t<Aut> tarjaner(aut);
-    tarjaner.compute_sccs_iterative();
+    tarjaner.compute_sccs(algo);
     tarjaner.add_subliminal_sccs();
     Aut out = tarjaner.condensation();
     return {out, tarjaner.get_result()};
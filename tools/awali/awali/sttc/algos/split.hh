@@ -31,10 +31,14 @@ namespace awali { namespace sttc {
     // E.g., expand.
 
     /// Type of PolynomialSet of RatExps from the RatExpSet type.
+    ///
+    /// Derived terms and expansions are mostly made of a few
+    /// monomials: they are stored as flat vectors.
     template <typename RatExpSet>
     using ratexp_polynomialset_t
       = polynomialset<context<RatExpSet,
-                              weightset_t_of<RatExpSet>>>;
+                              weightset_t_of<RatExpSet>>,
+                      poly_repr::flat>;
 
     /// Type of polynomials of ratexps from the RatExpSet type.
     template <typename RatExpSet>
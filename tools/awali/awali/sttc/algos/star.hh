@@ -88,19 +88,29 @@ namespace awali {
        }
     }
 
+    /// In place star of an automaton.
+    ///
+    /// If the labelset admits epsilon transitions, the star is realized
+    /// by epsilon transitions from final states to initial states and a
+    /// new initial and final state, unless \a epsilon_free is `true`.
+    /// Otherwise, the automaton is standardized and the transitions
+    /// outgoing from its initial state are duplicated from its final
+    /// states.
     template<typename Aut>
     Aut&
-    star_here(Aut& res) {
+    star_here(Aut& res, bool epsilon_free=false) {
+      if (epsilon_free)
+        return internal::star_here(res, priority::one);
       return internal::star_here(res, priority::value);
     }
     
     /// Star of an automaton.
     template <typename Aut>
     typename Aut::element_type::automaton_nocv_t
-    star(const Aut& aut)
+    star(const Aut& aut, bool epsilon_free=false)
     {
       auto res = copy(aut);
-      star_here(res);
+      star_here(res, epsilon_free);
       return res;
     }
   }
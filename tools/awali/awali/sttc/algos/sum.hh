@@ -17,7 +17,7 @@
 #ifndef AWALI_ALGOS_SUM_HH
 # define AWALI_ALGOS_SUM_HH
 
-# include <map>
+# include <vector>
 
 #include <awali/sttc/algos/product.hh> // join_automata
 #include <awali/sttc/algos/standard.hh> // is_standard
@@ -44,13 +44,18 @@ namespace awali {
         require(is_standard(b), __func__, ": second automaton should be standard");
 
         //Copy b into res (except the initial state)
-        // State in b -> state in res.
-        std::map<state_t, state_t> m;
+        // State in b -> state in res, indexed by the states of b.
         state_t initial = res->dst_of(*(res->initial_transitions().begin()));
+        state_t b_initial = b->dst_of(*(b->initial_transitions().begin()));
+        state_t max = b->post();
         for (auto s: b->states())
-          m.emplace(s, b->is_initial(s) ? initial : res->add_state());
-        m.emplace(b->pre(), res->pre());
-        m.emplace(b->post(), res->post());
+          if (s > max)
+            max = s;
+        std::vector<state_t> m(max + 1, res->null_state());
+        for (auto s: b->states())
+          m[s] = (s == b_initial) ? initial : res->add_state();
+        m[b->pre()] = res->pre();
+        m[b->post()] = res->post();
 
         // Add b.
         for (auto t: b->all_transitions())
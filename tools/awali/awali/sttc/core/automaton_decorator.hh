@@ -182,6 +182,7 @@ namespace awali { namespace sttc {
       DEFINE(add_transition_copy)
       DEFINE(add_weight)
       DEFINE(del_state)
+      DEFINE(del_states)
       DEFINE(del_transition)
       DEFINE(lmul_weight)
       DEFINE(add_state)
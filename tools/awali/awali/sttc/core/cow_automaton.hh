@@ -0,0 +1,108 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AWALI_CORE_COW_AUTOMATON_HH
+# define AWALI_CORE_COW_AUTOMATON_HH
+
+#include <awali/sttc/core/mutable_automaton.hh>
+
+#include <utility>
+
+namespace awali {
+  namespace sttc {
+
+    /** @brief Copy-on-write handle on a mutable automaton.
+     *
+     * Copies of a handle share the same storage; reading through a
+     * handle never copies anything.  The storage is duplicated only
+     * when write access is requested with {@link mut} while it is
+     * shared, either with another handle or with a plain
+     * mutable_automaton.
+     *
+     * The duplication preserves state and transition indices, hence
+     * states obtained from a handle remain valid after it detaches.
+     * State names, name and description are duplicated as well; the
+     * history is not.
+     *
+     * A handle built from an automaton which is not referred to
+     * anywhere else (a temporary, or a moved automaton) owns its
+     * storage, so that algorithms such as {@link concatenate} can
+     * modify it in place instead of copying it.
+     *
+     * @tparam Aut the type of the automaton, a mutable automaton
+     */
+    template <typename Aut>
+    class cow_automaton
+    {
+    public:
+      using automaton_t = Aut;
+      using context_t = context_t_of<automaton_t>;
+      using element_type = typename automaton_t::element_type;
+
+      cow_automaton(automaton_t aut)
+        : aut_(std::move(aut))
+      {}
+
+      /// Read-only access to the automaton.
+      const element_type* operator->() const {
+        return aut_.get();
+      }
+
+      /// The shared automaton; it must not be modified through the result.
+      const automaton_t& get() const {
+        return aut_;
+      }
+
+      /// Whether the storage is shared with another owner.
+      bool is_shared() const {
+        return aut_.use_count() > 1;
+      }
+
+      /// Write access to the automaton; detaches the handle first.
+      const automaton_t& mut() {
+        detach();
+        return aut_;
+      }
+
+      /// Give this handle its own copy of the storage, if it is shared.
+      void detach() {
+        if (!is_shared())
+          return;
+        automaton_t res = make_shared_ptr<automaton_t>(aut_->context());
+        res->copy_content(*aut_);
+        for (auto s : aut_->states())
+          if (aut_->has_name(s))
+            res->set_state_name(s, aut_->get_state_name(s));
+        res->set_name(aut_->get_name());
+        res->set_desc(aut_->get_desc());
+        aut_ = res;
+      }
+
+    private:
+      automaton_t aut_;
+    };
+
+    /// Copy-on-write handle on \a aut.
+    template <typename Aut>
+    cow_automaton<Aut>
+    make_cow_automaton(Aut aut)
+    {
+      return cow_automaton<Aut>(std::move(aut));
+    }
+  }
+}//end of ns awali::stc
+
+#endif // !AWALI_CORE_COW_AUTOMATON_HH
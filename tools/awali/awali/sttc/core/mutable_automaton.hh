@@ -29,6 +29,7 @@
 #include <awali/sttc/ctx/context.hh>
 #include <awali/sttc/ctx/traits.hh>
 #include <awali/sttc/misc/memory.hh>
+#include <awali/sttc/misc/arena_vector.hh>
 #include <awali/sttc/misc/cont_filter.hh>
 #include <awali/sttc/history/no_history.hh>
 #include <awali/sttc/history/string_history.hh>
@@ -37,20 +38,66 @@ namespace awali {
   namespace sttc {
     
     namespace internal {
-      template <typename Context>
+      /// Storage of the adjacency lists of the states of a mutable
+      /// automaton: one std::vector per list.
+      struct vector_storage
+      {
+        using container_t = std::vector<transition_t>;
+        struct arena_t {};
+
+        static std::unique_ptr<arena_t> make_arena()
+        {
+          return nullptr;
+        }
+
+        static container_t make(arena_t*)
+        {
+          return {};
+        }
+      };
+
+      /// Storage of the adjacency lists of the states of a mutable
+      /// automaton in an arena owned by the automaton: up to \p N
+      /// transitions per list are stored inline, and the arena is freed
+      /// at once with the automaton.
+      template <unsigned N = 2>
+      struct arena_storage
+      {
+        using container_t = arena_vector<transition_t, N>;
+        using arena_t = typename container_t::arena_t;
+
+        static std::unique_ptr<arena_t> make_arena()
+        {
+          return std::unique_ptr<arena_t>(new arena_t);
+        }
+
+        static container_t make(arena_t* a)
+        {
+          return container_t(a);
+        }
+      };
+
+      template <typename Context, typename Storage = vector_storage>
       class mutable_automaton_impl;
     }
     template <typename Context>
     using mutable_automaton
     = std::shared_ptr<internal::mutable_automaton_impl<Context>>;
+
+    /// Mutable automaton whose adjacency lists are stored in an arena.
+    template <typename Context>
+    using arena_automaton
+    = std::shared_ptr<internal::mutable_automaton_impl<Context,
+                                                       internal::arena_storage<>>>;
     
     namespace internal
     {
-      template <typename Context>
+      template <typename Context, typename Storage>
       class mutable_automaton_impl
       {
       public:
         using context_t = Context;
+        using storage_t = Storage;
         /// The (shared pointer) type to use it we have to create an
         /// automaton of the same (underlying) type.
         using automaton_nocv_t = mutable_automaton<context_t>;
@@ -76,7 +123,7 @@ namespace awali {
         using stored_transition_t = transition_tuple<state_t, label_t, weight_t>;
 
         /// All the incoming/outgoing transition handles of a state.
-        using tr_cont_t = std::vector<transition_t>;
+        using tr_cont_t = typename storage_t::container_t;
 
         /// Data stored for each state.
         struct stored_state_t
@@ -92,6 +139,9 @@ namespace awali {
         using free_store_t = std::vector<state_t>;
       private:
 
+        /// Memory of the adjacency lists; declared before states_,
+        /// which must be destroyed first.
+        std::unique_ptr<typename storage_t::arena_t> arena_;
         st_store_t states_;
         /// Free indexes in states_.
         free_store_t states_fs_;
@@ -109,11 +159,15 @@ namespace awali {
         mutable_automaton_impl(const mutable_automaton_impl&) = delete;
         mutable_automaton_impl(const context_t& ctx)
           : ctx_{ctx}
-          , states_{2}
+          , arena_(storage_t::make_arena())
           , prepost_label_(ctx.labelset()->special())
           , history_(std::make_shared<no_history>())
           , names_(std::make_shared<string_history>())
-        {}
+        {
+          // pre() and post().
+          new_state_();
+          new_state_();
+        }
 
         mutable_automaton_impl(mutable_automaton_impl&& that)
           : ctx_(that.ctx_)
@@ -125,6 +179,7 @@ namespace awali {
           if (this != &that) {
             ctx_ = std::move(that.ctx_);
             prepost_label_ = std::move(that.prepost_label_);
+            std::swap(arena_, that.arena_);
             std::swap(states_, that.states_);
             std::swap(states_fs_, that.states_fs_);
             std::swap(transitions_, that.transitions_);
@@ -243,24 +298,24 @@ namespace awali {
           const auto& ls = *this->labelset();
           if (succ.size() <= pred.size()) {
             auto i =
-              std::find_if(begin(succ), end(succ),
+              std::find_if(succ.begin(), succ.end(),
                            [this,l,ls,dst] (transition_t t) -> bool {
                              const stored_transition_t& st = transitions_[t];
                              return (st.dst == dst
                                      && ls.equals(st.get_label(), l));
                            });
-            if (i != end(succ))
+            if (i != succ.end())
               return *i;
           }
           else {
             auto i =
-              std::find_if(begin(pred), end(pred),
+              std::find_if(pred.begin(), pred.end(),
                            [this,l,ls,src] (transition_t t) -> bool {
                              const stored_transition_t& st = transitions_[t];
                              return (st.src == src
                                      && ls.equals(st.get_label(), l));
                            });
-            if (i != end(pred))
+            if (i != pred.end())
               return *i;
           }
           return null_transition();
@@ -331,13 +386,20 @@ namespace awali {
           tc.clear();
         }
 
+        /// Append a new entry to states_.
+        void
+        new_state_() {
+          states_.emplace_back(stored_state_t{storage_t::make(arena_.get()),
+                                              storage_t::make(arena_.get())});
+        }
+
       public:
         state_t
         add_state() {
           state_t s;
           if (states_fs_.empty()) {
             s = states_.size();
-            states_.resize(s + 1);
+            new_state_();
           }
           else {
             s = states_fs_.back();
@@ -354,17 +416,50 @@ namespace awali {
 	  state_t s = states_.size();
 	  assert(!has_state(index));
           if (index >= s) {
-            states_.resize(index + 1);
+            while (states_.size() <= index)
+              new_state_();
 	    for(state_t t=s; t< index; t++) {
 	      states_[t].succ.emplace_back(null_transition()); // So has_state() can work.
 	      states_fs_.emplace_back(t);
 	    }
           }
+          else
+            // The index is no longer free.
+            states_fs_.erase(std::find(states_fs_.begin(), states_fs_.end(),
+                                       index));
           stored_state_t& ss = states_[index];
           // De-invalidate this state: remove the invalid transition.
           ss.succ.clear();
         }
 
+        /// Whether the state indices have no hole, i.e., whether
+        /// every index below the size of the state table is a state.
+        bool has_dense_states() const {
+          return states_fs_.empty();
+        }
+
+        /// Replace the states and transitions of this automaton by
+        /// those of \a that, preserving state and transition indices.
+        ///
+        /// The tables are copied as a whole, without any lookup.  The
+        /// context, the history and the state names of this automaton
+        /// are left unchanged; the context must include that of \a that.
+        void copy_content(const mutable_automaton_impl& that) {
+          // The adjacency lists are copied in place, so that they keep
+          // using the storage of this automaton.
+          if (that.states_.size() < states_.size())
+            states_.erase(states_.begin() + that.states_.size(), states_.end());
+          while (states_.size() < that.states_.size())
+            new_state_();
+          for (state_t s = 0; s < states_.size(); ++s) {
+            states_[s].succ = that.states_[s].succ;
+            states_[s].pred = that.states_[s].pred;
+          }
+          states_fs_ = that.states_fs_;
+          transitions_ = that.transitions_;
+          transitions_fs_ = that.transitions_fs_;
+        }
+
         history_t history() const {
           return history_;
         }
@@ -478,6 +573,64 @@ namespace awali {
           states_fs_.emplace_back(s);
         }
 
+        /// Remove every state \a s such that `!keep_state(s)`.
+        ///
+        /// Unlike repeated calls to del_state(), the adjacency lists of
+        /// the remaining states are filtered once each, hence the cost
+        /// is linear in the size of the automaton.
+        template <typename Pred>
+        void del_states(Pred keep_state) {
+          std::vector<char> erased(states_.size(), false);
+          std::vector<state_t> to_erase;
+          for (state_t s = post() + 1; s < states_.size(); ++s)
+            if (has_state(s) && !keep_state(s)) {
+              erased[s] = true;
+              to_erase.emplace_back(s);
+            }
+          if (to_erase.empty())
+            return;
+          // Remaining states which lose some transitions.
+          std::vector<char> touched(states_.size(), false);
+          std::vector<state_t> to_filter;
+          auto touch = [&](state_t s) {
+            if (!erased[s] && !touched[s]) {
+              touched[s] = true;
+              to_filter.emplace_back(s);
+            }
+          };
+          for (auto s : to_erase) {
+            stored_state_t& ss = states_[s];
+            for (auto t : ss.succ)
+              if (transitions_[t].src != null_state()) {
+                touch(transitions_[t].dst);
+                transitions_[t].src = null_state();
+                transitions_fs_.emplace_back(t);
+              }
+            for (auto t : ss.pred)
+              if (transitions_[t].src != null_state()) {
+                touch(transitions_[t].src);
+                transitions_[t].src = null_state();
+                transitions_fs_.emplace_back(t);
+              }
+            ss.succ.clear();
+            ss.pred.clear();
+            history_->remove_history(s);
+            names_->remove_history(s);
+            ss.succ.emplace_back(null_transition()); // So has_state() can work.
+            states_fs_.emplace_back(s);
+          }
+          auto dead = [this](transition_t t) {
+            return transitions_[t].src == null_state();
+          };
+          for (auto s : to_filter) {
+            stored_state_t& ss = states_[s];
+            ss.succ.erase(std::remove_if(ss.succ.begin(), ss.succ.end(), dead),
+                          ss.succ.end());
+            ss.pred.erase(std::remove_if(ss.pred.begin(), ss.pred.end(), dead),
+                          ss.pred.end());
+          }
+        }
+
         void set_initial(state_t s, weight_t w) {
           set_transition(pre(), s, prepost_label_, w);
         }
@@ -542,7 +695,7 @@ namespace awali {
           // Make a copy of the transition indexes, as the iterators are
           // invalidated by del_transition(t).
           auto ts = outin(s, d);
-          for (auto t: tr_cont_t{ts.begin(), ts.end()})
+          for (auto t: std::vector<transition_t>{ts.begin(), ts.end()})
             del_transition(t);
         }
 
@@ -932,6 +1085,13 @@ namespace awali {
     {
       return make_shared_ptr<mutable_automaton<Context>>(ctx);
     }
+
+    template <typename Context>
+    arena_automaton<Context>
+    make_arena_automaton(const Context& ctx)
+    {
+      return make_shared_ptr<arena_automaton<Context>>(ctx);
+    }
   }
 }//end of ns awali::stc
 
@@ -17,6 +17,7 @@
 #ifndef AWALI_CORE_RAT_HASH_HH
 # define AWALI_CORE_RAT_HASH_HH
 
+#include <awali/sttc/ctx/traits.hh>
 #include <awali/sttc/core/rat/visitor.hh>
 #include <awali/sttc/misc/attributes.hh>
 #include <awali/sttc/misc/cast.hh>
@@ -43,10 +44,22 @@ namespace awali {
 
 
         /// Entry point: return the hash of \a v.
+        ///
+        /// The hash of a node combines its type, its label or weight,
+        /// and the hashes of its children.  It is cached in the node,
+        /// so that a subexpression is hashed only once.
         size_t operator()(const node_t& v) {
+          size_t res = v.cached_hash();
+          if (res != 0)
+            return res;
+          size_t save = res_;
           res_ = 0;
           v.accept(*this);
-          return res_;
+          // 0 means "not computed".
+          res = res_ != 0 ? res_ : 1;
+          res_ = save;
+          v.cache_hash(res);
+          return res;
         }
 
         /// Entry point: return the hash of \a v.
@@ -96,7 +109,7 @@ namespace awali {
         template <rat::exp::type_t Type>
         void visit_weight_node(const weight_node_t<Type>& v);
 
-        size_t res_;
+        size_t res_ = 0;
       };
     } // namespace rat
   }
@@ -72,7 +72,7 @@ namespace awali {
       hash<RatExpSet>::visit_unary(const unary_t<Type>& n)
       {
         combine_type(n);
-        n.sub()->accept(*this);
+        std::hash_combine(res_, (*this)(*n.sub()));
       }
 
       template <typename RatExpSet>
@@ -83,7 +83,7 @@ namespace awali {
       {
         combine_type(n);
         std::hash_combine(res_, RatExpSet::weightset_t::hash(n.weight()));
-        n.sub()->accept(*this);
+        std::hash_combine(res_, (*this)(*n.sub()));
       }
 
       template <typename RatExpSet>
@@ -93,8 +93,8 @@ namespace awali {
       hash<RatExpSet>::visit_variadic(const variadic_t<Type>& n)
       {
         combine_type(n);
-        for (auto child : n)
-          child->accept(*this);
+        for (const auto& child : n)
+          std::hash_combine(res_, (*this)(*child));
       }
 # undef VISIT
 # undef DEFINE
@@ -0,0 +1,334 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AWALI_CORE_RAT_INTERNER_HH
+# define AWALI_CORE_RAT_INTERNER_HH
+
+# include <cassert>
+# include <cstddef>
+# include <memory>
+# include <unordered_map>
+# include <utility>
+# include <vector>
+
+#include <awali/sttc/core/rat/ratexp.hh>
+#include <awali/sttc/core/rat/hash.hh>
+
+namespace awali { namespace sttc
+{
+  namespace rat
+  {
+
+    /// Memory pool for the nodes of an interner.
+    ///
+    /// Memory is allocated by blocks, and released only when the pool
+    /// is destroyed.
+    class node_arena
+    {
+    public:
+      static constexpr std::size_t block_size = 64 * 1024;
+
+      void* allocate(std::size_t n)
+      {
+        const std::size_t align = alignof(std::max_align_t);
+        n = (n + align - 1) / align * align;
+        if (n > block_size)
+          {
+            // Large objects get their own block.
+            blocks_.emplace_back(new char[n]);
+            return blocks_.back().get();
+          }
+        if (n > left_)
+          {
+            blocks_.emplace_back(new char[block_size]);
+            current_ = blocks_.back().get();
+            left_ = block_size;
+          }
+        void* res = current_;
+        current_ += n;
+        left_ -= n;
+        return res;
+      }
+
+    private:
+      std::vector<std::unique_ptr<char[]>> blocks_;
+      char* current_ = nullptr;
+      std::size_t left_ = 0;
+    };
+
+    /// Allocator drawing from a node_arena; deallocation is a no-op.
+    ///
+    /// Every allocated object keeps the arena alive, hence the nodes
+    /// may outlive the interner that built them.
+    template <typename T>
+    struct arena_allocator
+    {
+      using value_type = T;
+
+      arena_allocator(std::shared_ptr<node_arena> arena)
+        : arena_(std::move(arena))
+      {}
+
+      template <typename U>
+      arena_allocator(const arena_allocator<U>& that)
+        : arena_(that.arena_)
+      {}
+
+      T* allocate(std::size_t n)
+      {
+        return static_cast<T*>(arena_->allocate(n * sizeof(T)));
+      }
+
+      void deallocate(T*, std::size_t)
+      {}
+
+      std::shared_ptr<node_arena> arena_;
+    };
+
+    template <typename T, typename U>
+    bool operator==(const arena_allocator<T>& a, const arena_allocator<U>& b)
+    {
+      return a.arena_ == b.arena_;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const arena_allocator<T>& a, const arena_allocator<U>& b)
+    {
+      return !(a == b);
+    }
+
+    /// Hash-consing table of the nodes of a ratexpset.
+    ///
+    /// Structurally equal expressions built through the table are the
+    /// same node: the children of an interned node are interned, so
+    /// that two nodes are equal iff they have the same type, the same
+    /// label or weight, and the same children (as pointers).  Interned
+    /// nodes carry their hash and their owner, and are allocated in an
+    /// arena.
+    ///
+    /// The owner of a node is the address of the arena of the table
+    /// rather than of the table itself: every node keeps its arena
+    /// alive, so this address cannot be reused by another table as
+    /// long as the node exists.
+    template <typename RatExpSet>
+    class interner
+    {
+    public:
+      using ratexpset_t = RatExpSet;
+      using labelset_t = typename ratexpset_t::labelset_t;
+      using weightset_t = typename ratexpset_t::weightset_t;
+      using node_t = typename ratexpset_t::node_t;
+      using value_t = typename ratexpset_t::value_t;
+      using ratexps_t = typename ratexpset_t::ratexps_t;
+      template <type_t Type>
+      using unary_t = typename ratexpset_t::template unary_t<Type>;
+      template <type_t Type>
+      using variadic_t = typename ratexpset_t::template variadic_t<Type>;
+      template <type_t Type>
+      using weight_node_t = weight_node<Type, typename ratexpset_t::label_t,
+                                        typename ratexpset_t::weight_t>;
+      using atom_t = typename ratexpset_t::atom_t;
+      using zero_t = typename ratexpset_t::zero_t;
+      using one_t = typename ratexpset_t::one_t;
+
+      interner()
+        : arena_(std::make_shared<node_arena>())
+      {}
+
+      interner(const interner&) = delete;
+
+      /// Whether \a v is a node of this table.
+      bool owns(const value_t& v) const
+      {
+        return v->owner() == arena_.get();
+      }
+
+      /// The number of nodes of this table.
+      std::size_t size() const
+      {
+        return table_.size();
+      }
+
+      /// The node of this table equal to \a v.
+      value_t intern(const value_t& v)
+      {
+        if (owns(v))
+          return v;
+        switch (v->type())
+          {
+          case type_t::zero:
+            return insert(zero_t());
+          case type_t::one:
+            return insert(one_t());
+          case type_t::atom:
+            return insert(atom_t(cast<atom_t>(v).value()));
+# define CASE(Kind, Type)                                                \
+          case type_t::Type:                                            \
+            return intern_ ## Kind<type_t::Type>(v)
+          CASE(unary, complement);
+          CASE(unary, star);
+          CASE(unary, maybe);
+          CASE(unary, plus);
+          CASE(unary, transposition);
+          CASE(variadic, sum);
+          CASE(variadic, prod);
+          CASE(variadic, ldiv);
+          CASE(variadic, conjunction);
+          CASE(variadic, shuffle);
+          CASE(weight, lweight);
+          CASE(weight, rweight);
+# undef CASE
+          }
+        assert(false);
+        return v;
+      }
+
+      /// The node of this table equal to \a probe, built if needed.
+      template <typename Node>
+      value_t insert(Node&& probe)
+      {
+        using node_type = typename std::decay<Node>::type;
+        if (!children_owned_(probe))
+          return intern(std::make_shared<node_type>(std::move(probe)));
+        size_t h = hash<ratexpset_t>()(probe);
+        auto range = table_.equal_range(h);
+        for (auto i = range.first; i != range.second; ++i)
+          if (shallow_equal_(*i->second, probe))
+            return i->second;
+        auto res = std::allocate_shared<node_type>
+          (arena_allocator<node_type>(arena_), std::move(probe));
+        res->set_owner(arena_.get());
+        res->cache_hash(h);
+        table_.emplace(h, res);
+        return res;
+      }
+
+    private:
+      template <typename Node>
+      static const Node& cast(const value_t& v)
+      {
+        return static_cast<const Node&>(*v);
+      }
+
+      template <type_t Type>
+      value_t intern_unary(const value_t& v)
+      {
+        return insert(unary_t<Type>(intern(cast<unary_t<Type>>(v).sub())));
+      }
+
+      template <type_t Type>
+      value_t intern_variadic(const value_t& v)
+      {
+        ratexps_t subs;
+        for (const auto& c : cast<variadic_t<Type>>(v))
+          subs.emplace_back(intern(c));
+        return insert(variadic_t<Type>(subs));
+      }
+
+      template <type_t Type>
+      value_t intern_weight(const value_t& v)
+      {
+        const auto& n = cast<weight_node_t<Type>>(v);
+        return insert(weight_node_t<Type>(n.weight(), intern(n.sub())));
+      }
+
+      /// Whether the children of \a n belong to this table.
+      bool children_owned_(const node_t&)
+      {
+        return true;
+      }
+
+      template <type_t Type>
+      bool children_owned_(const unary_t<Type>& n)
+      {
+        return owns(n.sub());
+      }
+
+      template <type_t Type>
+      bool children_owned_(const weight_node_t<Type>& n)
+      {
+        return owns(n.sub());
+      }
+
+      template <type_t Type>
+      bool children_owned_(const variadic_t<Type>& n)
+      {
+        for (const auto& c : n)
+          if (!owns(c))
+            return false;
+        return true;
+      }
+
+      /// Whether \a n, a node of this table, is equal to \a probe,
+      /// whose children belong to this table.
+      ///
+      /// Overloaded on the type of \a probe: only \a n, whose type is
+      /// checked first, is cast.
+      bool shallow_equal_(const node_t& n, const node_t& probe) const
+      {
+        // Constants.
+        return n.type() == probe.type();
+      }
+
+      bool shallow_equal_(const node_t& n, const atom_t& probe) const
+      {
+        return (n.type() == type_t::atom
+                && labelset_t::equals(static_cast<const atom_t&>(n).value(),
+                                      probe.value()));
+      }
+
+      template <type_t Type>
+      bool shallow_equal_(const node_t& n, const unary_t<Type>& probe) const
+      {
+        return (n.type() == Type
+                && static_cast<const unary_t<Type>&>(n).sub() == probe.sub());
+      }
+
+      template <type_t Type>
+      bool shallow_equal_(const node_t& n,
+                          const variadic_t<Type>& probe) const
+      {
+        if (n.type() != Type)
+          return false;
+        const auto& vn = static_cast<const variadic_t<Type>&>(n);
+        if (vn.size() != probe.size())
+          return false;
+        for (auto i = vn.begin(), j = probe.begin(); i != vn.end(); ++i, ++j)
+          if (*i != *j)
+            return false;
+        return true;
+      }
+
+      template <type_t Type>
+      bool shallow_equal_(const node_t& n,
+                          const weight_node_t<Type>& probe) const
+      {
+        if (n.type() != Type)
+          return false;
+        const auto& wn = static_cast<const weight_node_t<Type>&>(n);
+        return (wn.sub() == probe.sub()
+                && weightset_t::equals(wn.weight(), probe.weight()));
+      }
+
+      std::shared_ptr<node_arena> arena_;
+      /// Hash -> nodes with this hash.
+      std::unordered_multimap<size_t, value_t> table_;
+    };
+
+  } // namespace rat
+}}//end of ns awali::stc
+
+#endif // !AWALI_CORE_RAT_INTERNER_HH
@@ -17,6 +17,7 @@
 #ifndef AWALI_CORE_RAT_RATEXP_HH
 # define AWALI_CORE_RAT_RATEXP_HH
 
+# include <atomic>
 # include <vector>
 # include <string>
 
@@ -82,7 +83,45 @@ namespace awali { namespace sttc
       using ratexps_t = std::vector<value_t>;
       using const_visitor = sttc::rat::const_visitor<label_t, weight_t>;
 
+      node() = default;
+      /// The cached hash and the owner are not copied.
+      node(const node&)
+        : std::enable_shared_from_this<node_t>()
+        , exp()
+      {}
+
       virtual void accept(const_visitor &v) const = 0;
+
+      /// The structural hash of this node, or 0 if it was not
+      /// computed yet; see rat::hash.  Nodes may be shared by threads,
+      /// hence the cache is atomic; racing writers store the same value.
+      size_t cached_hash() const
+      {
+        return hash_.load(std::memory_order_relaxed);
+      }
+
+      void cache_hash(size_t h) const
+      {
+        hash_.store(h, std::memory_order_relaxed);
+      }
+
+      /// The interning table this node belongs to, if any; two nodes
+      /// of the same table are equal iff they are the same node.  See
+      /// rat::interner for why this identifier is never reused while
+      /// the node exists.
+      const void* owner() const
+      {
+        return owner_;
+      }
+
+      void set_owner(const void* o)
+      {
+        owner_ = o;
+      }
+
+    private:
+      mutable std::atomic<size_t> hash_{0};
+      const void* owner_ = nullptr;
     };
 
     /*--------.
@@ -173,6 +173,7 @@ namespace awali { namespace sttc
       -> void
     {
       weight_ = w;
+      this->cache_hash(0);
     }
 
     DEFINE(weight_node)::accept(typename node_t::const_visitor& v) const
@@ -21,6 +21,7 @@
 # include <string>
 
 #include <awali/sttc/core/rat/identities.hh>
+#include <awali/sttc/core/rat/interner.hh>
 #include <awali/sttc/core/rat/ratexp.hh>
 #include <awali/sttc/core/rat/json_visitor.hxx>
 #include <awali/sttc/ctx/context.hh>
@@ -111,8 +112,12 @@ namespace awali {
         /// Constructor.
         /// \param ctx        the generator set for the labels, and the weight set.
         /// \param identities the identities to guarantee
+        /// \param interning  whether to hash-cons the expressions built
+        ///                   by this ratexpset (and its copies), see
+        ///                   rat::interner.
         ratexpset_impl(const context_t& ctx,
-                       identities_t identities); // FIXME: make this optional again?
+                       identities_t identities, // FIXME: make this optional again?
+                       bool interning = false);
 
         /// Whether unknown letters should be added, or rejected.
         /// \param o   whether to accept unknown letters
@@ -125,6 +130,13 @@ namespace awali {
         identities_t identities() const;
         bool is_series() const;
 
+        /// Whether the expressions built by this ratexpset are interned.
+        bool is_interning() const;
+
+        /// The interned expression equal to \a v, if this ratexpset is
+        /// interning; \a v otherwise.
+        value_t intern(value_t v) const;
+
         const labelset_ptr& labelset() const;
         const weightset_ptr& weightset() const;
 
@@ -369,6 +381,9 @@ namespace awali {
 
       private:
         void require_weightset_commutativity() const;
+        /// Build a node, interned if required.
+        template <typename Node, typename... Args>
+        value_t make_(Args&&... args) const;
         bool less_than_ignoring_weight_(value_t l, value_t r) const;
         value_t remove_from_sum_series_(ratexps_t addends,
                                         typename ratexps_t::iterator i) const;
@@ -428,6 +443,8 @@ namespace awali {
       private:
         context_t ctx_;
         const identities_t identities_;
+        /// The hash-consing table, shared by the copies of this ratexpset.
+        std::shared_ptr<interner<ratexpset_impl>> interner_;
       };
     } // rat::
 
@@ -42,11 +42,26 @@ namespace awali { namespace sttc
 
   template <typename Context>
   ratexpset_impl<Context>::ratexpset_impl(const context_t& ctx,
-                                          identities_t identities)
+                                          identities_t identities,
+                                          bool interning)
     : ctx_(ctx)
     , identities_(identities)
   {
     require_weightset_commutativity();
+    if (interning)
+      interner_ = std::make_shared<interner<ratexpset_impl>>();
+  }
+
+  template <typename Context>
+  template <typename Node, typename... Args>
+  inline
+  auto
+  ratexpset_impl<Context>::make_(Args&&... args) const
+    -> value_t
+  {
+    if (interner_)
+      return interner_->insert(Node(std::forward<Args>(args)...));
+    return std::make_shared<Node>(std::forward<Args>(args)...);
   }
 
   template <typename Context>
@@ -133,6 +148,16 @@ namespace awali { namespace sttc
     return identities_ == identities_t::series;
   }
 
+  DEFINE::is_interning() const -> bool
+  {
+    return bool(interner_);
+  }
+
+  DEFINE::intern(value_t v) const -> value_t
+  {
+    return interner_ ? interner_->intern(v) : v;
+  }
+
   DEFINE::labelset() const -> const labelset_ptr&
   {
     return ctx_.labelset();
@@ -154,7 +179,7 @@ namespace awali { namespace sttc
   DEFINE::zero() const
     -> value_t
   {
-    return std::make_shared<zero_t>();
+    return make_<zero_t>();
   }
 
   DEFINE::one()
@@ -210,7 +235,7 @@ namespace awali { namespace sttc
     else if (is_series())
       res = add_nonzero_series_(l, r);
     else
-      res = std::make_shared<sum_t>(gather<type_t::sum>(l, r));
+      res = make_<sum_t>(gather<type_t::sum>(l, r));
     return res;
   }
 
@@ -235,7 +260,7 @@ namespace awali { namespace sttc
         return addends[0];
       default:
         addends.erase(i);
-        return std::make_shared<sum_t>(std::move(addends));
+        return make_<sum_t>(std::move(addends));
       };
   }
 
@@ -271,7 +296,7 @@ namespace awali { namespace sttc
     else
       copy.insert(i, r);
 
-    return std::make_shared<sum_t>(std::move(copy));
+    return make_<sum_t>(std::move(copy));
   }
 
   DEFINE::merge_sum_series_(const sum_t& addends1, value_t aa2) const
@@ -302,7 +327,8 @@ namespace awali { namespace sttc
           return add_nonzero_series_(r, l);
 
         // Neither argument is a sum.
-        auto ls = std::make_shared<sum_t>(ratexps_t{l}); // Not in normal form.
+        // Not in normal form, hence not interned.
+        auto ls = std::make_shared<sum_t>(ratexps_t{l});
         return insert_in_sum_series_(*ls, r);
       }
   }
@@ -406,14 +432,14 @@ namespace awali { namespace sttc
   DEFINE::mul_atoms_(const label_t& a, const label_t& b, std::true_type) const
     -> value_t
   {
-    return std::make_shared<atom_t>(labelset()->concat(a, b));
+    return make_<atom_t>(labelset()->concat(a, b));
   }
 
   DEFINE::mul_atoms_(const label_t& a, const label_t& b, std::false_type) const
     -> value_t
   {
-    return std::make_shared<prod_t>(values_t{std::make_shared<atom_t>(a),
-                                             std::make_shared<atom_t>(b)});
+    return make_<prod_t>(values_t{make_<atom_t>(a),
+                                  make_<atom_t>(b)});
   }
 
   DEFINE::mul_unweighted_nontrivial_products_(value_t a, value_t b) const
@@ -462,7 +488,7 @@ namespace awali { namespace sttc
   DEFINE::nontrivial_mul_expressions_(value_t l, value_t r) const
     -> value_t
   {
-    return std::make_shared<prod_t>(gather<type_t::prod>(l, r));
+    return make_<prod_t>(gather<type_t::prod>(l, r));
   }
 
   DEFINE::nontrivial_mul_series_(value_t l, value_t r) const
@@ -493,7 +519,7 @@ namespace awali { namespace sttc
                 value_t nl = unwrap_possible_lweight_(l)
                       , nr = unwrap_possible_lweight_(r);
                 return lmul(weightset()->mul(lw, rw),
-                            std::make_shared<prod_t>(gather<type_t::prod>(nl, nr)));
+                            make_<prod_t>(gather<type_t::prod>(nl, nr)));
               }
           }
       }
@@ -535,7 +561,7 @@ namespace awali { namespace sttc
       res = zero();
     // END: Trivial Identity
     else
-      res = std::make_shared<conjunction_t>(gather<type_t::conjunction>(l, r));
+      res = make_<conjunction_t>(gather<type_t::conjunction>(l, r));
     return res;
   }
 
@@ -553,7 +579,7 @@ namespace awali { namespace sttc
     else if (r->type() == type_t::zero)
       res = r;
     else
-      res = std::make_shared<ldiv_t>(ratexps_t{l, r});
+      res = make_<ldiv_t>(ratexps_t{l, r});
     return res;
   }
 
@@ -581,7 +607,7 @@ namespace awali { namespace sttc
       res = l;
     // END: Trivial Identity
     else
-      res = std::make_shared<shuffle_t>(gather<type_t::shuffle>(l, r));
+      res = make_<shuffle_t>(gather<type_t::shuffle>(l, r));
     return res;
   }
 
@@ -629,7 +655,7 @@ namespace awali { namespace sttc
         if (ls.size() == 1)
           return ls.front();
         else
-          return std::make_shared<prod_t>(ls);
+          return make_<prod_t>(ls);
       }
     else
       // Handle all the trivial identities.
@@ -645,7 +671,7 @@ namespace awali { namespace sttc
       return one();
     else
       {
-        value_t res = std::make_shared<star_t>(e);
+        value_t res = make_<star_t>(e);
         require(!is_series() || is_valid(*this, res),
                 "star argument ", e, " not starrable");
         return res;
@@ -659,7 +685,7 @@ namespace awali { namespace sttc
     // 0? = 1.
     if (e->type() == type_t::zero)
       return one();
-    value_t res = std::make_shared<maybe_t>(e);
+    value_t res = make_<maybe_t>(e);
     return res;
   }
 
@@ -672,7 +698,7 @@ namespace awali { namespace sttc
       return zero();
     else
       {
-        value_t res = std::make_shared<plus_t>(e);
+        value_t res = make_<plus_t>(e);
         require(!is_series() || is_valid(*this, res),
                 "plus argument ", e, " not starrable");
         return res;
@@ -689,7 +715,7 @@ namespace awali { namespace sttc
     else if (auto wr = std::dynamic_pointer_cast<const rweight_t>(e))
       return complement(wr->sub());
     else
-      return std::make_shared<complement_t>(e);
+      return make_<complement_t>(e);
   }
 
   DEFINE::transposition(value_t e) const
@@ -708,7 +734,7 @@ namespace awali { namespace sttc
       res = atom(labelset()->transpose(l->value()));
     // END: Trivial Identity
     else
-      res = std::make_shared<transposition_t>(e);
+      res = make_<transposition_t>(e);
     return res;
   }
 
@@ -738,7 +764,7 @@ namespace awali { namespace sttc
   DEFINE::nontrivial_lmul_expression_(const weight_t& w, value_t s) const
     -> value_t
   {
-    return std::make_shared<lweight_t>(w, s);
+    return make_<lweight_t>(w, s);
   }
 
   DEFINE::nontrivial_lmul_series_(const weight_t& w, value_t s) const
@@ -754,7 +780,7 @@ namespace awali { namespace sttc
         ratexps_t addends;
         for (auto& a: *ss)
           addends.emplace_back(lmul(w, a));
-        return std::make_shared<sum_t>(std::move(addends));
+        return make_<sum_t>(std::move(addends));
       }
   }
 
@@ -786,7 +812,7 @@ namespace awali { namespace sttc
   DEFINE::nontrivial_rmul_expression_(value_t e, const weight_t& w) const
     -> value_t
   {
-    return std::make_shared<rweight_t>(w, e);
+    return make_<rweight_t>(w, e);
   }
 
   DEFINE::nontrivial_rmul_series_(value_t s, const weight_t& w) const
@@ -853,6 +879,12 @@ namespace awali { namespace sttc
   {
     if(lhs.get()==rhs.get())
       return true;
+    // Interned nodes are equal iff they are the same.
+    if (lhs->owner() && lhs->owner() == rhs->owner())
+      return false;
+    if (lhs->cached_hash() && rhs->cached_hash()
+        && lhs->cached_hash() != rhs->cached_hash())
+      return false;
     rat::equal_visit<ratexpset_impl> eq;
     return eq(rhs, lhs);
   }
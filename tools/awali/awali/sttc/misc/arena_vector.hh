@@ -0,0 +1,258 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AWALI_MISC_ARENA_VECTOR_HH
+# define AWALI_MISC_ARENA_VECTOR_HH
+
+# include <algorithm>
+# include <cstddef>
+# include <cstring>
+# include <memory>
+# include <type_traits>
+# include <vector>
+
+namespace awali {
+  namespace sttc {
+    namespace internal {
+
+      /** Allocator of blocks of values of type \p T, carved in large chunks.
+       *
+       * The capacities of the blocks are powers of two; a released block
+       * is kept in a free list and reused by the next request of the same
+       * capacity.  The memory is given back to the system only when the
+       * arena is destroyed, in one deallocation per chunk.
+       *
+       * @tparam T a trivially copyable type
+       */
+      template <typename T>
+      class arena
+      {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "arena: the values must be trivially copyable");
+
+        /// Number of values in a chunk.
+        static constexpr size_t chunk_size = 1 << 14;
+        /// Number of capacity classes; class k has capacity 2^k.
+        static constexpr unsigned num_classes = 32;
+
+        std::vector<std::unique_ptr<T[]>> chunks_;
+        T* next_ = nullptr;
+        size_t left_ = 0;
+        /// Heads of the lists of released blocks; the next block of a
+        /// list is stored at the beginning of each block.
+        T* free_[num_classes] = {};
+
+        static unsigned class_of(unsigned capacity)
+        {
+          unsigned k = 0;
+          while ((1u << k) < capacity)
+            ++k;
+          return k;
+        }
+
+      public:
+        arena() = default;
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+
+        /// A block of \p capacity values; \p capacity is a power of two
+        /// and the block may hold a pointer.
+        T* allocate(unsigned capacity)
+        {
+          T*& head = free_[class_of(capacity)];
+          if (head != nullptr) {
+            T* res = head;
+            std::memcpy(&head, res, sizeof(T*));
+            return res;
+          }
+          if (capacity > left_) {
+            // The end of the current chunk is lost.
+            size_t n = capacity < chunk_size ? chunk_size : capacity;
+            chunks_.emplace_back(new T[n]);
+            next_ = chunks_.back().get();
+            left_ = n;
+          }
+          T* res = next_;
+          next_ += capacity;
+          left_ -= capacity;
+          return res;
+        }
+
+        void release(T* block, unsigned capacity)
+        {
+          T*& head = free_[class_of(capacity)];
+          std::memcpy(block, &head, sizeof(T*));
+          head = block;
+        }
+      };
+
+      /** Vector of values of type \p T whose storage is taken from an arena.
+       *
+       * The interface is the subset of the interface of std::vector used
+       * for the adjacency lists of mutable automata.  Up to \p N values
+       * are stored inside the object itself; beyond, the values are
+       * stored in a block of the arena, whose capacity doubles when it
+       * is full.  The destructor is trivial: the blocks are freed with
+       * the arena.
+       *
+       * The vectors cannot be copy-constructed, since the arena of the
+       * copy would be ambiguous; copy-assignment copies the values into
+       * the storage of the target.
+       *
+       * @tparam T a trivially copyable type
+       * @tparam N the number of values stored inline
+       */
+      template <typename T, unsigned N = 2>
+      class arena_vector
+      {
+        static_assert(N > 0 && (N & (N - 1)) == 0,
+                      "arena_vector: N must be a power of two");
+        static constexpr unsigned min_block
+          = (sizeof(T*) + sizeof(T) - 1) / sizeof(T);
+
+      public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using arena_t = arena<T>;
+
+        explicit arena_vector(arena_t* a)
+          : arena_(a)
+        {}
+
+        arena_vector(const arena_vector&) = delete;
+
+        arena_vector(arena_vector&& that) noexcept
+        {
+          steal_(that);
+        }
+
+        arena_vector& operator=(arena_vector&& that) noexcept
+        {
+          if (this != &that) {
+            if (!is_inline_())
+              arena_->release(heap_, capacity_);
+            steal_(that);
+          }
+          return *this;
+        }
+
+        arena_vector& operator=(const arena_vector& that)
+        {
+          if (this != &that) {
+            clear();
+            reserve_(that.size_);
+            std::copy(that.begin(), that.end(), data_());
+            size_ = that.size_;
+          }
+          return *this;
+        }
+
+        size_type size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        iterator begin() { return data_(); }
+        iterator end() { return data_() + size_; }
+        const_iterator begin() const { return data_(); }
+        const_iterator end() const { return data_() + size_; }
+
+        T& operator[](size_type i) { return data_()[i]; }
+        const T& operator[](size_type i) const { return data_()[i]; }
+        T& front() { return data_()[0]; }
+        const T& front() const { return data_()[0]; }
+        T& back() { return data_()[size_ - 1]; }
+        const T& back() const { return data_()[size_ - 1]; }
+
+        void push_back(const T& v)
+        {
+          if (size_ == capacity_)
+            reserve_(size_ + 1);
+          data_()[size_++] = v;
+        }
+
+        template <typename... Args>
+        void emplace_back(Args&&... args)
+        {
+          push_back(T(std::forward<Args>(args)...));
+        }
+
+        void pop_back() { --size_; }
+
+        /// Like std::vector, keeps the capacity.
+        void clear() { size_ = 0; }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+          iterator f = begin() + (first - begin());
+          iterator l = begin() + (last - begin());
+          iterator e = std::copy(l, end(), f);
+          size_ = e - begin();
+          return f;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+          return erase(pos, pos + 1);
+        }
+
+      private:
+        bool is_inline_() const { return capacity_ == N; }
+
+        T* data_() { return is_inline_() ? inline_ : heap_; }
+        const T* data_() const { return is_inline_() ? inline_ : heap_; }
+
+        void steal_(arena_vector& that)
+        {
+          arena_ = that.arena_;
+          size_ = that.size_;
+          capacity_ = that.capacity_;
+          if (that.is_inline_())
+            std::copy(that.inline_, that.inline_ + that.size_, inline_);
+          else
+            heap_ = that.heap_;
+          that.size_ = 0;
+          that.capacity_ = N;
+        }
+
+        void reserve_(size_type n)
+        {
+          if (n <= capacity_)
+            return;
+          unsigned c = capacity_ * 2 < min_block ? min_block : capacity_ * 2;
+          while (c < n)
+            c *= 2;
+          T* block = arena_->allocate(c);
+          std::copy(begin(), end(), block);
+          if (!is_inline_())
+            arena_->release(heap_, capacity_);
+          heap_ = block;
+          capacity_ = c;
+        }
+
+        arena_t* arena_;
+        unsigned size_ = 0;
+        unsigned capacity_ = N;
+        union {
+          T inline_[N];
+          T* heap_;
+        };
+      };
+    }
+  }
+}//end of ns awali::sttc
+
+#endif // !AWALI_MISC_ARENA_VECTOR_HH
@@ -34,16 +34,17 @@ namespace awali {
         using difference_type = int;
         using pointer = unsigned*;
         using  iterator_category = std::forward_iterator_tag ;
-        it_indice_filter(Container cont, unsigned current, unsigned end, pred_t pred) :
-          current(current), length(end), pred(pred), cont(cont) {}
+        it_indice_filter(const Container& cont, unsigned current, unsigned end, pred_t pred) :
+          current(current), length(end), pred(pred), cont(&cont) {}
 
         it_indice_filter(unsigned end) :
-          current(end), length(end) {}
+          current(end), length(end), cont(nullptr) {}
 
         unsigned current;
         unsigned length;
         pred_t pred;
-        Container cont;
+        /// Not owned: the iterator must not outlive the container.
+        const Container* cont;
 
         unsigned operator*() {
           return current;
@@ -52,7 +53,7 @@ namespace awali {
         it_indice_filter& operator++() {
           do {
             ++current;
-          } while(current!=length && !pred(cont[current]));
+          } while(current!=length && !pred((*cont)[current]));
           return *this;
         }
 
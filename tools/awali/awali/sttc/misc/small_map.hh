@@ -0,0 +1,376 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AWALI_MISC_SMALL_MAP_HH
+# define AWALI_MISC_SMALL_MAP_HH
+
+# include <algorithm>
+# include <cstddef>
+# include <initializer_list>
+# include <iterator>
+# include <functional>
+# include <new>
+# include <type_traits>
+# include <utility>
+
+#include <awali/utils/hash.hh>
+
+namespace awali {
+  namespace sttc {
+    namespace internal {
+
+      /** Associative container stored as a vector sorted by keys.
+       *
+       * The interface is the subset of the interface of std::map used
+       * on polynomials: lookup, insertion and erasure of keys, and
+       * iteration by increasing keys.  Up to \p N elements are stored
+       * inside the object itself, so small maps make no allocation.
+       *
+       * Unlike std::map, the iterators are pointers, which are
+       * invalidated by any insertion or erasure, and the keys of the
+       * elements are not const: they must not be modified.
+       *
+       * @tparam Key the type of the keys
+       * @tparam Value the type of the mapped values
+       * @tparam Compare the ordering of the keys
+       * @tparam N the number of elements stored inline
+       */
+      template <typename Key, typename Value,
+                typename Compare = std::less<Key>, unsigned N = 4>
+      class small_map
+      {
+      public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using key_compare = Compare;
+        using size_type = std::size_t;
+        using iterator = value_type*;
+        using const_iterator = const value_type*;
+
+        small_map() = default;
+
+        small_map(std::initializer_list<value_type> l)
+        {
+          for (const auto& p : l)
+            emplace(p.first, p.second);
+        }
+
+        small_map(const small_map& that)
+        {
+          reserve(that.size_);
+          std::uninitialized_copy(that.begin(), that.end(), data_);
+          size_ = that.size_;
+        }
+
+        small_map(small_map&& that)
+        {
+          steal_(that);
+        }
+
+        small_map& operator=(const small_map& that)
+        {
+          if (this != &that)
+            {
+              clear();
+              reserve(that.size_);
+              std::uninitialized_copy(that.begin(), that.end(), data_);
+              size_ = that.size_;
+            }
+          return *this;
+        }
+
+        small_map& operator=(small_map&& that)
+        {
+          if (this != &that)
+            {
+              release_();
+              steal_(that);
+            }
+          return *this;
+        }
+
+        ~small_map()
+        {
+          release_();
+        }
+
+        iterator begin() { return data_; }
+        iterator end() { return data_ + size_; }
+        const_iterator begin() const { return data_; }
+        const_iterator end() const { return data_ + size_; }
+        const_iterator cbegin() const { return data_; }
+        const_iterator cend() const { return data_ + size_; }
+
+        size_type size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        size_type capacity() const { return capacity_; }
+
+        /// Remove every element, keep the storage.
+        void clear()
+        {
+          destroy_(data_, data_ + size_);
+          size_ = 0;
+        }
+
+        /// Make room for \p n elements.
+        void reserve(size_type n)
+        {
+          if (n > capacity_)
+            grow_(n);
+        }
+
+        /// The first element whose key is not less than \p k.
+        iterator lower_bound(const Key& k)
+        {
+          return std::lower_bound(begin(), end(), k, key_less_{});
+        }
+
+        const_iterator lower_bound(const Key& k) const
+        {
+          return std::lower_bound(begin(), end(), k, key_less_{});
+        }
+
+        iterator find(const Key& k)
+        {
+          auto i = lower_bound(k);
+          return i != end() && !Compare{}(k, i->first) ? i : end();
+        }
+
+        const_iterator find(const Key& k) const
+        {
+          auto i = lower_bound(k);
+          return i != end() && !Compare{}(k, i->first) ? i : end();
+        }
+
+        size_type count(const Key& k) const
+        {
+          return find(k) != end();
+        }
+
+        /// Insert (k, v) unless \p k is already mapped.
+        template <typename K, typename V>
+        std::pair<iterator, bool> emplace(K&& k, V&& v)
+        {
+          auto i = lower_bound(k);
+          if (i != end() && !Compare{}(k, i->first))
+            return {i, false};
+          return {insert_(i, std::forward<K>(k), std::forward<V>(v)), true};
+        }
+
+        std::pair<iterator, bool> insert(const value_type& p)
+        {
+          return emplace(p.first, p.second);
+        }
+
+        /// As emplace; insertion at the end is constant time when
+        /// \p hint is end() and \p k is greater than every key.
+        template <typename K, typename V>
+        iterator emplace_hint(const_iterator hint, K&& k, V&& v)
+        {
+          if (hint == end() && (size_ == 0 || Compare{}(data_[size_ - 1].first, k)))
+            return insert_(end(), std::forward<K>(k), std::forward<V>(v));
+          return emplace(std::forward<K>(k), std::forward<V>(v)).first;
+        }
+
+        Value& operator[](const Key& k)
+        {
+          auto i = lower_bound(k);
+          if (i == end() || Compare{}(k, i->first))
+            i = insert_(i, k, Value());
+          return i->second;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+          auto i = begin() + (pos - cbegin());
+          std::move(i + 1, end(), i);
+          --size_;
+          data_[size_].~value_type();
+          return i;
+        }
+
+        size_type erase(const Key& k)
+        {
+          auto i = find(k);
+          if (i == end())
+            return 0;
+          erase(i);
+          return 1;
+        }
+
+        void swap(small_map& that)
+        {
+          small_map tmp(std::move(that));
+          that = std::move(*this);
+          *this = std::move(tmp);
+        }
+
+        friend bool operator==(const small_map& l, const small_map& r)
+        {
+          return l.size_ == r.size_ && std::equal(l.begin(), l.end(), r.begin());
+        }
+
+        friend bool operator!=(const small_map& l, const small_map& r)
+        {
+          return !(l == r);
+        }
+
+        friend bool operator<(const small_map& l, const small_map& r)
+        {
+          return std::lexicographical_compare(l.begin(), l.end(),
+                                              r.begin(), r.end());
+        }
+
+      private:
+        struct key_less_
+        {
+          bool operator()(const value_type& p, const Key& k) const
+          {
+            return Compare{}(p.first, k);
+          }
+        };
+
+        using storage_t
+          = typename std::aligned_storage<sizeof(value_type),
+                                          alignof(value_type)>::type;
+
+        value_type* inline_()
+        {
+          return reinterpret_cast<value_type*>(buffer_);
+        }
+
+        bool is_inline_() const
+        {
+          return data_ == reinterpret_cast<const value_type*>(buffer_);
+        }
+
+        static void destroy_(value_type* b, value_type* e)
+        {
+          for (; b != e; ++b)
+            b->~value_type();
+        }
+
+        /// Destroy the elements and free the heap storage.
+        void release_()
+        {
+          clear();
+          if (!is_inline_())
+            ::operator delete(data_);
+          data_ = inline_();
+          capacity_ = N;
+        }
+
+        /// Take the elements of \p that, which is left empty; *this
+        /// must be empty and inline.
+        void steal_(small_map& that)
+        {
+          if (that.is_inline_())
+            {
+              std::uninitialized_copy(std::make_move_iterator(that.begin()),
+                                      std::make_move_iterator(that.end()),
+                                      data_);
+              size_ = that.size_;
+              that.clear();
+            }
+          else
+            {
+              data_ = that.data_;
+              size_ = that.size_;
+              capacity_ = that.capacity_;
+              that.data_ = that.inline_();
+              that.size_ = 0;
+              that.capacity_ = N;
+            }
+        }
+
+        /// Move the elements to a heap storage of \p n elements.
+        void grow_(size_type n)
+        {
+          auto d = static_cast<value_type*>(::operator new(n * sizeof(value_type)));
+          std::uninitialized_copy(std::make_move_iterator(begin()),
+                                  std::make_move_iterator(end()), d);
+          destroy_(begin(), end());
+          if (!is_inline_())
+            ::operator delete(data_);
+          data_ = d;
+          capacity_ = n;
+        }
+
+        /// Insert (k, v) before \p pos, which must keep the keys sorted.
+        template <typename K, typename V>
+        iterator insert_(iterator pos, K&& k, V&& v)
+        {
+          size_type i = pos - data_;
+          // Built first: k or v may refer to an element of *this.
+          value_type p(std::forward<K>(k), std::forward<V>(v));
+          if (size_ == capacity_)
+            grow_(2 * capacity_);
+          if (i == size_)
+            new (data_ + size_) value_type(std::move(p));
+          else
+            {
+              new (data_ + size_) value_type(std::move(data_[size_ - 1]));
+              std::move_backward(data_ + i, data_ + size_ - 1, data_ + size_);
+              data_[i] = std::move(p);
+            }
+          ++size_;
+          return data_ + i;
+        }
+
+        storage_t buffer_[N];
+        value_type* data_ = inline_();
+        size_type size_ = 0;
+        size_type capacity_ = N;
+      };
+
+      template <typename Key, typename Value, typename Compare, unsigned N>
+      inline
+      bool
+      has(const small_map<Key, Value, Compare, N>& s, const Key& e)
+      {
+        return s.find(e) != std::end(s);
+      }
+    }
+  }
+}//end of ns awali::stc
+
+namespace std
+{
+
+  /*-----------------------------.
+  | hash(small_map<Key, Value>). |
+  `-----------------------------*/
+
+  template <typename Key, typename Value, typename Compare, unsigned N>
+  struct hash<awali::sttc::internal::small_map<Key, Value, Compare, N>>
+  {
+    size_t
+    operator()(const awali::sttc::internal::small_map<Key, Value, Compare, N>& m)
+      const
+    {
+      size_t res = 0;
+      for (const auto& kv: m)
+        {
+          hash_combine(res, kv.first);
+          hash_combine(res, kv.second);
+        }
+      return res;
+    }
+  };
+}
+
+#endif // !AWALI_MISC_SMALL_MAP_HH
@@ -18,9 +18,21 @@
 
 #include<awali/sttc/automaton.hh>
 #include<awali/sttc/algos/accessible.hh>
+#include<awali/sttc/algos/scc.hh>
 #include<awali/sttc/misc/raise.hh>
 
 using namespace awali::sttc;
+using awali::state_t;
+using awali::FORWARD_BACKWARD;
+
+template<typename Res>
+std::vector<std::vector<state_t>> canonical(Res res) {
+  auto& partition = res.second;
+  for (auto& c : partition)
+    std::sort(c.begin(), c.end());
+  std::sort(partition.begin(), partition.end());
+  return partition;
+}
 
 template<typename Aut>
 void test(Aut aut, bool acc, bool coacc, bool trim, bool useless, std::string name) {
@@ -71,6 +83,11 @@ int main(int argc, char **argv) {
   unsigned n_coacc = num_coaccessible_states(a);
   require(n_coacc == 4, "problem with num_coaccessible_states");
 
+  auto useful_bits_v = useful_bits(a);
+  for (unsigned i=0; i<5; ++i)
+    require(useful_bits_v[st[i]] == (useful_set.count(st[i]) == 1),
+            "useful_bits and useful_states differ");
+
   auto acc = accessible(a);
   auto coacc = coaccessible(a);
   auto tra = trim(a);
@@ -98,6 +115,38 @@ int main(int argc, char **argv) {
   *osc << "Compute trim in place" << std::endl;
   trim_here(c);
   require(c -> num_states() == 3, "Size of the trim automaton");
- 
+  require(c -> num_transitions() == tra -> num_transitions(),
+          "Transitions of the trim automaton");
+  for (auto t : c -> all_transitions())
+    require(c -> has_state(c -> src_of(t)) && c -> has_state(c -> dst_of(t)),
+            "Dangling transition after trim_here");
+
+  *osc << "Compute SCCs with every algorithm" << std::endl;
+  // Small cycles chained together, with random chords, then a long cycle
+  // which exceeds the size handled sequentially by the parallel algorithm.
+  auto g = make_automaton({'a'});
+  std::vector<state_t> gs;
+  for (unsigned i = 0; i < 20000; ++i)
+    gs.push_back(g -> add_state());
+  for (unsigned i = 0; i < 10000; ++i)
+    g -> set_transition(gs[i], gs[i % 7 == 6 ? i - 6 : i + 1], 'a');
+  for (unsigned i = 10000; i < 20000; ++i)
+    g -> set_transition(gs[i], gs[i + 1 < 20000 ? i + 1 : 10000], 'a');
+  for (unsigned i = 0; i < 3000; ++i)
+    g -> set_transition(gs[(i * 7919) % 10000], gs[(i * 104729) % 10000], 'a');
+  g -> set_transition(gs[9999], gs[10000], 'a');
+  auto expected = canonical(scc_iterative(g));
+  require(canonical(scc_recursive(g)) == expected, "Recursive Tarjan");
+  require(canonical(scc_parallel(g, 4)) == expected, "Parallel SCC");
+  require(canonical(scc_parallel(g, 1)) == expected,
+          "Forward-backward SCC on one thread");
+  require(canonical(scc(g, FORWARD_BACKWARD)) == expected,
+          "Forward-backward SCC");
+  auto cond = condensation(g, FORWARD_BACKWARD);
+  require(cond.first -> num_states() == expected.size(),
+          "Size of the condensation");
+  require(cond.second.first.at(gs[10000]) == cond.second.first.at(gs[19999]),
+          "Long cycle is a single component");
+
   return 0;
 }
@@ -36,10 +36,12 @@
 #include<awali/sttc/algos/partial_identity.hh>
 #include<awali/sttc/algos/projection.hh>
 #include<awali/sttc/algos/accessible.hh>
+#include<awali/sttc/algos/concatenate.hh>
 #include<awali/sttc/algos/factor.hh>
 #include<awali/sttc/algos/proper.hh>
 #include<awali/sttc/algos/standard.hh>
 #include<awali/sttc/algos/transpose.hh>
+#include<awali/sttc/core/cow_automaton.hh>
 
 using namespace awali::sttc;
 
@@ -130,6 +132,39 @@ int main(int argc, char **argv) {
   //copy
   *osc << "copy" << std::endl;
   compare(autb, copy(autb,false, false, true));
+  *osc << "copy (dense states)" << std::endl;
+  autb->add_state(4);
+  auto autbc = copy(autb, false, false, true);
+  compare(autb, autbc);
+  assert(autbc->num_transitions() == autb->num_transitions());
+  assert(autbc->is_initial(3) && autbc->is_final(2));
+  assert(autbc->has_transition(3,5,'a'));
+  autb->del_state(4);
+  *osc << "copy-on-write" << std::endl;
+  {
+    auto cow = make_cow_automaton(autbc);
+    assert(cow.is_shared());
+    assert(cow->num_states() == autbc->num_states());
+    cow.mut()->new_transition(2,3,'b');
+    assert(!cow.is_shared());
+    assert(cow->has_transition(2,3,'b'));
+    assert(!autbc->has_transition(2,3,'b'));
+    compare(autbc, cow.get());
+  }
+  *osc << "concatenate (copy-on-write)" << std::endl;
+  {
+    size_t n = autbc->num_transitions();
+    // A shared operand is copied...
+    auto shared = concatenate(make_cow_automaton(autbc), autbc);
+    assert(shared != autbc && autbc->num_transitions() == n);
+    // ... and an owned one is reused.
+    auto owned = copy(autbc);
+    auto raw = owned.get();
+    auto reused = concatenate(make_cow_automaton(std::move(owned)), autbc);
+    assert(reused.get() == raw);
+    assert(reused->num_states() == shared->num_states());
+    assert(reused->num_transitions() == shared->num_transitions());
+  }
   *osc << "allow_words" << std::endl;
   auto allw = allow_words(autb);
   compare(autb, allw);
@@ -173,6 +208,62 @@ int main(int argc, char **argv) {
   compare(autb, standard(autb));
   *osc << "transpose" << std::endl;
   compare(autb, transpose(autb));
+  *osc << "arena storage" << std::endl;
+  {
+    auto auta = make_arena_automaton(autb->context());
+    auto autv = make_mutable_automaton(autb->context());
+    const unsigned n = 200;
+    for (unsigned i = 0; i < n; ++i) {
+      auta->add_state();
+      autv->add_state();
+    }
+    // Lists of all sizes, so that blocks are grown and recycled.
+    for (unsigned i = 0; i < n; ++i)
+      for (unsigned j = 0; j <= i % 37; ++j) {
+        auta->new_transition(2 + i, 2 + (i * 7 + j) % n, 'a' + j % 2);
+        autv->new_transition(2 + i, 2 + (i * 7 + j) % n, 'a' + j % 2);
+      }
+    for (unsigned i = 0; i < n; i += 3) {
+      auta->del_transition(2 + i, 2 + (i * 7) % n);
+      autv->del_transition(2 + i, 2 + (i * 7) % n);
+    }
+    for (unsigned i = 1; i < n; i += 5) {
+      auta->del_state(2 + i);
+      autv->del_state(2 + i);
+    }
+    auta->set_initial(2);
+    auta->set_final(4);
+    autv->set_initial(2);
+    autv->set_final(4);
+    auto check = [&](decltype(auta) aut) {
+      assert(aut->num_states() == autv->num_states());
+      assert(aut->num_transitions() == autv->num_transitions());
+      for (auto s : autv->all_states()) {
+        assert(aut->has_state(s));
+        std::vector<awali::state_t> da, dv;
+        for (auto t : aut->all_out(s))
+          da.push_back(aut->dst_of(t));
+        for (auto t : autv->all_out(s))
+          dv.push_back(autv->dst_of(t));
+        std::sort(da.begin(), da.end());
+        std::sort(dv.begin(), dv.end());
+        assert(da == dv);
+        assert(aut->all_in(s).size() == autv->all_in(s).size());
+      }
+    };
+    check(auta);
+    compare(autv, auta);
+    auto autac = make_arena_automaton(autb->context());
+    copy_into(auta, autac, false, false, true);
+    check(autac);
+    auto autad = make_arena_automaton(autb->context());
+    autad->add_state();
+    autad->copy_content(*auta);
+    check(autad);
+    auto autae = std::move(*autad);
+    assert(autae.num_transitions() == autv->num_transitions());
+    compare(autv, copy(auta, false, false, true));
+  }
   
   return 0;
 }
@@ -58,5 +58,35 @@ int main(int argc, char **argv) {
   *osc << "Check number of broken terms" << std::endl;
   assert(terms.size() == 4);
 
+  *osc << "Expansion" << std::endl;
+  {
+    rat::expansion_visitor<decltype(ratexpset)> expand{ratexpset};
+    const auto& x = expand(e);
+    *osc << "Check constant term and derivatives" << std::endl;
+    assert(x.constant == constant_term(ratexpset, e));
+    assert(x.polynomials.size() == 2);
+    for (char l : {'a', 'b'}) {
+      // Polynomialset::equals compares the ratexps as pointers.
+      const auto d = derivation(ratexpset, e, l);
+      const auto& p = x.polynomials.at(l);
+      assert(p.size() == d.size());
+      for (auto i = p.begin(), j = d.begin(); i != p.end(); ++i, ++j)
+        assert(ratexpset.equals(i->first, j->first) && i->second == j->second);
+    }
+    assert(&expand(e) == &x);
+  }
+
+  *osc << "Interning ratexpset" << std::endl;
+  decltype(ratexpset) irs(ratexpset.context(), ratexpset.identities(), true);
+  assert(irs.is_interning() && !ratexpset.is_interning());
+  auto e1 = make_ratexp(irs, "\\e+(\\e+a)((b+aa)a)*(ab*+b+aa)");
+  auto e2 = make_ratexp(irs, "\\e+(\\e+a)((b+aa)a)*(ab*+b+aa)");
+  *osc << "Check that equal expressions are shared" << std::endl;
+  assert(e1.get() == e2.get());
+  assert(irs.intern(e).get() == e1.get());
+  assert(irs.equals(e1, e) && irs.hash(e1) == ratexpset.hash(e));
+  assert(!irs.equals(e1, make_ratexp(irs, "(\\e+a)((b+aa)a)*")));
+  assert(derived_term(irs, e1)->num_states() == 7);
+
   return 0;
 }
@@ -20,6 +20,7 @@
 #include<awali/sttc/factories/ladybird.hh>
 #include<awali/sttc/ctx/lal_char.hh>
 #include<awali/sttc/weightset/b.hh>
+#include<awali/sttc/weightset/zmin.hh>
 #include<awali/sttc/algos/determinize.hh>
 #include<awali/sttc/algos/complete.hh>
 #include<awali/sttc/algos/complement.hh>
@@ -27,6 +28,7 @@
 #include<awali/sttc/algos/product.hh>
 #include<awali/sttc/algos/is_ambiguous.hh>
 #include<awali/sttc/algos/are_equivalent.hh>
+#include<awali/sttc/algos/has_twins_property.hh>
 
 #include<awali/sttc/misc/raise.hh>
 
@@ -72,5 +74,95 @@ int main(int argc, char **argv) {
   trim_here(inter);
   require(is_empty(inter),"inter should be empty");
 
+  *osc << "Complement the NFA" << std::endl;
+  auto cn = complement_nfa(a);
+  require(is_deterministic(cn) && is_complete(cn),
+          "cn should be deterministic and complete");
+  require(are_equivalent(cn, cpt),"cn and cpt should be equivalent");
+  auto cm = complement_nfa(a, true);
+  require(are_equivalent(cm, cpt),"cm and cpt should be equivalent");
+  require(cm->num_states() == minimize(cpt)->num_states(),
+          "cm should be minimal");
+  // Every state is linked to the states of a in the subsets of its class.
+  for (auto s : cm->states())
+    require(cm->has_history(s), "cm should have a history");
+  auto from = cm->history()->get_state_set(
+                cm->dst_of(*cm->initial_transitions().begin()));
+  for (auto t : a->initial_transitions())
+    require(std::find(from.begin(), from.end(), a->dst_of(t)) != from.end(),
+            "the initial state of cm should come from the initial states of a");
+  auto cw = complement_nfa(a, true, false);
+  for (auto s : cw->states())
+    require(!cw->has_history(s), "cw should have no history");
+
+  *osc << "Arena storage" << std::endl;
+  // The algorithms which copy their input accept arena automata.
+  auto ar = make_arena_automaton(a->context());
+  copy_into(a, ar, false, false, true);
+  require(to_lal(ar)->num_transitions() == a->num_transitions(),
+          "to_lal should copy the arena automaton");
+  require(proper(ar)->num_states() == a->num_states(),
+          "proper should copy the arena automaton");
+  require(are_equivalent(ar, a),"ar and a should be equivalent");
+  require(is_empty(trim(difference(ar, a))),"ar minus a should be empty");
+  require(!is_empty(trim(difference(cn, ar))),"cn minus ar should not be empty");
+
+  *osc << "Ambiguity" << std::endl;
+  require(ambiguity_degree(d) == awali::UNAMBIGUOUS,"d should be unambiguous");
+  // a(a+b)* with two copies of (a+b)* is finitely ambiguous
+  auto f = make_mutable_automaton(make_context({'a','b'}));
+  auto f0 = f->add_state(), f1 = f->add_state(), f2 = f->add_state();
+  f->set_initial(f0);
+  f->set_final(f1);
+  f->set_final(f2);
+  f->set_transition(f0, f1, 'a');
+  f->set_transition(f0, f2, 'a');
+  for (char l : {'a','b'}) {
+    f->set_transition(f1, f1, l);
+    f->set_transition(f2, f2, l);
+  }
+  require(is_ambiguous(f),"f should be ambiguous");
+  require(ambiguity_degree(f) == awali::FINITELY_AMBIGUOUS,
+          "f should be finitely ambiguous");
+  // (a+b)*a(a+b)* is polynomially ambiguous
+  auto u = make_mutable_automaton(make_context({'a','b'}));
+  auto u0 = u->add_state(), u1 = u->add_state();
+  u->set_initial(u0);
+  u->set_final(u1);
+  for (char l : {'a','b'}) {
+    u->set_transition(u0, u0, l);
+    u->set_transition(u1, u1, l);
+  }
+  u->set_transition(u0, u1, 'a');
+  std::string word;
+  require(is_ambiguous(u, word),"u should be ambiguous");
+  require(word == "aa","the witness of u should be aa");
+  require(ambiguity_degree(u) == awali::POLYNOMIALLY_AMBIGUOUS,
+          "u should be polynomially ambiguous");
+  u->set_transition(u1, u0, 'b');
+  require(ambiguity_degree(u) == awali::EXPONENTIALLY_AMBIGUOUS,
+          "u should be exponentially ambiguous");
+
+  *osc << "Twins property" << std::endl;
+  // Two runs on a^n: with weights n and 2n
+  auto z = make_mutable_automaton(context<ctx::lal_char, zmin>({'a','b'}));
+  auto p = z->add_state(), q = z->add_state(), r = z->add_state();
+  z->set_initial(p);
+  z->set_transition(p, p, 'a', 1);
+  z->set_transition(p, q, 'a', 1);
+  z->set_transition(q, q, 'a', 1);
+  z->set_transition(q, r, 'b', 0);
+  z->set_final(r);
+  require(has_twins_property(z),"z should have the twins property");
+  auto s = z->add_state();
+  z->set_transition(p, s, 'a', 0);
+  z->set_transition(s, s, 'a', 2);
+  z->set_transition(s, r, 'b', 0);
+  twins_witness<decltype(z)> w;
+  require(!has_twins_property(z, w),"z should not have the twins property");
+  require(w.state1 != w.state2 && (w.state1 == s || w.state2 == s),
+          "the witness should involve s");
+  require(w.delay1 != w.delay2,"the witness should have two delays");
+
   return 0;
 }
@@ -18,6 +18,9 @@
 
 #include<awali/sttc/automaton.hh>
 #include<awali/sttc/misc/add_epsilon_trans.hh>
+#include<awali/sttc/algos/enumerate.hh>
+#include<awali/sttc/algos/lal_lan_conversion.hh>
+#include<awali/sttc/algos/proper.hh>
 
 using namespace awali;
 using namespace awali::sttc;
@@ -52,5 +55,18 @@ int main(int argc, char **argv) {
   a->set_final(s[3]);
   js_print(a, *osc) << std::endl;
 
+  *osc << "Epsilon removal with an epsilon cycle" << std::endl;
+  set_epsilon_trans(a, s[2], s[0]);
+  set_epsilon_trans(a, s[4], s[3]);
+  a->set_final(s[2]);
+  auto p1 = copy(a);
+  assert(boolean_proper_here(p1));
+  assert(is_proper(p1));
+  auto p2 = copy(a);
+  assert(in_situ_remover(p2));
+  assert(enumerate(to_lal(p1), 6) == enumerate(to_lal(p2), 6));
+  assert(enumerate(to_lal(proper(a)), 6) == enumerate(to_lal(p2), 6));
+  assert(enumerate(to_lal(proper(a, FORWARD)), 6) == enumerate(to_lal(p2), 6));
+
   return 0;
 }
@@ -20,6 +20,11 @@
 #include<awali/sttc/weightset/z.hh>
 #include<awali/sttc/algos/eval.hh>
 #include<awali/sttc/algos/enumerate.hh>
+#include<awali/sttc/algos/concatenate.hh>
+#include<awali/sttc/algos/is_proper.hh>
+#include<awali/sttc/algos/lal_lan_conversion.hh>
+#include<awali/sttc/algos/proper.hh>
+#include<awali/sttc/algos/star.hh>
 
 using namespace awali;
 using namespace awali::sttc;
@@ -67,6 +72,67 @@ int main(int argc, char **argv) {
   map2 = enumerate(ab, 4);
   assert (map2.size() == 16);
 
+  *osc << "Lazy enumeration" << std::endl;
+  {
+    auto it = lazy_enumerate(ab);
+    std::string w;
+    bool k;
+    for (g = 0; g < 6; ++g) {
+      assert(it.next(w, k));
+      assert(w == tab[g] && k);
+    }
+    auto lz = lazy_enumerate(b1, 3);
+    std::string v;
+    int x;
+    size_t n = 0;
+    while (lz.next(v, x)) {
+      assert(map.find(v)->second == x);
+      ++n;
+    }
+    assert(n == map.size());
+    // Two paths of weight 1 and -1 on every word of 0*: every layer is
+    // non empty, but only the word 1 has a non zero weight.
+    auto cancel = make_mutable_automaton(b1->context());
+    state_t p = cancel->add_state(), q = cancel->add_state();
+    cancel->set_initial(p);
+    cancel->set_initial(q, -1);
+    cancel->set_final(p);
+    cancel->set_final(q);
+    cancel->set_transition(p, p, '0');
+    cancel->set_transition(q, q, '0');
+    state_t r = cancel->add_state(), f = cancel->add_state();
+    cancel->set_initial(r);
+    cancel->set_transition(r, f, '1');
+    cancel->set_final(f);
+    auto lc = lazy_enumerate(cancel);
+    assert(lc.next(v, x) && v == "1" && x == 1);
+    assert(!lc.next(v, x));
+  }
+
+  *osc << "Concatenations of a1" << std::endl;
+  auto ab2 = concatenate(ab, ab);
+  auto ab3 = concatenate(ab2, ab);
+  auto abl = concatenate_all(std::vector<decltype(ab)>{ab, ab, ab});
+  assert(abl->num_states() <= ab3->num_states());
+  assert(enumerate(abl, 8) == enumerate(ab3, 8));
+  // Very ambiguous automaton: paths are merged.
+  auto ab4 = concatenate_all(std::vector<decltype(ab)>(4, ab));
+  auto ab4s = shortest(ab4, 10);
+  assert(ab4s.size() == 10);
+  assert(ab4s.begin()->first == "abababab");
+  auto ab4e = enumerate(ab4, 10);
+  g = 0;
+  for (auto & p : ab4s)
+    assert(p.first == std::next(ab4e.begin(), g++)->first);
+  auto abe = to_lan(ab);
+  auto abe2 = concatenate(abe, abe, true);
+  assert(is_proper(abe2));
+  assert(enumerate(to_lal(abe2), 6) == enumerate(ab2, 6));
+  assert(!is_proper(concatenate(abe, abe)));
+  auto abes = star(abe, true);
+  assert(is_proper(abes));
+  assert(enumerate(to_lal(abes), 6) == enumerate(star(ab), 6));
+
 
 
   return 0;
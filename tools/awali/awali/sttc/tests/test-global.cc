@@ -25,6 +25,8 @@
 #include <awali/sttc/algos/proper.hh>
 #include <awali/sttc/algos/reduce.hh>
 #include <awali/sttc/algos/aut_to_exp.hh>
+#include <awali/sttc/algos/are_equivalent.hh>
+#include <awali/sttc/misc/raise.hh>
 
 #include <awali/sttc/tests/null_stream.hxx>
 
@@ -118,6 +120,15 @@ int main(int argc, char **argv) {
   dot(d, *osc);
   *osc << std::boolalpha << "Valid: " << is_valid(d) << " Proper: " << is_proper(d) << std::endl;
 
+  *osc << "State elimination orders" << std::endl;
+  for (auto order : {MIN_INOUT_DEGREE, MIN_ID, MIN_EXP_SIZE,
+                     SCC_MIN_INOUT_DEGREE}) {
+    auto e = aut_to_exp(a, order);
+    print(get_ratexpset(a), e, *osc) << std::endl;
+    require(are_equivalent(standard(get_ratexpset(a), e), a),
+            "aut_to_exp: not equivalent with order ", order);
+  }
+
   return 0;
 }
 
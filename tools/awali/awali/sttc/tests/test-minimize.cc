@@ -21,9 +21,19 @@
 #include<awali/sttc/factories/divkbaseb.hh>
 #include<awali/sttc/algos/determinize.hh>
 #include<awali/sttc/algos/min_quotient.hh>
+#include<awali/sttc/algos/minimize_incremental.hh>
+#include<awali/sttc/algos/complete.hh>
+#include<awali/sttc/algos/are_equivalent.hh>
+#include<awali/sttc/algos/reduce.hh>
+#include<awali/sttc/weightset/z.hh>
+#include<awali/sttc/weightset/z64.hh>
+#include<awali/sttc/weightset/q64.hh>
+#include<awali/sttc/weightset/r.hh>
 
 #include<awali/sttc/misc/raise.hh>
 
+#include<set>
+
 using namespace awali;
 using namespace awali::sttc;
 
@@ -56,6 +66,150 @@ int main(int argc, char **argv) {
   test_equal("Hopcroft",dh->num_states(),size);
   m = min_quotient(transpose(d));
   test_equal("Co quotient",m->num_states(),size);
+  *osc << "Minimize incrementally" << std::endl;
+  m = minimize_incremental(a);
+  test_equal("Incremental",m->num_states(),size+1);
+  require(are_equivalent(m, a), "Incremental: not equivalent");
+
+  // All the subsets of this automaton are final and lie in cycles
+  // back to the initial state.
+  auto c = make_mutable_automaton(make_context({'a','b'}));
+  std::vector<state_t> st;
+  for (unsigned i = 0; i < 6; ++i)
+    st.emplace_back(c->add_state());
+  c->set_initial(st[0]);
+  for (unsigned i = 0; i < 5; ++i) {
+    c->set_transition(st[i], st[i+1], 'a');
+    c->set_transition(st[i], st[i+1], 'b');
+    c->set_transition(st[i], st[0], 'b');
+    c->set_final(st[i]);
+  }
+  c->set_transition(st[5], st[0], 'a');
+  c->set_final(st[5]);
+  auto dc = determinize(c, false);
+  complete_here(dc);
+  m = minimize_incremental(c);
+  test_equal("Incremental cycle",m->num_states(),
+             minimize(dc, MOORE, false)->num_states());
+  require(are_equivalent(m, c), "Incremental cycle: not equivalent");
+  {
+    sttc::internal::incremental_minimizer<decltype(c)> algo(c);
+    m = algo();
+    test_equal("Incremental cycle explored subsets", algo.num_explored(),
+               dc->num_states());
+  }
+
+  // (ab)*: the component of the initial subset has two classes, hence
+  // the last Moore minimization is run, and the history goes through it.
+  {
+    auto e = make_mutable_automaton(make_context({'a','b'}));
+    state_t e0 = e->add_state(), e1 = e->add_state();
+    e->set_initial(e0);
+    e->set_final(e0);
+    e->set_transition(e0, e1, 'a');
+    e->set_transition(e1, e0, 'b');
+    sttc::internal::incremental_minimizer<decltype(e)> algo(e, false, true);
+    m = algo();
+    test_equal("Incremental history", m->num_states(), 3);
+    std::multiset<std::vector<state_t>> origins;
+    for (auto s : m->states())
+      origins.emplace(m->history()->get_state_set(s));
+    require(origins == std::multiset<std::vector<state_t>>{{}, {e0}, {e1}},
+            "Incremental history: wrong origins");
+  }
+
+  // The words of length n: the subsets are the positions of the a's
+  // read so far, hence the determinization is a tree with 2^(n+1)-1
+  // states, while the minimal automaton has n+2 states.  The leaves
+  // all reach the same subsets, which are explored once.
+  const unsigned n = 12;
+  auto t = make_mutable_automaton(make_context({'a','b'}));
+  std::vector<state_t> ts;
+  for (unsigned i = 0; i <= n; ++i)
+    ts.emplace_back(t->add_state());
+  t->set_initial(ts[0]);
+  t->set_final(ts[n]);
+  for (unsigned i = 0; i < n; ++i) {
+    t->set_transition(ts[i], ts[i+1], 'a');
+    t->set_transition(ts[i], ts[i+1], 'b');
+    // A chain of its own for an a read at position i.
+    state_t p = t->add_state();
+    t->set_transition(ts[i], p, 'a');
+    for (unsigned j = i + 1; j < n; ++j) {
+      state_t q = t->add_state();
+      t->set_transition(p, q, 'a');
+      t->set_transition(p, q, 'b');
+      p = q;
+    }
+    t->set_final(p);
+  }
+  {
+    sttc::internal::incremental_minimizer<decltype(t)> algo(t);
+    m = algo();
+    test_equal("Incremental tree", m->num_states(), n + 2);
+    require(are_equivalent(m, t), "Incremental tree: not equivalent");
+    auto dt = determinize(t, false);
+    complete_here(dt);
+    test_equal("Incremental tree explored subsets", algo.num_explored(),
+               dt->num_states());
+  }
+
+  *osc << "Reduce" << std::endl;
+  // Two copies of the automaton which counts the a's, with weight 2^n.
+  auto w = make_mutable_automaton(make_context<z>({'a','b'}));
+  state_t ws[2];
+  for (auto& s : ws) {
+    s = w->add_state();
+    w->set_initial(s);
+    w->set_final(s);
+    w->set_transition(s, s, 'a', 2);
+    w->set_transition(s, s, 'b');
+  }
+  auto rw = reduce(w);
+  test_equal("Reduce Z", rw->num_states(), 1);
+  require(are_equivalent(rw, w), "Reduce Z: not equivalent");
+  // rw is already reduced.
+  test_equal("Reduce reduced Z", reduce(rw)->num_states(), 1);
+  w->set_transition(ws[0], ws[1], 'a', 3);
+  require(!are_equivalent(rw, w), "Reduce Z: should not be equivalent");
+  // The same over Z64 and Q64, where the weights of words overflow.
+  auto w64 = make_mutable_automaton(make_context<z64>({'a','b'}));
+  auto q64w = make_mutable_automaton(make_context<q64>({'a','b'}));
+  for (auto& s : ws) {
+    s = w64->add_state();
+    w64->set_initial(s);
+    w64->set_final(s);
+    w64->set_transition(s, s, 'a', 1ll << 40);
+    w64->set_transition(s, s, 'b');
+    s = q64w->add_state();
+    q64w->set_initial(s);
+    q64w->set_final(s);
+    q64w->set_transition(s, s, 'a', q64_t(1, 1ll << 40));
+    q64w->set_transition(s, s, 'b');
+  }
+  auto rw64 = reduce(w64);
+  test_equal("Reduce Z64", rw64->num_states(), 1);
+  require(are_equivalent(rw64, w64), "Reduce Z64: not equivalent");
+  test_equal("Reduce Q64", reduce(q64w)->num_states(), 1);
+  // A dense automaton over R, and its copy with every state doubled.
+  auto x = make_mutable_automaton(make_context<r>({'a','b'}));
+  const unsigned nx = 40;
+  std::vector<state_t> xs;
+  for (unsigned i = 0; i < 2 * nx; ++i)
+    xs.emplace_back(x->add_state());
+  for (unsigned i = 0; i < nx; ++i) {
+    x->set_initial(xs[i], 1. / (i + 1));
+    x->set_initial(xs[nx + i], 1. / (i + 1));
+    x->set_final(xs[i], (i % 3) - 1.);
+    for (unsigned j = 0; j < nx; ++j)
+      for (char l : {'a','b'})
+        if ((i * 7 + j * 3 + l) % 5 != 0) {
+          double v = ((i + 2 * j + l) % 7) / 8.;
+          x->set_transition(xs[i], xs[j], l, v);
+          x->set_transition(xs[nx + i], xs[nx + j], l, v);
+        }
+  }
+  test_equal("Reduce R", reduce(x)->num_states(), nx);
 
   /*
   m = minimal_automaton(a);
@@ -21,6 +21,8 @@
 #include <awali/sttc/ctx/lal_char.hh>
 #include <awali/sttc/ctx/law_char.hh>
 #include <awali/sttc/algos/compose.hh>
+#include <awali/sttc/algos/lazy_compose.hh>
+#include <awali/sttc/algos/is_functional.hh>
 #include <awali/sttc/algos/proper.hh>
 #include <awali/sttc/algos/lift_tdc.hh>
 #include <awali/sttc/factories/divkbaseb.hh>
@@ -33,6 +35,47 @@ using namespace awali::sttc;
 
 std::ostream * osc;
 
+// The pairs of words of the computations of a transducer with two
+// tapes of letters, whose total length is at most n; the labels of an
+// automaton with one tape are put on the second word.
+void append_letter(std::string& w, char l) {
+  if (!is_epsilon<ctx::lan_char>(l))
+    w += l;
+}
+
+void append_label(std::string&, std::string& out, char l) {
+  append_letter(out, l);
+}
+
+void append_label(std::string& in, std::string& out,
+                  const std::tuple<char, char>& l) {
+  append_letter(in, std::get<0>(l));
+  append_letter(out, std::get<1>(l));
+}
+
+template <typename Tdc>
+std::set<std::pair<std::string, std::string>>
+computations(const Tdc& tdc, unsigned n)
+{
+  std::set<std::pair<std::string, std::string>> res;
+  std::vector<std::tuple<state_t, std::string, std::string>> todo;
+  for (auto t : tdc->initial_transitions())
+    todo.emplace_back(tdc->dst_of(t), "", "");
+  while (!todo.empty()) {
+    auto c = todo.back();
+    todo.pop_back();
+    if (tdc->is_final(std::get<0>(c)))
+      res.emplace(std::get<1>(c), std::get<2>(c));
+    for (auto t : tdc->out(std::get<0>(c))) {
+      std::string in = std::get<1>(c), out = std::get<2>(c);
+      append_label(in, out, tdc->label_of(t));
+      if (in.size() + out.size() <= n)
+        todo.emplace_back(tdc->dst_of(t), in, out);
+    }
+  }
+  return res;
+}
+
 int main(int argc, char **argv) {
   if(argc==2)
     osc = &std::cout;
@@ -122,6 +165,48 @@ int main(int argc, char **argv) {
   auto comp = compose(mc,i);
   js_print(comp, *osc) << std::endl;
 
+  *osc << "--------------------------------" << std::endl;
+  *osc << "        Lazy composition" << std::endl;
+  *osc << "--------------------------------" << std::endl;
+  {
+    auto lazy = lazy_compose(mc, i);
+    assert(lazy->num_expanded() == 0);
+    auto lcomp = materialize(lazy);
+    js_print(lcomp, *osc) << std::endl;
+    assert(computations(lcomp, 8) == computations(comp, 8));
+    auto all = compose_all(std::vector<decltype(mc)>{mc, i, mc});
+    assert(computations(materialize(all), 8)
+           == computations(compose(comp, mc), 8));
+    auto aut = divkbaseb(make_context({'a','b'}),3,2);
+    assert(computations(lazy_eval_tdc(aut, all), 8)
+           == computations(eval_tdc(aut, compose(comp, mc)), 8));
+  }
+
+  *osc << "--------------------------------" << std::endl;
+  *osc << "        Functionality" << std::endl;
+  *osc << "--------------------------------" << std::endl;
+  {
+    functionality_witness w;
+    assert(!is_functional(mc, w));
+    *osc << w.input << " -> " << w.output1 << ", " << w.output2 << std::endl;
+    assert(w.output1 != w.output2);
+    assert(computations(mc, 10).count({w.input, w.output1}));
+    assert(computations(mc, 10).count({w.input, w.output2}));
+    auto f = make_transducer({'a','b'},{'x','y'});
+    state_t p = f->add_state(), q = f->add_state(), r = f->add_state();
+    f->set_initial(p);
+    f->set_final(p);
+    f->set_transition(p, p, {'a', 'x'});
+    f->set_transition(p, q, {'b', eps});
+    f->set_transition(q, p, {'a', 'y'});
+    f->set_transition(p, r, {'b', 'x'});
+    f->set_transition(r, p, {'b', eps});
+    assert(is_functional(f));
+    f->set_transition(q, p, {'b', eps});
+    assert(!is_functional(f, w));
+    *osc << w.input << " -> " << w.output1 << ", " << w.output2 << std::endl;
+  }
+
   *osc << "--------------------------------" << std::endl;
   *osc << "        Evaluation" << std::endl;
   *osc << "--------------------------------" << std::endl;
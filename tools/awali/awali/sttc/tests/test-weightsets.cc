@@ -28,6 +28,10 @@
 #include<awali/sttc/weightset/zmax.hh>
 #include<awali/sttc/weightset/pmax.hh>
 #include<awali/sttc/weightset/maxmin.hh>
+#include<awali/sttc/weightset/z64.hh>
+#include<awali/sttc/weightset/q64.hh>
+#include<awali/sttc/weightset/polynomialset.hh>
+#include<awali/sttc/automaton.hh>
 
 #include<awali/sttc/misc/raise.hh>
 #include <awali/sttc/tests/null_stream.hxx>
@@ -136,6 +140,98 @@ void test_join() {
 
 
 
+// The values of z64 and q64 go beyond 64 bits and come back.
+void test_overflow() {
+  *osc << "Test overflow" << std::endl;
+  z64 zs;
+  z64::value_t p = zs.one();
+  for (unsigned i = 0; i < 50; ++i)
+    p = zs.mul(p, 3);
+  require(format(zs, p) == "717897987691852588770249",
+          "z64: 3^50 = ", format(zs, p));
+  size_t pos = 25;
+  require(zs.equals(zs.parse("-717897987691852588770249", pos), zs.sub(0, p))
+          && pos == 0, "z64: parse");
+  for (unsigned i = 0; i < 49; ++i)
+    p = zs.rdiv(p, 3);
+  require(p.is_small() && p == 3, "z64: 3^50/3^49 = ", format(zs, p));
+  z64::value_t m = std::numeric_limits<long long>::max();
+  require(format(zs, zs.add(m, 1)) == "9223372036854775808", "z64: max+1");
+  require(zs.sub(zs.add(m, 1), 1).is_small(), "z64: max+1-1");
+  json::node_t* j = zs.value_to_json(zs.mul(m, m));
+  require(zs.equals(zs.value_from_json(j), zs.mul(m, m)), "z64: json");
+  delete j;
+
+  q64 qs;
+  q64::value_t x = qs.one(), h = qs.zero();
+  for (unsigned i = 1; i <= 60; ++i) {
+    x = qs.mul(x, q64::value_t{1, 3});
+    h = qs.add(h, x);
+  }
+  // 1/3 + ... + 1/3^60 = (1 - 1/3^60) / 2
+  require(qs.equals(h, qs.rdiv(qs.sub(qs.one(), x), q64::value_t{2})),
+          "q64: geometric sum ", format(qs, h));
+  require(qs.equals(qs.star(q64::value_t{1, 2}), q64::value_t{2}),
+          "q64: star");
+  pos = 4;
+  require(qs.equals(qs.parse("-1.5", pos), q64::value_t{-3, 2}), "q64: parse");
+  j = qs.value_to_json(h);
+  require(qs.equals(qs.value_from_json(j), h), "q64: json");
+  delete j;
+  json::object_t* o = new json::object_t();
+  o->push_back("num", new json::int_t(1));
+  o->push_back("den", new json::int_t(0));
+  bool thrown = false;
+  try { qs.value_from_json(o); }
+  catch (json::coercion_exception&) { thrown = true; }
+  require(thrown, "q64: json with a zero denominator");
+  delete o;
+}
+
+using monomials_t = std::vector<std::pair<std::string, int>>;
+
+template<typename PS>
+typename PS::value_t make_poly(const PS& ps, const monomials_t& ms) {
+  typename PS::value_t res;
+  for (const auto& m : ms)
+    ps.add_here(res, m.first, m.second);
+  return res;
+}
+
+// The flat and tree representations of polynomials must agree.
+void test_polynomials() {
+  auto ctx = get_wordset_context(make_context<z>({'a','b','c'}));
+  using ctx_t = decltype(ctx);
+  polynomialset<ctx_t> tps{ctx};
+  polynomialset<ctx_t, poly_repr::flat> fps{ctx};
+  *osc << "Test polynomials" << std::endl;
+  std::vector<monomials_t> ps
+    = {{}, {{"", 1}}, {{"a", 1}, {"ab", 2}, {"b", -1}},
+       {{"b", 3}, {"ab", 1}, {"", 1}, {"b", -3}},
+       {{"ab", -2}, {"b", 1}, {"c", 1}, {"aa", 1}, {"bb", 1}, {"cc", 1},
+        {"abc", 5}},
+       {{"a", 1}, {"b", 1}, {"c", 1}, {"ab", -1}, {"b", -1}, {"ca", 4}}};
+  for (const auto& l : ps)
+    for (const auto& r : ps) {
+      auto tl = make_poly(tps, l), tr = make_poly(tps, r);
+      auto fl = make_poly(fps, l), fr = make_poly(fps, r);
+      auto check = [&](const std::string& op,
+                       decltype(tl) t, decltype(fl) f) {
+        require(tps.format(t) == fps.format(f), "polynomials: ",
+                tps.format(tl), ' ', op, ' ', tps.format(tr), ": ",
+                tps.format(t), " != ", fps.format(f));
+      };
+      check("+", tps.add(tl, tr), fps.add(fl, fr));
+      check(".", tps.mul(tl, tr), fps.mul(fl, fr));
+      check("<-2>", tps.lmul(-2, tl), fps.lmul(-2, fl));
+      check("ba", tps.rmul_letter(tl, "ba"), fps.rmul_letter(fl, "ba"));
+      fps.add_here(fl, fr);
+      fps.add_here(fl, fps.lmul(-1, fr));
+      require(fps.equals(fl, make_poly(fps, l)), "polynomials: ",
+              tps.format(tl), " + ", tps.format(tr), " - ", tps.format(tr));
+    }
+}
+
 int main(int argc, char **argv) {
   if(argc==2)
     osc = &std::cout;
@@ -156,6 +252,8 @@ int main(int argc, char **argv) {
   test<zmax>();
   test<pmax>();
   test<maxmin>();
+  test<z64>();
+  test<q64>();
   test_join<z,n>();
   test_join<q,n>();
   test_join<q,z>();
@@ -166,7 +264,12 @@ int main(int argc, char **argv) {
   test_join<c,z>();
   test_join<c,q>();
   test_join<c,r>();
+  test_join<z64,z>();
+  test_join<q64,z64>();
+  test_join<q64,q>();
   //test_join<f2,zz<2>>(); // add this test when join is implemented
+  test_overflow();
+  test_polynomials();
   
   return 0;
 }
@@ -21,7 +21,16 @@ namespace awali {
   namespace sttc {
 
   // polynomialset.hh.
-  template <class Context>
+  /// Representations of the values of a polynomialset.
+  namespace poly_repr {
+    /// Polynomials are std::map (one node per monomial).
+    struct tree {};
+    /// Polynomials are vectors sorted by labels, with inline storage
+    /// for a few monomials (see internal::small_map).
+    struct flat {};
+  }
+
+  template <class Context, class Repr = poly_repr::tree>
   class polynomialset;
 
 }}//end of ns awali::stc
@@ -30,6 +30,7 @@
 #include <awali/sttc/misc/attributes.hh>
 #include <awali/utils/hash.hh>
 #include <awali/sttc/misc/map.hh>
+#include <awali/sttc/misc/small_map.hh>
 #include <awali/sttc/misc/raise.hh>
 #include <awali/common/enums.hh>
 #include <awali/sttc/misc/stream.hh>
@@ -64,15 +65,19 @@ namespace awali { namespace sttc {
 
   /// Linear combination of labels: map labels to weights.
   /// \tparam Context  the LabelSet and WeightSet types.
-  template <class Context>
+  /// \tparam Repr     the representation of the polynomials:
+  ///                  poly_repr::tree (std::map) or poly_repr::flat
+  ///                  (sorted vector, better for small polynomials).
+  template <class Context, class Repr>
   class polynomialset
   {
   public:
-    using self_type = polynomialset<Context>;
+    using self_type = polynomialset<Context, Repr>;
     using context_t = Context;
+    using repr_t = Repr;
     using labelset_t = labelset_t_of<context_t>;
     using weightset_t = weightset_t_of<context_t>;
-    using polynomialset_t = polynomialset<context_t>;
+    using polynomialset_t = self_type;
 
     using labelset_ptr = typename context_t::labelset_ptr;
     using weightset_ptr = typename context_t::weightset_ptr;
@@ -80,7 +85,12 @@ namespace awali { namespace sttc {
     using label_t = typename labelset_t::value_t;
     using weight_t = weight_t_of<context_t>;
 
-    using value_t = std::map<label_t, weight_t, internal::less<labelset_t>>;
+    using value_t
+      = typename std::conditional<std::is_same<repr_t, poly_repr::flat>::value,
+                                  internal::small_map<label_t, weight_t,
+                                                      internal::less<labelset_t>>,
+                                  std::map<label_t, weight_t,
+                                           internal::less<labelset_t>>>::type;
     /// A pair <label, weight>.
     using monomial_t = typename value_t::value_type;
 
@@ -129,9 +139,7 @@ namespace awali { namespace sttc {
     value_t&
     add_here(value_t& v, const value_t& p) const
     {
-      for (const auto& m: p)
-        add_here(v, m);
-      return v;
+      return add_here_(v, p, repr_t{});
     }
 
     /// v += m.
@@ -182,8 +190,7 @@ namespace awali { namespace sttc {
     add(const value_t& l, const value_t& r) const
     {
       value_t res = l;
-      for (auto& i : r)
-        add_here(res, i.first, i.second);
+      add_here(res, r);
       return res;
     }
 
@@ -191,13 +198,13 @@ namespace awali { namespace sttc {
     value_t
     mul(const value_t& l, const value_t& r) const
     {
-      value_t res;
-      for (auto i: l)
-        for (auto j: r)
-          add_here(res,
-                     labelset()->concat(i.first, j.first),
-                     weightset()->mul(i.second, j.second));
-      return res;
+      monomials_t ms;
+      ms.reserve(l.size() * r.size());
+      for (const auto& i: l)
+        for (const auto& j: r)
+          ms.emplace_back(labelset()->concat(i.first, j.first),
+                          weightset()->mul(i.second, j.second));
+      return sum_(ms);
     }
 
     /// The conjunction of polynomials \a l and \a r.
@@ -205,13 +212,13 @@ namespace awali { namespace sttc {
     value_t
     conjunction(const value_t& l, const value_t& r) const
     {
-      value_t res;
-      for (auto i: l)
-        for (auto j: r)
-          add_here(res,
-                     labelset()->conjunction(i.first, j.first),
-                     weightset()->mul(i.second, j.second));
-      return res;
+      monomials_t ms;
+      ms.reserve(l.size() * r.size());
+      for (const auto& i: l)
+        for (const auto& j: r)
+          ms.emplace_back(labelset()->conjunction(i.first, j.first),
+                          weightset()->mul(i.second, j.second));
+      return sum_(ms);
     }
 
     /// The star of polynomial \a v.
@@ -265,8 +272,13 @@ namespace awali { namespace sttc {
       value_t res;
       if (!weightset()->is_zero(w))
         // FIXME: What if there are divisors of 0?
+        // The labels are unchanged, hence in order.
         for (const auto& m: v)
-          add_here(res, m.first, weightset()->mul(w, m.second));
+          {
+            auto k = weightset()->mul(w, m.second);
+            if (!weightset()->is_zero(k))
+              res.emplace_hint(res.end(), m.first, k);
+          }
       return res;
     }
 
@@ -274,13 +286,14 @@ namespace awali { namespace sttc {
     value_t
     lmul_letter(const label_t& lhs, const value_t& v) const
     {
-      value_t res;
-      for (auto i: v)
-        add_here(res,
+      monomials_t ms;
+      ms.reserve(v.size());
+      for (const auto& i: v)
+        ms.emplace_back(
                    // FIXME: This is wrong, it should be mul, not concat.
                    labelset()->concat(lhs, i.first),
                    i.second);
-      return res;
+      return sum_(ms);
     }
 
     /// Right exterior product.
@@ -290,7 +303,11 @@ namespace awali { namespace sttc {
       value_t res;
       if (!weightset()->is_zero(w))
         for (const auto& m: v)
-          add_here(res, m.first, weightset()->mul(m.second, w));
+          {
+            auto k = weightset()->mul(m.second, w);
+            if (!weightset()->is_zero(k))
+              res.emplace_hint(res.end(), m.first, k);
+          }
       return res;
     }
 
@@ -298,12 +315,11 @@ namespace awali { namespace sttc {
     value_t
     rmul_letter(const value_t& v, const label_t& rhs) const
     {
-      value_t res;
-      for (auto i: v)
-        add_here(res,
-                   labelset()->concat(i.first, rhs),
-                   i.second);
-      return res;
+      monomials_t ms;
+      ms.reserve(v.size());
+      for (const auto& i: v)
+        ms.emplace_back(labelset()->concat(i.first, rhs), i.second);
+      return sum_(ms);
     }
 
     static value_t
@@ -418,10 +434,10 @@ namespace awali { namespace sttc {
     }
 
     /// Convert from another polynomialset to type_t.
-    template <typename C>
+    template <typename C, typename R>
     value_t
-    conv(const polynomialset<C>& sps,
-         const typename polynomialset<C>::value_t& v) const
+    conv(const polynomialset<C, R>& sps,
+         const typename polynomialset<C, R>::value_t& v) const
     {
       value_t res;
       typename C::labelset_t sls = * sps.labelset();
@@ -798,6 +814,86 @@ namespace awali { namespace sttc {
 
 
   private:
+    /// Monomials in any order, possibly with several monomials
+    /// for the same label.
+    using monomials_t = std::vector<std::pair<label_t, weight_t>>;
+
+    /// The sum of the monomials \a ms, which are sorted in place.
+    ///
+    /// The weights of a label are added in the order of \a ms, as
+    /// successive calls to add_here would do.
+    value_t
+    sum_(monomials_t& ms) const
+    {
+      std::stable_sort(ms.begin(), ms.end(),
+                       [](const std::pair<label_t, weight_t>& l,
+                          const std::pair<label_t, weight_t>& r)
+                       {
+                         return labelset_t::less_than(l.first, r.first);
+                       });
+      value_t res;
+      for (auto i = ms.begin(); i != ms.end(); )
+        {
+          auto w = i->second;
+          auto j = std::next(i);
+          for (; j != ms.end() && !labelset_t::less_than(i->first, j->first);
+               ++j)
+            w = weightset()->add(w, j->second);
+          if (!label_is_zero(*labelset(), &i->first)
+              && !weightset()->is_zero(w))
+            res.emplace_hint(res.end(), std::move(i->first), w);
+          i = j;
+        }
+      return res;
+    }
+
+    /// v += p, monomial by monomial.
+    value_t&
+    add_here_(value_t& v, const value_t& p, poly_repr::tree) const
+    {
+      for (const auto& m: p)
+        add_here(v, m);
+      return v;
+    }
+
+    /// v += p, by merging the sorted vectors.
+    value_t&
+    add_here_(value_t& v, const value_t& p, poly_repr::flat) const
+    {
+      if (p.empty())
+        return v;
+      if (v.empty())
+        return v = p;
+      value_t res;
+      res.reserve(v.size() + p.size());
+      auto i = v.begin();
+      auto j = p.begin();
+      while (i != v.end() && j != p.end())
+        if (labelset_t::less_than(i->first, j->first))
+          {
+            res.emplace_hint(res.end(), std::move(i->first), i->second);
+            ++i;
+          }
+        else if (labelset_t::less_than(j->first, i->first))
+          {
+            res.emplace_hint(res.end(), j->first, j->second);
+            ++j;
+          }
+        else
+          {
+            auto w = weightset()->add(i->second, j->second);
+            if (!weightset()->is_zero(w))
+              res.emplace_hint(res.end(), std::move(i->first), w);
+            ++i;
+            ++j;
+          }
+      for (; i != v.end(); ++i)
+        res.emplace_hint(res.end(), std::move(i->first), i->second);
+      for (; j != p.end(); ++j)
+        res.emplace_hint(res.end(), j->first, j->second);
+      return v = std::move(res);
+    }
+
     context_t ctx_;
 
     /// Left marker for weight in concrete syntax.
@@ -826,37 +922,37 @@ namespace awali { namespace sttc {
   }
 
   // FIXME: this works perfectly well, but I'd like a two-parameter version.
-  template <typename PLS1, typename PWS1,
-            typename PLS2, typename PWS2>
+  template <typename PLS1, typename PWS1, typename R1,
+            typename PLS2, typename PWS2, typename R2>
   inline
   auto
-  join(const polynomialset<context<PLS1, PWS1>>& p1,
-       const polynomialset<context<PLS2, PWS2>>& p2)
+  join(const polynomialset<context<PLS1, PWS1>, R1>& p1,
+       const polynomialset<context<PLS2, PWS2>, R2>& p2)
     -> polynomialset<context<join_t<PLS1, PLS2>,
-                             join_t<PWS1, PWS2>>>
+                             join_t<PWS1, PWS2>>, R1>
   {
     return {join(p1.context(), p2.context())};
   }
 
   template <typename WS1,
-            typename PLS2, typename PWS2>
+            typename PLS2, typename PWS2, typename R2>
   inline
   auto
   join(const WS1& w1,
-       const polynomialset<context<PLS2, PWS2>>& p2)
-    -> polynomialset<context<PLS2, join_t<WS1, PWS2>>>
+       const polynomialset<context<PLS2, PWS2>, R2>& p2)
+    -> polynomialset<context<PLS2, join_t<WS1, PWS2>>, R2>
   {
     using ctx_t = context<PLS2, join_t<WS1, PWS2>>;
     return ctx_t{* p2.labelset(), join(w1, * p2.weightset())};
   }
 
-  template <typename PLS1, typename PWS1,
+  template <typename PLS1, typename PWS1, typename R1,
             typename WS2>
   inline
   auto
-  join(const polynomialset<context<PLS1, PWS1>>& p1,
+  join(const polynomialset<context<PLS1, PWS1>, R1>& p1,
        const WS2& w2)
-    -> polynomialset<context<PLS1, join_t<PWS1, WS2>>>
+    -> polynomialset<context<PLS1, join_t<PWS1, WS2>>, R1>
   {
     return join(w2, p1);
   }
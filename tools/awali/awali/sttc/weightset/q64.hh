@@ -0,0 +1,433 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AWALI_WEIGHTSET_Q64_HH
+#define AWALI_WEIGHTSET_Q64_HH
+
+#include <string>
+#include <ostream>
+
+#include <awali/common/bigfraction.hh>
+#include <awali/common/enums.hh>
+
+#include <awali/utils/hash.hh>
+
+#include <awali/sttc/misc/raise.hh>
+#include <awali/sttc/misc/stream.hh> // eat
+#include <awali/sttc/weightset/q.hh>
+#include <awali/sttc/weightset/z64.hh>
+#include <awali/sttc/weightset/lr_parse_number.hh>
+
+namespace awali {
+  namespace sttc {
+    /**The semiring of rational numbers, without overflow.
+     *
+     * The values are q64_t, whose numerators and denominators are z64_t.
+     */
+      class q64 {
+      public:
+        using self_type = q64;
+
+        static std::string sname()
+        {
+          return "q64";
+        }
+
+        std::string vname(bool = true) const
+        {
+          return sname();
+        }
+
+        /// Build from the description in \a is.
+        static q64 make(std::istream& is)
+        {
+          eat(is, sname());
+          return {};
+        }
+
+        using value_t = q64_t;
+
+        static value_t zero()
+        {
+          return value_t{0, 1};
+        }
+
+        static value_t one()
+        {
+          return value_t{1, 1};
+        }
+
+        static value_t add(const value_t& l, const value_t& r)
+        {
+          return l + r;
+        }
+
+        static value_t sub(const value_t& l, const value_t& r)
+        {
+          return l - r;
+        }
+
+        static value_t mul(const value_t& l, const value_t& r)
+        {
+          return l * r;
+        }
+
+        static value_t
+        rdiv(const value_t& l, const value_t& r)
+        {
+          require(!is_zero(r), "div: division by zero");
+          return l / r;
+        }
+
+        static value_t
+        ldiv(const value_t& l, const value_t& r)
+        {
+          return rdiv(r, l);
+        }
+
+        value_t star(const value_t& v) const
+        {
+          if (-v.den < v.num && v.num < v.den)
+            // No need to reduce: numerator and denominators are primes.
+            return {v.den, v.den - v.num};
+          else
+            raise(sname(), ": star: invalid value: ", format(*this, v));
+        }
+
+        value_t plus(const value_t& v) const
+        {
+          if (-v.den < v.num && v.num < v.den)
+            // No need to reduce: numerator and denominators are primes.
+            return {v.num, v.den - v.num};
+          else
+            raise(sname(), ": star: invalid value: ", format(*this, v));
+        }
+
+        static bool is_special(const value_t&)
+        {
+          return false;
+        }
+
+        static bool is_zero(const value_t& v)
+        {
+          return v.num == 0;
+        }
+
+        static bool is_one(const value_t& v)
+        {
+          // All values are normalized.
+          return v.num == 1 && v.den == 1;
+        }
+
+        static bool equals(const value_t& l, const value_t& r)
+        {
+          return l == r;
+        }
+
+        /// Whether \a lhs < \a rhs.
+        static bool less_than(const value_t& lhs, const value_t& rhs)
+        {
+          return lhs < rhs;
+        }
+
+        static constexpr bool is_commutative_semiring() { return true; }
+
+        static constexpr bool show_one() { return false; }
+        static constexpr star_status_t star_status() { return star_status_t::ABSVAL; }
+
+        static value_t
+        abs(const value_t& v)
+        {
+          return v.num.is_negative() ? (value_t{-v.num, v.den}) : v;
+        }
+
+        static value_t
+        transpose(const value_t& v)
+        {
+          return v;
+        }
+
+        static size_t hash(const value_t& v)
+        {
+          return std::hash<value_t>()(v);
+        }
+
+        static value_t
+        conv(self_type, const value_t& v)
+        {
+          return v;
+        }
+
+        static value_t
+        conv(q, q::value_t v)
+        {
+          return {v.num, (long long) v.den};
+        }
+
+        static value_t
+        conv(z64, const z64::value_t& v)
+        {
+          return {v, 1};
+        }
+
+        static value_t
+        conv(z, z::value_t v)
+        {
+          return {v, 1};
+        }
+
+        static value_t
+        conv(n, n::value_t v)
+        {
+          return {(long long) v, 1};
+        }
+
+        static value_t
+        conv(b, b::value_t v)
+        {
+          return {v, 1};
+        }
+
+        static value_t
+        conv(std::istream& i)
+        {
+          z64_t num;
+          if (! (i >> num))
+            fail_reading(i, sname() + ": invalid numerator");
+
+          // If we have a slash after the numerator then we have a
+          // denominator as well.
+          if (i.peek() != '/')
+            return value_t{num, 1};
+          eat(i, '/');
+
+          z64_t den;
+          if (i >> den)
+            {
+              // Make sure our rational respects our constraints.
+              if (den == 0)
+                throw std::domain_error(sname() + ": zero denominator");
+              return value_t{num, den}.reduce();
+            }
+          else
+            fail_reading(i, sname() + ": invalid denominator");
+        }
+
+        /// Reads `<int>/<uint>`, `<int>.<uint>` or `<int>` left of \a p.
+        static value_t
+        parse(const std::string & s, size_t& p) {
+          size_t i = p;
+          if (!internal::lr_scan_digits(s, i))
+            throw parse_exception("Could not parse a q64 value right of "
+                                  "position " + std::to_string(p)
+                                  + " in string \"" + s + "\".");
+          std::string digits = s.substr(i, p - i);
+          size_t j = i;
+          if (internal::lr_scan_one(s, j, "/")
+              && internal::lr_scan_int(s, j)) {
+            z64_t den = z64_t::from_string(digits);
+            if (den == 0)
+              throw parse_exception(sname() + ": zero denominator in \""
+                                    + s + "\".");
+            p = j;
+            return value_t{z64_t::from_string(s.substr(j, i - 1 - j)),
+                           den}.reduce();
+          }
+          j = i;
+          if (internal::lr_scan_dot(s, j)
+              && internal::lr_scan_int(s, j)) {
+            // Decimal notation: the fractional part is read as an
+            // integer and scaled.
+            z64_t den = 1;
+            for (size_t k = 0; k < digits.size(); ++k)
+              den *= 10;
+            std::string ip = s.substr(j, i - 1 - j);
+            z64_t v = z64_t::from_string(ip + digits);
+            p = j;
+            return value_t{v, den}.reduce();
+          }
+          internal::lr_scan_sign(s, i);
+          value_t res{z64_t::from_string(s.substr(i, p - i)), 1};
+          p = i;
+          return res;
+        }
+
+        static std::ostream&
+        print(const value_t& v, std::ostream& o,
+              const std::string& format = "text")
+        {
+          if (format == "json") {
+            if(v.den == 1)
+              return o << v.num;
+            o<< "{\"num\":" << v.num << ", \"den\":" << v.den << '}';
+            return o;
+          }
+          if (format == "latex")
+            {
+              if (v.den == 1)
+                o << v.num;
+              else
+                o << "\\frac{" << v.num << "}{" << v.den << '}';
+            }
+          else
+            {
+              o << v.num;
+              if (v.den != 1)
+                o << '/' << v.den;
+            }
+          return o;
+        }
+
+        std::ostream&
+        print_set(std::ostream& o, const std::string& format = "text") const
+        {
+          if (format == "latex")
+            o << "\\mathbb{Q}";
+          else if (format == "text")
+            o << "Q64";
+          else
+            raise("invalid format: ", format);
+          return o;
+        }
+
+    template<unsigned version = version::fsm_json>
+    json::object_t*
+    to_json() const
+    {
+      version::check_fsmjson<version>();
+      switch (version) {
+        case 0: /* Never occurs due to above check. */
+        case 1:
+        default:
+          return new json::object_t("semiring", new json::string_t("Q64"));
+      }
+    }
+
+    /// As for Q; the integers which do not fit in an int are strings.
+    template<unsigned version = version::fsm_json>
+    json::node_t* value_to_json(const value_t& v)
+    const
+    {
+      version::check_fsmjson<version>();
+      switch (version) {
+        case 0: /* Never occurs due to above check. */
+        case 1:
+        default:
+        z64 zs;
+        if(v.den == 1)
+          return zs.value_to_json<version>(v.num);
+        json::object_t* l = new json::object_t();
+        l->push_back("num", zs.value_to_json<version>(v.num));
+        l->push_back("den", zs.value_to_json<version>(v.den));
+        return l;
+      }
+    }
+
+    template<unsigned version = version::fsm_json>
+    value_t value_from_json(json::node_t const* p)
+    const
+    {
+      version::check_fsmjson<version>();
+      switch (version) {
+        case 0: /* Never occurs due to above check. */
+        case 1:
+        default:
+          z64 zs;
+          switch(p->kind) {
+            case json::FLOATING:
+              throw json::coercion_exception(
+                "[Q64] value_from_json: node is of kind FLOATING and we do "
+                "not support double to q64 conversion");
+            case json::BOOLEAN:
+            case json::INTEGER:
+              return value_t{p->to_int(), 1};
+            case json::STRING: {
+              std::stringstream ss(p->string()->value);
+              value_t v = conv(ss);
+              if (ss.eof())
+                return v;
+              throw json::coercion_exception(
+                "[Q64] value_from_json: node is of kind STRING and is not a "
+                "proper rational representation.");
+            }
+            case json::ARRAY :{
+              if (p->arity()!=2)
+                throw json::coercion_exception(
+                  "[Q64] value_from_json: node is of kind ARRAY and needs to "
+                  " have two children to be interpreted as a rational.");
+              return from_json_(zs.value_from_json<version>(p->at(0)),
+                                zs.value_from_json<version>(p->at(1)), p);
+            }
+            case json::OBJECT :{
+                if(!p->has_child("num")) {
+                  throw json::coercion_exception(
+                    "[Q64] value_from_json: node is of kind OBJECT and needs "
+                    "to have a \"num\" field to be interpreted as a "
+                    "rational.");
+                }
+                z64_t n = zs.value_from_json<version>(p->at("num"));
+                if (p->has_child("den"))
+                  return from_json_(n,
+                                    zs.value_from_json<version>(p->at("den")),
+                                    p);
+                else
+                  return value_t{n, 1};
+            }
+            case json::_NULL:
+              throw json::coercion_exception(
+                "[Q64] value_from_json: node is of kind NULL and cannot be "
+                "interpreted as a rational.");
+          }
+          throw std::runtime_error("json parser Q64");
+      }
+    }
+
+  private:
+    static value_t from_json_(z64_t num, z64_t den, json::node_t const* p)
+    {
+      if (den == 0)
+        throw json::coercion_exception(
+          "[Q64] value_from_json: zero denominator.", p);
+      return value_t{num, den}.reduce();
+    }
+
+      };
+
+  inline q64 join(const q64&, const q64&) { return {}; }
+
+  inline q64 join(const q&, const q64&) { return {}; }
+  inline q64 join(const q64&, const q&) { return {}; }
+
+  inline q64 join(const z64&, const q64&) { return {}; }
+  inline q64 join(const q64&, const z64&) { return {}; }
+
+  inline q64 join(const z&, const q64&) { return {}; }
+  inline q64 join(const q64&, const z&) { return {}; }
+
+  inline q64 join(const n&, const q64&) { return {}; }
+  inline q64 join(const q64&, const n&) { return {}; }
+
+  inline q64 join(const b&, const q64&) { return {}; }
+  inline q64 join(const q64&, const b&) { return {}; }
+
+  // Z64 and Q are joined in Q64.
+  inline q64 join(const z64&, const q&) { return {}; }
+  inline q64 join(const q&, const z64&) { return {}; }
+
+  }
+}//end of ns awali::stc
+
+#endif // !AWALI_WEIGHTSET_Q64_HH
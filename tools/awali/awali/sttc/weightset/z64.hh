@@ -0,0 +1,304 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AWALI_WEIGHTSET_Z64_HH
+# define AWALI_WEIGHTSET_Z64_HH
+
+# include <ostream>
+# include <string>
+# include <sstream>
+
+#include <awali/common/bigint.hh>
+#include <awali/sttc/misc/raise.hh>
+#include <awali/common/enums.hh>
+#include <awali/sttc/misc/stream.hh>
+#include <awali/sttc/weightset/z.hh>
+#include <awali/common/parse_exception.cc>
+#include <awali/sttc/weightset/lr_parse_number.hh>
+
+namespace awali {
+  namespace sttc {
+    /** The semiring of Integers, without overflow.
+     *
+     * The values are z64_t: the computations are done on 64-bit
+     * integers as long as they do not overflow, and on arbitrary
+     * precision integers otherwise.
+     */
+  class z64
+  {
+  public:
+    using self_type = z64;
+
+    static std::string sname()
+    {
+      return "z64";
+    }
+
+    std::string vname(bool = true) const
+    {
+      return sname();
+    }
+
+    /// Build from the description in \a is.
+    static z64 make(std::istream& is)
+    {
+      eat(is, sname());
+      return {};
+    }
+
+    using value_t = z64_t;
+
+    static value_t
+    zero()
+    {
+      return 0;
+    }
+
+    static value_t
+    one()
+    {
+      return 1;
+    }
+
+    static value_t
+    add(const value_t& l, const value_t& r)
+    {
+      return l + r;
+    }
+
+    static value_t
+    sub(const value_t& l, const value_t& r)
+    {
+      return l - r;
+    }
+
+    static value_t
+    mul(const value_t& l, const value_t& r)
+    {
+      return l * r;
+    }
+
+    static value_t
+    rdiv(const value_t& l, const value_t& r)
+    {
+      require(!is_zero(r), "div: division by zero");
+      require(is_zero(l % r),
+              "Z64: div: invalid division: ", l, '/', r);
+      return l / r;
+    }
+
+    static value_t
+    ldiv(const value_t& l, const value_t& r)
+    {
+      return rdiv(r, l);
+    }
+
+    value_t
+    star(const value_t& v) const
+    {
+      if (is_zero(v))
+        return one();
+      else
+        raise("Z64: star: invalid value: ", format(*this, v));
+    }
+
+    value_t
+    plus(const value_t& v) const
+    {
+      if (is_zero(v))
+        return zero();
+      else
+        raise("Z64: star: invalid value: ", format(*this, v));
+    }
+
+    constexpr static bool is_special(const value_t&)
+    {
+      return false;
+    }
+
+    static bool
+    is_zero(const value_t& v)
+    {
+      return v == 0;
+    }
+
+    static bool
+    is_one(const value_t& v)
+    {
+      return v == 1;
+    }
+
+    static bool
+    equals(const value_t& l, const value_t& r)
+    {
+      return l == r;
+    }
+
+    /// Whether \a lhs < \a rhs.
+    static bool less_than(const value_t& lhs, const value_t& rhs)
+    {
+      return lhs < rhs;
+    }
+
+    static constexpr bool is_commutative_semiring() { return true; }
+
+    static constexpr bool show_one() { return false; }
+    static constexpr star_status_t star_status() { return star_status_t::NON_STARRABLE; }
+
+    static value_t
+    transpose(const value_t& v)
+    {
+      return v;
+    }
+
+    static size_t hash(const value_t& v)
+    {
+      return v.hash();
+    }
+
+    static value_t
+    conv(self_type, const value_t& v)
+    {
+      return v;
+    }
+
+    static value_t
+    conv(z, z::value_t v)
+    {
+      return v;
+    }
+
+    static value_t
+    conv(n, n::value_t v)
+    {
+      return (long long) v;
+    }
+
+    static value_t
+    conv(b, b::value_t v)
+    {
+      return v;
+    }
+
+    static value_t
+    parse(const std::string & s, size_t& p) {
+      size_t i = p;
+      if (!internal::lr_scan_int(s, i))
+        throw parse_exception("Could not parse an integer right of position "
+                              + std::to_string(p) + " in string \"" + s
+                              + "\".");
+      value_t res = value_t::from_string(s.substr(i, p - i));
+      p = i;
+      return res;
+    }
+
+    static value_t
+    conv(std::istream& stream)
+    {
+      value_t res;
+      if (stream >> res)
+        return res;
+      else
+        fail_reading(stream, sname() + ": invalid value");
+     }
+
+    static std::ostream&
+    print(const value_t& v, std::ostream& o,
+          const std::string& = "text")
+    {
+      return o << v;
+    }
+
+    std::ostream&
+    print_set(std::ostream& o, const std::string& format = "text") const
+    {
+      if (format == "latex")
+        o << "\\mathbb{Z}";
+      else if (format == "text")
+        o << "Z64";
+      else
+        raise("invalid format: ", format);
+      return o;
+    }
+
+    template<unsigned version = version::fsm_json>
+    value_t
+    value_from_json(json::node_t const* p)
+    const
+    {
+      version::check_fsmjson<version>();
+      switch (version) {
+        case 0: /* Never occurs due to above check. */
+        case 1:
+        default:
+          if (p->kind == json::STRING)
+            try {
+              return value_t::from_string(p->string()->value);
+            }
+            catch (std::invalid_argument& e) {
+              throw json::coercion_exception(
+                "[Z64] value_from_json: " + std::string(e.what()));
+            }
+          return p->to_int();
+      }
+    }
+
+    /// Values which do not fit in an int are written as strings.
+    template<unsigned version = version::fsm_json>
+    json::node_t*
+    value_to_json(const value_t& v)
+    const
+    {
+      version::check_fsmjson<version>();
+      switch (version) {
+        case 0: /* Never occurs due to above check. */
+        case 1:
+        default:
+          if (v.is_small() && v.small() >= std::numeric_limits<int>::min()
+              && v.small() <= std::numeric_limits<int>::max())
+            return new json::int_t((int) v.small());
+          return new json::string_t(v.to_string());
+      }
+    }
+
+    template<unsigned version = version::fsm_json>
+    json::node_t*
+    to_json() const
+    {
+      version::check_fsmjson<version>();
+      switch (version) {
+        case 0: /* Never occurs due to above check. */
+        case 1:
+        default:
+          json::object_t* obj = new json::object_t();
+          obj->push_back("semiring",new json::string_t("Z64"));
+          return obj;
+      }
+    }
+
+  };
+
+  inline z64 join(const z64&, const z64&) { return {}; }
+  inline z64 join(const z&, const z64&) { return {}; }
+  inline z64 join(const z64&, const z&) { return {}; }
+  inline z64 join(const n&, const z64&) { return {}; }
+  inline z64 join(const z64&, const n&) { return {}; }
+  inline z64 join(const b&, const z64&) { return {}; }
+  inline z64 join(const z64&, const b&) { return {}; }
+
+}}//end of ns awali::stc
+
+#endif // !AWALI_WEIGHTSET_Z64_HH
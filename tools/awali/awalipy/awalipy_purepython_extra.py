@@ -48,3 +48,39 @@ def _deprecated(caller,since=None,replace="the method with the same name"):
     print(s)
 
 
+
+
+def run_in_parallel(operations, max_workers=None):
+    """
+    Usage:  run_in_parallel(operations [, max_workers=None ])
+
+    Description:  runs a list of operations on a pool of native threads and returns the list of their results, in the same order.
+
+    Args:
+        operations (list): each operation is either a callable, or a tuple whose first element is a callable and the others are its arguments.
+        max_workers (int, optional): number of threads; by default, the number of processors.
+
+    Returns:
+        list: the results of the operations.
+
+    Example:
+        run_in_parallel([aut1.determinize, (aut2.product, aut3), (aut4.eval, "abba")])
+
+    Notes:
+        The long computations of awalipy (determinize, product, minimal_automaton, eval, etc.) release the Python global lock, so that they actually run in parallel.
+        If an operation raises an exception, the first one (in the order of the list) is raised again once all operations are finished.
+        The automata used by an operation must not be modified by another one.
+    """
+    import concurrent.futures
+    import os
+    calls = []
+    for op in operations:
+        if isinstance(op, tuple):
+            calls.append((op[0], op[1:]))
+        else:
+            calls.append((op, ()))
+    if max_workers is None:
+        max_workers = os.cpu_count() or 1
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max_workers) as pool:
+        futures = [pool.submit(f, *args) for (f, args) in calls]
+        return [future.result() for future in futures]
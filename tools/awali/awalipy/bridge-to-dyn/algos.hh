@@ -20,6 +20,7 @@
 #include <awalipy/bridge-to-dyn/ratexp.hh>
 
 #include <fstream>
+#include <limits>
 #include <sstream>
 
 namespace awali { namespace py {
@@ -383,6 +384,49 @@ namespace awali { namespace py {
     return simple_res;
   }
 
+  struct simple_word_enumerator_t {
+
+  protected:
+    simple_automaton_t aut_;
+    dyn::word_enumerator_t enumerator_;
+    std::string word_;
+    std::string weight_;
+
+  public:
+    simple_word_enumerator_t() {}
+
+    simple_word_enumerator_t(simple_automaton_t aut,
+                             dyn::word_enumerator_t enumerator)
+      : aut_(aut), enumerator_(enumerator)
+    {}
+
+    /* Moves to the next word; returns false if there is none. */
+    bool next()
+    {
+      dyn::any_t w, k;
+      if (!enumerator_ || !enumerator_->next(w, k))
+        return false;
+      std::ostringstream word;
+      word << w;
+      word_ = word.str();
+      weight_ = aut_.weight_to_string(k);
+      return true;
+    }
+
+    std::string word() const { return word_; }
+
+    std::string weight() const { return weight_; }
+  };
+
+  simple_word_enumerator_t lazy_enumerate_(simple_automaton_t aut,
+                                           int max_len)
+  {
+    unsigned max = max_len < 0 ? std::numeric_limits<unsigned>::max()
+                               : (unsigned) max_len;
+    return simple_word_enumerator_t(aut,
+                             dyn::lazy_enumerate((dyn::automaton_t) aut, max));
+  }
+
   // factor
   void prefix_here_(simple_automaton_t aut)
   {
@@ -465,10 +509,12 @@ namespace awali { namespace py {
       opts += (dyn::QUOTIENT_ALGO = HOPCROFT);
     else if (method == "brzozowski")
       opts += (dyn::MINIM_ALGO = BRZOZOWSKI);
+    else if (method == "incremental")
+      opts += (dyn::MINIM_ALGO = INCREMENTAL);
     else
       throw std::domain_error(
-          "Valid values for minimal_automaton are: \"hopcroft\", \"moore\" and "
-          "\"brzozowski\"");
+          "Valid values for minimal_automaton are: \"hopcroft\", \"moore\", "
+          "\"brzozowski\" and \"incremental\"");
 
     return simple_automaton_t(
         dyn::minimal_automaton((dyn::automaton_t) aut, opts));
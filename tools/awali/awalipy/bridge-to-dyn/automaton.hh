@@ -18,9 +18,68 @@
 #define DYN_SIMPLE_AUTOMATON_HH
 
 #include <awalipy/bridge-to-dyn/basic_automaton.hh>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <vector>
 
 namespace awali { namespace py {
 
+  namespace internal {
+
+    /* Numerical value of a weight; only for weightsets whose weights are
+     * Booleans, integers or floating point numbers, which are exactly
+     * representable as double. */
+    inline double weight_to_double(const dyn::any_t& w)
+    {
+      using dyn::internal::any_typeof;
+      using dyn::internal::any_cast;
+      if (any_typeof<bool>(w))
+        return any_cast<bool>(w);
+      if (any_typeof<int>(w))
+        return any_cast<int>(w);
+      if (any_typeof<unsigned>(w))
+        return any_cast<unsigned>(w);
+      if (any_typeof<double>(w))
+        return any_cast<double>(w);
+      throw std::invalid_argument("Weights cannot be converted exactly to floating point numbers.");
+    }
+
+    /* Weight of value x, with the same type as model; throws if x is not
+     * exactly a weight of this type. */
+    inline dyn::any_t double_to_weight(double x, const dyn::any_t& model)
+    {
+      using dyn::internal::any_typeof;
+      if (any_typeof<double>(model))
+        return x;
+      if (!any_typeof<bool>(model) && !any_typeof<int>(model)
+          && !any_typeof<unsigned>(model))
+        throw std::invalid_argument("Weights cannot be converted exactly from floating point numbers.");
+      if (x != std::trunc(x)) {
+        std::ostringstream o;
+        o << "Weight " << x << " is not an integer.";
+        throw std::invalid_argument(o.str());
+      }
+      if (any_typeof<bool>(model)) {
+        if (x != 0 && x != 1)
+          throw std::invalid_argument("Boolean weights must be 0 or 1.");
+        return (bool) (x == 1);
+      }
+      if (any_typeof<int>(model)) {
+        if (x < std::numeric_limits<int>::min()
+            || x > std::numeric_limits<int>::max())
+          throw std::out_of_range("Weight out of the range of integers.");
+        return (int) x;
+      }
+      if (x < 0)
+        throw std::invalid_argument("Negative weight in a weightset of non-negative integers.");
+      if (x > std::numeric_limits<unsigned>::max())
+        throw std::out_of_range("Weight out of the range of non-negative integers.");
+      return (unsigned) x;
+    }
+  }
+
   struct simple_automaton_t : basic_automaton_t {
 
   dyn::any_t label_of(const std::string& label) const {
@@ -141,6 +200,80 @@ namespace awali { namespace py {
 //     }
 
 
+    /* Index of every letter in alphabet(). */
+    std::map<dyn::any_t, int> letter_indices() const {
+      std::map<dyn::any_t, int> res;
+      int i = 0;
+      for (auto l : aut_->alphabet())
+        res.emplace(l, i++);
+      return res;
+    }
+
+    /* Table of the transitions: the i-th transition goes from src[i] to
+     * dst[i], its label is the letter of index label[i] in alphabet(),
+     * or -1 for epsilon, and its weight is weight[i]. */
+    void transition_table(std::vector<int>& src, std::vector<int>& dst,
+                          std::vector<int>& label,
+                          std::vector<double>& weight) const {
+      std::map<dyn::any_t, int> letters = letter_indices();
+      std::vector<dyn::transition_t> trans = aut_->transitions();
+      src.resize(trans.size());
+      dst.resize(trans.size());
+      label.resize(trans.size());
+      weight.resize(trans.size());
+      for (size_t i = 0; i < trans.size(); ++i) {
+        dyn::transition_t t = trans[i];
+        src[i] = aut_->src_of(t) - 2;
+        dst[i] = aut_->dst_of(t) - 2;
+        auto it = letters.find(aut_->label_of(t));
+        label[i] = it == letters.end() ? -1 : it->second;
+        weight[i] = internal::weight_to_double(aut_->weight_of(t));
+      }
+    }
+
+    /* Adds n states, and returns the first of them. */
+    int add_states(unsigned n) {
+      int res = -1;
+      for (unsigned i = 0; i < n; ++i) {
+        int s = aut_->add_state() - 2;
+        if (i == 0)
+          res = s;
+      }
+      return res;
+    }
+
+    /* Adds the transitions of a table with the layout of
+     * transition_table(); if weight is null, the weights are one.  The
+     * whole table is checked before any transition is added, so that the
+     * automaton is left unchanged if it is invalid. */
+    void add_transition_table(size_t n, const int* src, const int* dst,
+                              const int* label, const double* weight) {
+      std::vector<dyn::any_t> letters = aut_->alphabet();
+      dyn::context_t ctx = aut_->get_context();
+      dyn::any_t one = ctx->weight_one();
+      bool eps_allowed = ctx->is_eps_allowed();
+      std::vector<dyn::any_t> weights;
+      if (weight != nullptr)
+        weights.reserve(n);
+      for (size_t i = 0; i < n; ++i) {
+        verify_existence_of_state(src[i], "Source");
+        verify_existence_of_state(dst[i], "Destination");
+        if (label[i] < -1 || label[i] >= (int) letters.size())
+          throw std::out_of_range("No letter of index " + std::to_string(label[i]) + " in the alphabet.");
+        if (label[i] == -1 && !eps_allowed)
+          throw std::invalid_argument("Epsilon transitions are not allowed in this automaton.");
+        if (weight != nullptr)
+          weights.emplace_back(internal::double_to_weight(weight[i], one));
+      }
+      for (size_t i = 0; i < n; ++i) {
+        const dyn::any_t& w = weight == nullptr ? one : weights[i];
+        if (label[i] == -1)
+          aut_->add_eps_transition(src[i] + 2, dst[i] + 2, w);
+        else
+          aut_->add_transition(src[i] + 2, dst[i] + 2, letters[label[i]], w);
+      }
+    }
+
     bool is_eps_allowed() const {
       return aut_->get_context()->is_eps_allowed();
     }
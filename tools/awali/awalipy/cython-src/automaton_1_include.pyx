@@ -34,6 +34,9 @@ cdef extern from "automaton.h" namespace "awali::py":
         string alphabet() except + ### <- its.
         bool has_letter(string l) except + ### <- its.
         bool is_eps_allowed() except + ### <- its.
+        void transition_table(vector[int]& src, vector[int]& dst, vector[int]& label, vector[double]& weight) except +
+        int add_states(unsigned n) except +
+        void add_transition_table(size_t n, const int* src, const int* dst, const int* label, const double* weight) except +
     simple_automaton_t make_simple_automaton2(string alphabet, string semiring) except + ### <- its.
     simple_automaton_t make_simple_automaton1(string alphabet) except + ### <- its.
     simple_automaton_t make_NFA_with_eps1(string alphabet)
@@ -56,31 +59,37 @@ cdef extern from "automaton.h" namespace "awali::py":
     simple_transducer_t partial_identity_(simple_automaton_t aut) except +
     simple_automaton_t allow_eps_transition_(simple_automaton_t aut) except +
 
-    simple_automaton_t determinize_(simple_automaton_t aut, bool history) except +
-    bool are_equivalent_(simple_automaton_t aut, simple_automaton_t aut2) except +
+    simple_automaton_t determinize_(simple_automaton_t aut, bool history) except + nogil
+    bool are_equivalent_(simple_automaton_t aut, simple_automaton_t aut2) except + nogil
     simple_automaton_t complement_(simple_automaton_t aut) except +
     void complement_here_(simple_automaton_t aut) except +
     simple_automaton_t complete_(simple_automaton_t aut) except +
     void complete_here_(simple_automaton_t aut) except +
-    simple_automaton_t reduce_(simple_automaton_t aut) except +
+    simple_automaton_t reduce_(simple_automaton_t aut) except + nogil
     simple_automaton_t left_reduce_(simple_automaton_t aut) except +
     simple_automaton_t right_reduce_(simple_automaton_t aut) except +
     bool is_deterministic_(simple_automaton_t aut) except +
     bool is_complete_(simple_automaton_t aut) except +
     bool is_ambiguous_(simple_automaton_t aut) except +
 
-    string eval_ (simple_automaton_t aut, string word) except +
+    string eval_ (simple_automaton_t aut, string word) except + nogil
     map[string,string] shortest_(simple_automaton_t aut, unsigned max) except +
     map[string,string] enumerate_(simple_automaton_t aut, unsigned max) except +
+    cppclass simple_word_enumerator_t:
+        simple_word_enumerator_t()
+        bool next() except +
+        string word()
+        string weight()
+    simple_word_enumerator_t lazy_enumerate_(simple_automaton_t aut, int max_len) except +
 
-    simple_automaton_t product_(simple_automaton_t aut1, simple_automaton_t aut2) except +
-    simple_automaton_t power_(simple_automaton_t aut, unsigned n) except +
+    simple_automaton_t product_(simple_automaton_t aut1, simple_automaton_t aut2) except + nogil
+    simple_automaton_t power_(simple_automaton_t aut, unsigned n) except + nogil
     simple_automaton_t shuffle_(simple_automaton_t aut1, simple_automaton_t aut2) except +
     simple_automaton_t infiltration_(simple_automaton_t aut1, simple_automaton_t aut2) except +
     simple_automaton_t sum_(simple_automaton_t aut1, simple_automaton_t aut2) except +
     bool are_isomorphic_(basic_automaton_t aut1, basic_automaton_t aut2) except +
     void proper_here_(simple_automaton_t aut, bool backward, bool prune)  except +
-    simple_automaton_t proper_(simple_automaton_t aut, bool backward, bool prune)  except +
+    simple_automaton_t proper_(simple_automaton_t aut, bool backward, bool prune)  except + nogil
     bool is_proper_(simple_automaton_t aut) except +
     bool is_valid_(simple_automaton_t aut) except +
 
@@ -92,12 +101,12 @@ cdef extern from "automaton.h" namespace "awali::py":
     void factor_here_(simple_automaton_t aut) except +
 
 #      simple_automaton_t minimal_brzozowski_(simple_automaton_t aut) except +
-    simple_automaton_t minimal_automaton_(simple_automaton_t aut, string method) except +
-    simple_automaton_t minimal_automaton_(simple_automaton_t aut) except +
-    simple_automaton_t min_quotient_(simple_automaton_t aut, string method) except +
-    simple_automaton_t min_quotient_(simple_automaton_t aut) except +
-    simple_automaton_t min_coquotient_(simple_automaton_t aut, string) except +
-    simple_automaton_t min_coquotient_(simple_automaton_t aut) except +
+    simple_automaton_t minimal_automaton_(simple_automaton_t aut, string method) except + nogil
+    simple_automaton_t minimal_automaton_(simple_automaton_t aut) except + nogil
+    simple_automaton_t min_quotient_(simple_automaton_t aut, string method) except + nogil
+    simple_automaton_t min_quotient_(simple_automaton_t aut) except + nogil
+    simple_automaton_t min_coquotient_(simple_automaton_t aut, string) except + nogil
+    simple_automaton_t min_coquotient_(simple_automaton_t aut) except + nogil
     simple_automaton_t quotient_(simple_automaton_t aut, vector[vector[int]] equiv) except +
     simple_automaton_t coquotient_(simple_automaton_t aut, vector[vector[int]] equiv) except +
     
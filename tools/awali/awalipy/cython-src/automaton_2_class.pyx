@@ -32,6 +32,22 @@ cdef Automaton _Automaton(basic_automaton_t aut):
     a._set_cpp_class(aut)
     return a
 
+cdef class _WordEnumerator:
+    """Iterator over the words accepted by an automaton, built by Automaton.lazy_enumerate(..).
+
+    Each step yields a pair (word, weight) of str.  Words are computed on demand.
+    """
+    cdef simple_word_enumerator_t _this
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        if not self._this.next():
+            raise StopIteration
+        return (str(self._this.word()), str(self._this.weight()))
+
+
 cdef class Automaton(_BasicAutomaton):
 
     cdef simple_automaton_t _to_cpp_class(self):
@@ -61,7 +77,7 @@ cdef class Automaton(_BasicAutomaton):
             ratexp (RatExp)
             alphabet (str), each character of this  will be a letter of the produced-automaton alphabet
             weighset (str or WeightSet, optional)
-                admissible values are 'B', 'Z', 'Z-min-plus', 'Z-max-plus', 'Q', 'R', 'R-max-prod', 'F2' and 'Z/<int>Z"                defaults to 'B'
+                admissible values are 'B', 'Z', 'Z-min-plus', 'Z-max-plus', 'Q', 'R', 'R-max-prod', 'F2', 'Z64', 'Q64' and 'Z/<int>Z"                defaults to 'B'
 
         Named argument authorized for [d] (also works for [c])
             alphabet (str), same as above
@@ -229,7 +245,12 @@ cdef class Automaton(_BasicAutomaton):
 
         Args:  word (str)
         """
-        return eval_(self._to_cpp_class(), word)
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        cdef string word_ = word
+        cdef string res
+        with nogil:
+            res = eval_(aut, word_)
+        return res
 
 
 ## ========================================================================= ##
@@ -306,6 +327,72 @@ transition if necessary.
             return self._to_cpp_class().add_transition4(self._id_or_name(src), self._id_or_name(dst), label, weight)
 
 
+## ========================================================================= ##
+    def transition_table(self):
+        """
+        Usage:  aut.transition_table()
+
+        Description:  exports the transitions of <aut/self> as four arrays of the same length; the i-th transition goes from src[i] to dst[i], is labelled by the letter of index label[i] in aut.alphabet() (or by epsilon if label[i] is -1), and has weight weight[i].  The arrays support the buffer protocol: numpy.asarray(..) gives views on them, without copy.
+
+        Preconditions:
+            the weights of <aut/self> must be Booleans, integers or floating point numbers (e.g. weightset 'B', 'N', 'Z', 'Z-min-plus' or 'R'); other weightsets, like 'Q', are refused since their weights cannot be represented exactly by a double.
+
+        Returns:
+            tuple (src, dst, label, weight): the first three are arrays of C int, the last one is an array of C double.
+        """
+        cdef _IntArray src = _IntArray()
+        cdef _IntArray dst = _IntArray()
+        cdef _IntArray label = _IntArray()
+        cdef _DoubleArray weight = _DoubleArray()
+        self._to_cpp_class().transition_table(src._data, dst._data, label._data, weight._data)
+        return (src, dst, label, weight)
+
+
+## ========================================================================= ##
+    def add_states(self, unsigned int n):
+        """
+        Usage:  aut.add_states(n)
+
+        Description:  adds <n> states to <aut/self>.
+
+        Args:
+            n (int), number of states to add.
+
+        Returns:  int, the identifier of the first added state; the identifiers of the states added to an automaton without deleted states are consecutive.
+        """
+        return self._to_cpp_class().add_states(n)
+
+
+## ========================================================================= ##
+    def add_transition_table(self, const int[::1] src, const int[::1] dst, const int[::1] label, const double[::1] weight=None):
+        """
+        Usage:  aut.add_transition_table(src, dst, label [, weight=None ] )
+
+        Description:  adds to <aut/self> all the transitions of a table with the layout of aut.transition_table(), in a single call.  If a transition already exists, its weight is increased.
+
+        Args:
+            src, dst, label: contiguous arrays of C int (e.g. numpy arrays with dtype numpy.intc) of the same length
+            weight (optional): contiguous array of C double (e.g. numpy array with dtype numpy.double)
+                defaults to None, in which case all the weights are aut.get_weightset().one().
+
+        Preconditions:
+            all the states in <src> and <dst> must exist;
+            label[i] must be -1 (epsilon, only if allowed) or the index of a letter in aut.alphabet();
+            weight[i] must be exactly a weight of <aut/self>: 0 or 1 for 'B', an integer for 'N' or 'Z'; other weightsets than these and 'R' are refused, as for aut.transition_table().
+
+        The whole table is checked before any transition is added: if it is invalid, <aut/self> is left unchanged.
+        """
+        cdef size_t n = src.shape[0]
+        if dst.shape[0] != n or label.shape[0] != n or (weight is not None and weight.shape[0] != n):
+            raise ValueError("Arrays of different lengths")
+        if n == 0:
+            return
+        cdef const double* w = NULL
+        if weight is not None:
+            w = &weight[0]
+        self._to_cpp_class().add_transition_table(n, &src[0], &dst[0], &label[0], w)
+
+
 ## ========================================================================= ##
     def has_transition(self, source_or_transition, object dst=None, str label=None): #3
         """
@@ -550,7 +637,7 @@ labelled by <label>.
         Description:  returns the characteristic of <aut/self>, that is the automaton on the weight-set <weightset> resulting from setting the weight of every transition of <aut/self> to one (ie. the multiplicative neutral element of <weightset>).
 
         Args:
-            weightset (str):  weight-set of the returned automaton. Admissible values are {'B', 'Z', 'Z-min-plus', 'Z-max-plus', 'Q', 'R', 'R-max-prod', 'F2' }.
+            weightset (str):  weight-set of the returned automaton. Admissible values are {'B', 'Z', 'Z-min-plus', 'Z-max-plus', 'Q', 'R', 'R-max-prod', 'F2', 'Z64', 'Q64' }.
 
         Returns:
             Automaton, the characteristic of <aut/self> over the weight-set <weightset>.
@@ -616,7 +703,12 @@ labelled by <label>.
         Returns:
             bool: True if <aut/self> and <other> accept the same language.
         """
-        return are_equivalent_(self._to_cpp_class(), other._to_cpp_class())
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        cdef simple_automaton_t aut2 = other._to_cpp_class()
+        cdef bool res
+        with nogil:
+            res = are_equivalent_(aut, aut2)
+        return res
 
 
 ## ========================================================================= ##
@@ -639,7 +731,10 @@ labelled by <label>.
         Notes:
             An automaton is deterministic if each state features at most one outgoing transition labelled by a given letter.
         """
-        return _Automaton(determinize_(self._to_cpp_class(), history))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        with nogil:
+            aut = determinize_(aut, history)
+        return _Automaton(aut)
 
 
 ## ========================================================================= ##
@@ -659,7 +754,10 @@ labelled by <label>.
             An automaton is deterministic if each state features at most one outgoing transition labelled by a given letter.
             Convenience function written at the python layer.
         """
-        self._set_cpp_class(determinize_(self._to_cpp_class(), history))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        with nogil:
+            aut = determinize_(aut, history)
+        self._set_cpp_class(aut)
 
 
 ## ========================================================================= ##
@@ -769,7 +867,10 @@ labelled by <label>.
         Notes:
             The computation of the reduced automaton can be seen as the generalisation (to automata whose weight-set is a field) of the minimization process due to J. A. Brzozowski.
               """
-        return _Automaton(reduce_(self._to_cpp_class()))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        with nogil:
+            aut = reduce_(aut)
+        return _Automaton(aut)
 
 
 ## ========================================================================= ##
@@ -786,7 +887,10 @@ labelled by <label>.
             If the weigh-set is not a field but is a sub-semi-ring of a clear field (eg Z is included in Q), the automaton weight-set will be generalised to the field and the reduced automaton will be computed as normal.
             Convenience function written at the python layer.
         """
-        self._set_cpp_class(reduce_(self._to_cpp_class()))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        with nogil:
+            aut = reduce_(aut)
+        self._set_cpp_class(aut)
 
 
 ## ========================================================================= ##
@@ -855,7 +959,11 @@ labelled by <label>.
 
         Notes:  The weight of a given word in the Hadamard product is the weight-set multiplication of the respective weights of this word in the two operand automata.
         """
-        return _Automaton(product_(self._to_cpp_class(), other._to_cpp_class()))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        cdef simple_automaton_t aut2 = other._to_cpp_class()
+        with nogil:
+            aut = product_(aut, aut2)
+        return _Automaton(aut)
 
 
 ## ========================================================================= ##
@@ -873,7 +981,11 @@ labelled by <label>.
             The weight of a given word in the Hadamard product is the weight-set multiplication of the respective weights of this word in the two operand automata.
             Convenience function written at the python layer.
         """
-        self._set_cpp_class(product_(self._to_cpp_class(), other._to_cpp_class()))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        cdef simple_automaton_t aut2 = other._to_cpp_class()
+        with nogil:
+            aut = product_(aut, aut2)
+        self._set_cpp_class(aut)
 
 
 ## ========================================================================= ##
@@ -893,7 +1005,10 @@ labelled by <label>.
         Notes:
             The weight of a given word in the Hadamard product is the weight-set multiplication of the respective weights of this word in the two operand automata.
         """
-        return _Automaton(power_(self._to_cpp_class(), n))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        with nogil:
+            aut = power_(aut, n)
+        return _Automaton(aut)
 
 
 ## ========================================================================= ##
@@ -912,7 +1027,10 @@ labelled by <label>.
             The weight of a given word in the Hadamard product is the weight-set multiplication of the respective weights of this word in the two operand automata.
             Convenience function written at the python layer.
         """
-        self._set_cpp_class(power_(self._to_cpp_class(), n))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        with nogil:
+            aut = power_(aut, n)
+        self._set_cpp_class(aut)
 
 
 ## ========================================================================= ##
@@ -994,7 +1112,10 @@ labelled by <label>.
         Returns:
             Automaton, automaton equivalent to <aut/self> without epsilon transitions and that does not allow future addition of epsilon-transitions.
         """
-        return _Automaton(proper_(self._to_cpp_class(), backward, prune))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        with nogil:
+            aut = proper_(aut, backward, prune)
+        return _Automaton(aut)
 
 
 ## ========================================================================= ##
@@ -1010,7 +1131,10 @@ labelled by <label>.
 
         Note:  Convenience function written at the python layer.
         """
-        self._set_cpp_class(proper_(self._to_cpp_class(), backward, prune))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        with nogil:
+            aut = proper_(aut, backward, prune)
+        self._set_cpp_class(aut)
 
 
 ## ========================================================================= ##
@@ -1077,6 +1201,29 @@ labelled by <label>.
         return _from_map_s_s(enumerate_(self._to_cpp_class(), max_len))
 
 
+## ========================================================================= ##
+    def lazy_enumerate(self, int max_len = -1):
+        """
+        Usage:  aut.lazy_enumerate(max_len = -1)
+
+        Description:  iterates over the words accepted by <aut/self> and their weight, by increasing length then in lexicographic order.  Words are computed on demand, hence the iteration may be stopped at any time, even if the language of <aut/self> is infinite.
+
+        Args:
+            max_len (int), maximal length of the words
+                a negative value means no bound
+                default value:  -1
+
+        Preconditions:
+            <aut/self> must be proper.
+
+        Returns:
+            iterator over pairs (str, str): each pair is an accepted word and its weight.
+        """
+        cdef _WordEnumerator it = _WordEnumerator()
+        it._this = lazy_enumerate_(self._to_cpp_class(), max_len)
+        return it
+
+
 ## ========================================================================= ##
     def prefix(self):
         """
@@ -1159,11 +1306,15 @@ labelled by <label>.
 
         Preconditions:  weightset of <aut/self> must be B.
 
-        Args:  method(str, optional), algorithm to use; admissible values are "moore", "hopcroft", or "brzozowski"; default value is "moore".
+        Args:  method(str, optional), algorithm to use; admissible values are "moore", "hopcroft", "brzozowski", or "incremental"; default value is "moore".
 
         Returns (Automaton)
         """
-        return _Automaton(minimal_automaton_(self._to_cpp_class(), method))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        cdef string method_ = method
+        with nogil:
+            aut = minimal_automaton_(aut, method_)
+        return _Automaton(aut)
 
 
 ## ========================================================================= ##
@@ -1196,7 +1347,11 @@ then the algorithm will not fail but the resulting automaton will not be a quoti
 
 Returns (Automaton)
         """
-        return _Automaton(min_quotient_(self._to_cpp_class(), method))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        cdef string method_ = method
+        with nogil:
+            aut = min_quotient_(aut, method_)
+        return _Automaton(aut)
 
 
 ## ========================================================================= ##
@@ -1259,7 +1414,11 @@ then the algorithm will not fail but the resulting automaton will not be a coquo
 
         Returns (Automaton)
         """
-        return _Automaton(min_coquotient_(self._to_cpp_class(), method))
+        cdef simple_automaton_t aut = self._to_cpp_class()
+        cdef string method_ = method
+        with nogil:
+            aut = min_coquotient_(aut, method_)
+        return _Automaton(aut)
 
 
 ## ========================================================================= ##
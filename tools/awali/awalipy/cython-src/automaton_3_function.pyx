@@ -141,7 +141,7 @@ def make_automaton(str alphabet, str weightset=None):
     Args:
         alphabet (str), letters that may label the transitions of the automaton.
         weightset (str, optional), represents the set of transition weights.
-            Admissible values are 'B', 'Z', 'Z-min-plus', 'Z-max-plus', 'Q', 'R', 'R-max-prod' and 'F2'.
+            Admissible values are 'B', 'Z', 'Z-min-plus', 'Z-max-plus', 'Q', 'R', 'R-max-prod', 'F2', 'Z64' and 'Q64'.
             Case-insensitive.
             Defaults to 'B'.
 
@@ -153,6 +153,34 @@ def make_automaton(str alphabet, str weightset=None):
     return Automaton(alphabet, weightset)
 
 
+## ========================================================================= ##
+def make_automaton_from_arrays(str alphabet, unsigned int num_states, src, dst, label, weight=None, initials=(), finals=(), str weightset='B'):
+    """Usage:  make_automaton_from_arrays(alphabet, num_states, src, dst, label [, weight=None, initials=(), finals=(), weightset='B'])
+
+    Description:  builds in a single call the automaton with states 0, ..., <num_states>-1 and the transitions given by the arrays <src>, <dst>, <label> and <weight>, with the layout of Automaton.transition_table().
+
+    Args:
+        alphabet (str), letters that may label the transitions of the automaton.
+        num_states (int), number of states.
+        src, dst, label: contiguous arrays of C int (e.g. numpy arrays with dtype numpy.intc) of the same length
+        weight (optional): contiguous array of C double
+            defaults to None, in which case all the weights are one.
+        initials (iterable of int, optional), initial states.
+        finals (iterable of int, optional), final states.
+        weightset (str, optional), defaults to 'B'.
+
+    Returns:  Automaton
+    """
+    aut = Automaton(alphabet, weightset)
+    aut.add_states(num_states)
+    aut.add_transition_table(src, dst, label, weight)
+    for s in initials:
+        aut.set_initial(s)
+    for s in finals:
+        aut.set_final(s)
+    return aut
+
+
 ## ========================================================================= ##
 def alphabet(Automaton aut):
     """Usage:  alphabet(aut)
@@ -195,7 +223,7 @@ def characteristic(Automaton aut, str weightset):
     Args:
         aut (Automaton), automaton whose characteristic automaton is return.
         weightset (str), weight-set of the returned automaton
-            admissible values are 'B', 'Z', 'Z-min-plus', 'Z-max-plus', 'Q', 'R', 'R-max-prod', 'F2'
+            admissible values are 'B', 'Z', 'Z-min-plus', 'Z-max-plus', 'Q', 'R', 'R-max-prod', 'F2', 'Z64', 'Q64'
 
 
     Returns:
@@ -873,7 +901,7 @@ def minimal_automaton(Automaton aut, str method = "moore"):
 
     Args:  
         Aut (Automaton)
-        method(str, optional), algorithm to use; admissible values are "moore", "hopcroft", or "brzozowski"; default value is "moore".
+        method(str, optional), algorithm to use; admissible values are "moore", "hopcroft", "brzozowski", or "incremental"; default value is "moore".
 
 
     Precondition:  weigh-set of <aut> must be B.
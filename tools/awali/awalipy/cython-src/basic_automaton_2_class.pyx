@@ -1199,6 +1199,8 @@ cdef class _BasicAutomaton:
             method (str, optional): govers the order in which states are eliminated
               - "min_inout_degree": always eliminate the state with minimal (in degree)x(out degree).
               - "min_id": eliminates state by increasing identifier (hence in an arbitrary order)
+              - "min_exp_size": always eliminate the state whose elimination makes the expression grow the least.
+              - "scc_min_inout_degree": eliminate the strongly connected components with several states one after the other, then the other states; "min_inout_degree" within each group.
 
         Returns:
             RatExp, (weighted) expression of the language accepted by <aut_or_tdc/self>.
@@ -21,7 +21,7 @@ from libcpp.string cimport string
 from libcpp.vector cimport vector
 from libcpp cimport bool
 from libcpp.map cimport map
-from awalipy_purepython_extra import run_from_jupyter_notebook, _deprecated
+from awalipy_purepython_extra import run_from_jupyter_notebook, _deprecated, run_in_parallel
 
 cdef extern from "automaton.h" namespace "awali::version":
     string full
@@ -51,6 +51,82 @@ cdef vector[unsigned] _list_to_vector_of_unsigned(list l):
         v.push_back(i)
     return v
 
+cdef class _IntArray:
+    """One-dimensional array of C int owning its storage, exposed through the buffer protocol.
+
+    numpy.asarray(..) gives a view (without copy) on it.
+    """
+    cdef vector[int] _data
+    cdef Py_ssize_t _shape[1]
+    cdef Py_ssize_t _strides[1]
+
+    def __len__(self):
+        return self._data.size()
+
+    def __getitem__(self, Py_ssize_t i):
+        if i < 0:
+            i += self._data.size()
+        if i < 0 or i >= <Py_ssize_t>self._data.size():
+            raise IndexError("Index out of range")
+        return self._data[i]
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        self._shape[0] = self._data.size()
+        self._strides[0] = sizeof(int)
+        buffer.buf = <char*> (&self._data[0] if self._data.size() > 0 else NULL)
+        buffer.format = 'i'
+        buffer.internal = NULL
+        buffer.itemsize = sizeof(int)
+        buffer.len = self._data.size() * sizeof(int)
+        buffer.ndim = 1
+        buffer.obj = self
+        buffer.readonly = 0
+        buffer.shape = self._shape
+        buffer.strides = self._strides
+        buffer.suboffsets = NULL
+
+    def __releasebuffer__(self, Py_buffer *buffer):
+        pass
+
+
+cdef class _DoubleArray:
+    """One-dimensional array of C double owning its storage, exposed through the buffer protocol.
+
+    numpy.asarray(..) gives a view (without copy) on it.
+    """
+    cdef vector[double] _data
+    cdef Py_ssize_t _shape[1]
+    cdef Py_ssize_t _strides[1]
+
+    def __len__(self):
+        return self._data.size()
+
+    def __getitem__(self, Py_ssize_t i):
+        if i < 0:
+            i += self._data.size()
+        if i < 0 or i >= <Py_ssize_t>self._data.size():
+            raise IndexError("Index out of range")
+        return self._data[i]
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        self._shape[0] = self._data.size()
+        self._strides[0] = sizeof(double)
+        buffer.buf = <char*> (&self._data[0] if self._data.size() > 0 else NULL)
+        buffer.format = 'd'
+        buffer.internal = NULL
+        buffer.itemsize = sizeof(double)
+        buffer.len = self._data.size() * sizeof(double)
+        buffer.ndim = 1
+        buffer.obj = self
+        buffer.readonly = 0
+        buffer.shape = self._shape
+        buffer.strides = self._strides
+        buffer.suboffsets = NULL
+
+    def __releasebuffer__(self, Py_buffer *buffer):
+        pass
+
+
 cdef extern from "<set>" namespace "std" nogil:
     cdef cppclass set[T]:
         set() except +
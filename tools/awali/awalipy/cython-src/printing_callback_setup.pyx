@@ -15,7 +15,12 @@
 # along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 
-ctypedef void (*CallBackFunctionType)(string);
+from libc.stdio cimport fprintf, stderr
+
+ctypedef void (*CallBackFunctionType)(string) nogil
+
+cdef extern from "Python.h":
+    int PyGILState_Check() nogil
 
 cdef extern from "automaton.h" namespace "awali::py":
     void setup_callback_stream(CallBackFunctionType warning, CallBackFunctionType error);
@@ -25,8 +30,15 @@ def py_callback_function(s):
     _print_warning(s)    
     sys.stdout.flush()
 
-cdef void c_callback_function(string s):
-    py_callback_function(s);
+# Messages may be emitted by a thread which released the GIL (see
+# run_in_parallel), possibly while another thread holding the GIL waits for
+# the same module; such messages are printed directly on stderr.
+cdef void c_callback_function(string s) nogil:
+    if PyGILState_Check():
+        with gil:
+            py_callback_function(s);
+    else:
+        fprintf(stderr, "[Warning] %s\n", s.c_str())
 
 def _setup_printing_stream():
     setup_callback_stream(&c_callback_function, &c_callback_function)
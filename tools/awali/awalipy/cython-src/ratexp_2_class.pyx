@@ -272,14 +272,14 @@ cdef class RatExp:
 ## ========================================================================= ##
     def exp_to_aut(self, str method=None):
         """
-        Usage:  exp.exp_to_aut( [method="standard_and_quotient"] )
+        Usage:  exp.exp_to_aut( [method="derived_term"] )
 
         Description:  computes an automaton accepting <exp/self>.
 
         Args:
             method (str, optional), algorithm to use 
-                admissible values are "standard_and_quotient" (default), "compact_thompson", "thompson", "breaking_derived_term", "derived_term", "weighted_thompson", and "glushkov"
-                defaults to "standard_and_quotient"
+                admissible values are "derived_term" (default), "standard_and_quotient", "compact_thompson", "thompson", "breaking_derived_term", "weighted_thompson", and "glushkov"
+                defaults to "derived_term", which falls back to "standard_and_quotient" if the labels of <exp/self> are not letters
 
         Returns:  Automaton or Transducer
         """
@@ -388,14 +388,14 @@ cdef class RatExp:
 ## ========================================================================= ##
     def minimal_automaton(self, str exp_to_aut_method = "default", str minim_method = "default", str quotient_method = "default"):
         """
-        Usage:  exp.minimal_automaton([quotient_method="determinize_quotient"] [quotient_method="moore"] [exp_to_aut_method ="standard_and_quotient"])
+        Usage:  exp.minimal_automaton([quotient_method="determinize_quotient"] [quotient_method="moore"] [exp_to_aut_method ="derived_term"])
 
         Description:  computes the minimal automaton accepting the language matched by this RatExp.
 
       
         Arg:
-            exp_to_aut_method(str, optional): which algorithm to use to transform the ratexp to an automaton. Valid value are "glushkov", "derived_term", "breaking_derived_term", "thompson", "compact_thompson", "weighted_thompson" and "standard_and_quotient". Defaults to "standard_and_quotient".
-            minim_method (str, optional): how is computed the minimal automaton. Valid values are "brzozowski" and "determinize_quotient". Defaults to "determinize_quotient".
+            exp_to_aut_method(str, optional): which algorithm to use to transform the ratexp to an automaton. Valid value are "glushkov", "derived_term", "breaking_derived_term", "thompson", "compact_thompson", "weighted_thompson" and "standard_and_quotient". Defaults to "derived_term".
+            minim_method (str, optional): how is computed the minimal automaton. Valid values are "brzozowski", "incremental" and "determinize_quotient". Defaults to "determinize_quotient".
             quotient_method (str, optional): which algorithm to use to compute the quotient.  Valid values are "moore" and "hopcroft".  Defaults to "moore".  Only meaningful if <minim_method> is "determinize_quotient".
 
         Returns: an Automaton
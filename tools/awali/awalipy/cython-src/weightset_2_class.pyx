@@ -73,7 +73,7 @@ cdef class WeightSet:
 
     Description:  builds a WeightSet from a string representation of it.
 
-    Argument:  ws (str), valid values include \"B\", \"Z\", \"Z-min-plus\", \"Z/<n>Z\", \"Q\"
+    Argument:  ws (str), valid values include \"B\", \"Z\", \"Z-min-plus\", \"Z/<n>Z\", \"Q\", \"Z64\", \"Q64\"
 
     See:  function `awalipy.available_weighsets()` for a complete list of available weightsets.
     """
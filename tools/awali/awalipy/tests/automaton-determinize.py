@@ -58,6 +58,14 @@ class AutomatonDeterminizeTests(unittest.TestCase):
       self.assertTrue(B_det.is_deterministic())
       self.assertTrue(vr.are_equivalent(B_det, B))
 
+  def test_04_parallel(self):
+    auts= [vr.make_ladybird(i) for i in range(1,6)]
+    ops= [A.determinize for A in auts] + [(A.eval, "abc") for A in auts]
+    results= vr.run_in_parallel(ops, max_workers=3)
+    for i in range(5):
+      self.assertTrue(vr.are_isomorphic(results[i], auts[i].determinize()))
+      self.assertEqual(results[5+i], auts[i].eval("abc"))
+
 
 sys.stderr.write(
     "\n"
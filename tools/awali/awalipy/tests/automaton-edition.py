@@ -14,7 +14,7 @@
 # You should have received a copy of the GNU General Public License
 # along with this program. If not, see <http://www.gnu.org/licenses/>.
 
-import unittest, sys
+import unittest, sys, array
 import semiring
 import awalipy as vr
 
@@ -288,6 +288,47 @@ class AutomatonEditionTests(unittest.TestCase):
         self.assertEqual(vr.transitions(B), [])
         self.assertAutomatonSynctacticEquality(A,B)
 
+    def test_09_transition_table(self):
+        src = array.array('i', [0, 0, 1, 2])
+        dst = array.array('i', [1, 2, 2, 0])
+        label = array.array('i', [0, 1, 1, 0])
+        weight = array.array('d', [1, 1, 1, 1])
+        if semiring.name == 'Q':
+            with self.assertRaises(ValueError):
+                vr.make_automaton_from_arrays('ab', 3, src, dst, label,
+                                              weight, [0], [2], 'Q')
+        if semiring.name not in ['B', 'Z', 'R']:
+            return
+        E = vr.make_automaton_from_arrays('ab', 3, src, dst, label, weight,
+                                          [0], [2], semiring.name)
+        self.assertEqual(E.states(), [0,1,2])
+        self.assertEqual(E.num_transitions(), 4)
+        self.assertTrue(E.has_transition(1, 2, 'b'))
+        self.assertTrue(E.is_initial(0))
+        self.assertTrue(E.is_final(2))
+        (s, d, l, w) = E.transition_table()
+        self.assertEqual(sorted(zip(s, d, l)), sorted(zip(src, dst, label)))
+        self.assertEqual(list(w), [1.0]*4)
+        self.assertEqual(memoryview(s).format, 'i')
+        E.add_transition_table(array.array('i', [s[0]]), array.array('i', [d[0]]),
+                               array.array('i', [l[0]]))
+        self.assertEqual(E.num_transitions(), 4)
+        w = E.transition_table()[3]
+        with self.assertRaises(IndexError):
+            E.add_transition_table(src, dst, array.array('i', [0, 0, 2, 0]))
+        self.assertEqual(E.num_transitions(), 4)
+        self.assertEqual(list(E.transition_table()[3]), list(w))
+        if semiring.name != 'R':
+            with self.assertRaises(ValueError):
+                E.add_transition_table(src, dst, label,
+                                       array.array('d', [1, 1, 1, 2.5]))
+            self.assertEqual(list(E.transition_table()[3]), list(w))
+        if semiring.name == 'B':
+            with self.assertRaises(ValueError):
+                E.add_transition_table(src, dst, label,
+                                       array.array('d', [1, 1, 1, 2]))
+            self.assertEqual(E.num_transitions(), 4)
+
 
     #def test_99_rerun_all_with_lowercase_weightset(self):
         #global A, B
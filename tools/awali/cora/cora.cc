@@ -21,9 +21,18 @@
 
 #include<dirent.h>
 #include<fstream>
+#include<glob.h>
 #include<sstream>
 #include<map>
 #include<stdexcept>
+#include<chrono>
+#include<csignal>
+#include<cstring>
+#include<sys/resource.h>
+#include<sys/socket.h>
+#include<sys/stat.h>
+#include<sys/un.h>
+#include<unistd.h>
 
 namespace awali {
 namespace cora {
@@ -62,6 +71,24 @@ bool first_cmd = true; //to know whether - is the real standard input
 
 arg_kind_t final_output;
 
+// server mode: the automata and ratexps kept in memory between command
+// lines; they are referred to as @<name>
+bool serving = false;
+std::map<std::string, aut_or_exp_t> resident_objects;
+
+bool is_resident(std::string const& s)
+{
+  return serving && s.size() > 1 && s[0] == '@';
+}
+
+aut_or_exp_t const& resident(std::string const& s)
+{
+  auto it = resident_objects.find(s.substr(1));
+  if (it == resident_objects.end())
+    throw std::runtime_error("No automaton or ratexp named " + s + ".");
+  return it->second;
+}
+
 /* ---------------------------------------|
 |  Search in list functions               |
 |----------------------------------------*/
@@ -122,7 +149,8 @@ bool found_in_option_list(const std::string& s, //std::vector<T>& list,
 #include <cora/print_out/print_out.cc> 
 
 // function output takes care of the result of the function called by cora
-void output()
+// and returns the exit status of cora
+int output()
 {
   switch(final_output) {
   case AUT:
@@ -138,7 +166,7 @@ void output()
     }
 	std::string nm = res->get_name();
     dyn::put(res, std::cout, opts) << std::endl;
-    return;
+    return EXIT_SUCCESS;
   }
   case EXP:
     if(output_format == "json")
@@ -151,19 +179,19 @@ void output()
         std::cerr << output_format
                   << " : unknown output format for ratexp."
                   << std::endl;
-    return;
+    return EXIT_SUCCESS;
   case BOOL:
     if(verbose)
       std::cout << std::boolalpha << boolean << std::endl;
     if (shell)
-      exit(!boolean);
-    return;
+      return !boolean;
+    return EXIT_SUCCESS;
   case INT:
     if (verbose)
       std::cout << count << std::endl;
     if (shell)
-      exit(count);
-    return;
+      return count;
+    return EXIT_SUCCESS;
   case WEIGHT:
     try {
       boolean = (bool) weight;
@@ -184,32 +212,32 @@ void output()
     }
     catch (dyn::any_cast_exception const&) {}
     std::cout << weight << std::endl;
-    return;
+    return EXIT_SUCCESS;
   case WORD: //No such command right now
-    return;
+    return EXIT_SUCCESS;
   case CMD: //No such command right now
-    return;
+    return EXIT_SUCCESS;
   case SMR: //No such command right now
-    return;
+    return EXIT_SUCCESS;
   case LBL: //No such command right now
-    return;
+    return EXIT_SUCCESS;
   case ALPH: //No such command right now
-    return;
+    return EXIT_SUCCESS;
   case FMT: //No such command right now
-    return;
+    return EXIT_SUCCESS;
   case MTD: //No such command right now
-    return;
+    return EXIT_SUCCESS;
   case STR: //No such command right now
-    return;
+    return EXIT_SUCCESS;
   case CHC:
-    return;
+    return EXIT_SUCCESS;
   case AUT_OR_EXP: // Fixme: NOT USED BUT SHOULD BE
-    return;
+    return EXIT_SUCCESS;
   case NONE:
-    return;
+    return EXIT_SUCCESS;
   }
 
-  return;
+  return EXIT_SUCCESS;
 } // end of output
 
 
@@ -220,6 +248,12 @@ void output()
 // load_exp    load expression
 dyn::ratexp_t load_exp(std::string s, bool warn_if_word = true)
 {
+  if (is_resident(s)) {
+    aut_or_exp_t const& aoe = resident(s);
+    if (aoe.is_aut)
+      throw std::runtime_error(s + " is not a ratexp.");
+    return aoe.exp;
+  }
   static const std::vector<std::string> formats
     = {"json", "default", "text", "exp"};
   {
@@ -427,6 +461,15 @@ dyn::internal::aut_or_exp_t normalize_aoe_context(
 // load    load automaton
 dyn::automaton_t load(std::string s)
 {
+  // commands may modify their argument in place: the resident automaton
+  // is copied
+  if (is_resident(s)) {
+    aut_or_exp_t const& aoe = resident(s);
+    if (!aoe.is_aut)
+      throw std::runtime_error(s + " is not an automaton.");
+    no_user_file = true;
+    return dyn::copy(aoe.aut, {dyn::KEEP_HISTORY=true});
+  }
   if(s=="-") {
     no_user_file = true;
     if(first_cmd)
@@ -443,6 +486,11 @@ dyn::automaton_t load(std::string s)
 // load    load automaton OR expression
 aut_or_exp_t load_aut_or_exp(std::string s, bool warn_if_word)
 {
+  if (is_resident(s)) {
+    if (resident(s).is_aut)
+      return load(s);
+    return load_exp(s);
+  }
   if (s == "-" && !first_cmd) {
     if (final_output == EXP)
       return load_exp(s);
@@ -568,23 +616,12 @@ void process_option(const char* opt)
 }
 
 //// main  inside namespace awali::cora
-int main(int argc, const char** argv)
+// run    executes the command line argv[1..argc-1]; the result of the last
+//        command is printed by output() if print is true.
+//        Returns the exit status of cora.
+int run(int argc, const char** argv, bool print = true)
 {
-
-// initialisation of command lists and other things
-  init_cmds(); // in cora.hh
-  init_lists(); // in cora_lists.hh
-  init_options(); // in cora_options.hh
 // reading the arguments
-// call of cora without argument: error message
-  if (argc==1) {
-    std::string error_msg1 = "Please enter an Awali command.";
-    std::string error_msg2 = "Type 'cora help' if necessary.";
-    error_print(error_msg1, error_msg2);
-    return 1;
-  }
-
-// call of cora with arguments: reading the arguments
   int i=1;
   do {  // large do loop  that  covers almost all the main function
     // every run of the loop processes a chunk of the command line
@@ -608,8 +645,13 @@ int main(int argc, const char** argv)
       if(argv[i][0]=='-' && argv[i][1]!='\0'
           && (argv[i][1]<'0' || argv[i][1]>'9'))
         process_option(argv[i]);
-      else
+      else {
+        if (j == sizeof(args)/sizeof(args[0])) {
+          error_print("Too many arguments.");
+          return 1;
+        }
         args[j++]=argv[i];
+      }
     }
     if(i<argc)
       ++i; // preparation for the next run inside the do loop, if any.
@@ -691,6 +733,11 @@ int main(int argc, const char** argv)
 /* ---------------------------------------|
 |  Basic commands                         |
 |----------------------------------------*/
+// SERVE
+      case SERVE :
+      case RUN :
+        throw std::runtime_error(std::string(args[0])
+                                 + " must be the only command.");
 // LIST
       case LIST :
         list(args[1]);
@@ -1091,14 +1138,15 @@ int main(int argc, const char** argv)
       // condensation
       case CONDENSATION :
         arg1=load(args[1]);
-        res = dyn::condensation(arg1);
+        res = dyn::condensation(arg1, {dyn::SCC_ALGO=algo});
         final_output= AUT;
         break;
       // is-strongly-connected
       case IS_SC :
         arg1=load(args[1]);
         boolean = 
-          (1 == dyn::strongly_connected_components(arg1).partition.size());
+          (1 == dyn::strongly_connected_components(arg1, {dyn::SCC_ALGO=algo})
+                .partition.size());
         final_output= BOOL;
         break;
 
@@ -1727,20 +1775,14 @@ int main(int argc, const char** argv)
             dyn::factor(arg1, {dyn::IN_PLACE=true});
             break;
           case COMPLEMENT :
-            if (!dyn::is_deterministic(arg1)) {
-              // The message sent by dyn/bridge/determinize.cc refers to 
-              // complement_here, which is meaningless for cora users
-              std::string error_msg1 = args[0];
-              error_msg1 = "'" + error_msg1 
-                 + "' is a command for deterministic Boolean automata only.";
-              std::string error_msg2 = "Type 'cora help complement' if necessary.";
-              error_print(error_msg1, error_msg2);
-              return 2;
-            }
-            else {
+            if (algo == "minimal" || !dyn::is_deterministic(arg1)
+                || !dyn::is_complete(arg1))
+              // Determinization, completion and complementation at once.
+              arg1 = dyn::complement_nfa(arg1,
+                                         {dyn::MINIMIZE=(algo == "minimal")});
+            else
               dyn::complement(arg1, {dyn::IN_PLACE=true});
-              break;
-            }
+            break;
           default :
             break;
           }
@@ -2009,19 +2051,19 @@ int main(int argc, const char** argv)
 //  std::cerr << "command " << it->name <<": error: " << e.what() << std::endl;
       std::string msg = " In command " + it->name + " : " + e.what();
       error_print(msg);
-      std::exit(EXIT_FAILURE);
+      return EXIT_FAILURE;
     }
     catch(const std::domain_error& e) {// call centralised error message print
       std::string msg = " In command " + it->name + " : " + e.what();
       std::string err_typ = "Domain error";
       x_error_print(msg, err_typ);
-      std::exit(EXIT_FAILURE);
+      return EXIT_FAILURE;
     }
     catch(const std::invalid_argument& e) {// call centralised error message print
       std::string msg = " In command " + it->name + " : " + e.what();
       std::string err_typ = "Invalid argument error";
       x_error_print(msg, err_typ);
-      std::exit(EXIT_FAILURE);
+      return EXIT_FAILURE;
     }
 //     catch(const parse_exception& e) {// call centralised error message print
 //       std::string msg = " In command " + it->name + " : " + e.what();
@@ -2036,8 +2078,35 @@ int main(int argc, const char** argv)
   }
   while(i!=argc);    // end of the do loop
   //
-  output();
+  if (print)
+    return output();
   return EXIT_SUCCESS;
+} // end of  run
+
+#include <cora/serve.cc>
+#include <cora/emp.cc>
+
+int main(int argc, const char** argv)
+{
+
+// initialisation of command lists and other things
+  init_cmds(); // in cora.hh
+  init_lists(); // in cora_lists.hh
+  init_options(); // in cora_options.hh
+// call of cora without argument: error message
+  if (argc==1) {
+    std::string error_msg1 = "Please enter an Awali command.";
+    std::string error_msg2 = "Type 'cora help' if necessary.";
+    error_print(error_msg1, error_msg2);
+    return 1;
+  }
+// server mode: the command lines are read on stdin or on a socket
+  if (std::string(argv[1]) == "serve")
+    return serve(argc, argv);
+// interpreter of emp programs
+  if (std::string(argv[1]) == "run")
+    return run_emp(argc, argv);
+  return run(argc, argv);
 } // end of  main  in namespace awali::cora
 
 }
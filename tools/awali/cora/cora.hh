@@ -50,7 +50,7 @@ enum coms_t {
   MPTY_CMD,
 ////  Basic commands
   HELP,
-  LIST, DOC, CAT, DISPLAY, INFO, STATS, EDIT, NEW, IS,
+  LIST, DOC, CAT, DISPLAY, INFO, STATS, EDIT, NEW, IS, SERVE, RUN,
 ////  Generic commands for automata and transducers
 // Graph traversal functions
   ACC, COACC, TRIM, IS_EMPTY, IS_ACC, IS_COACC, IS_TRIM, IS_USELESS,
@@ -313,6 +313,20 @@ void init_cmds()
             "[-O -W -L -A -B]",
             awali::cora::doc::new_
     });
+// serve
+  commands_basic.emplace_back(
+    command{"serve", SERVE, 0, {},
+            "Executes command lines read on stdin or on a socket",
+            "[<socket>]",
+            awali::cora::doc::serve
+    });
+// run
+  commands_basic.emplace_back(
+    command{"run", RUN, 0, {},
+            "Runs an emp program on input automata and reports timings",
+            "[-I<input-fmt>] [-O<output-fmt>] <program> <input>...",
+            awali::cora::doc::run
+    });
 
 // skipped line in the help list
   commands_basic.emplace_back(empty_cmd);
@@ -479,14 +493,14 @@ void init_cmds()
   commands_generic.emplace_back(
   command{"condensation", CONDENSATION, 1, {{AUT}},
     "reduces each strongly connected component to a single state",
-    "",
+    "[-M<method>]",
     awali::cora::doc::condensation
   });
   // is-strongly-connected
   commands_inv.emplace_back(
   command{"is-strongly-connected", IS_SC, 1, {{AUT}},
     "tests whether an automaton is strongly connected",
-    "",
+    "[-M<method>]",
     awali::cora::doc::is_strongly_connected
   });
 
@@ -905,11 +919,11 @@ void init_cmds()
     "",
     awali::cora::doc::determinize
   });
-  // complement     //// FIX ME   look at the prerequisite
+  // complement
   commands_nfa.emplace_back(
   command{"complement", COMPLEMENT, 1, {{AUT}},
-    "complements a complete DFA",
-    "",
+    "complements a Boolean automaton",
+    "[-Mminimal]",
     awali::cora::doc::complement
   });
 
@@ -0,0 +1,515 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+/* ---------------------------------------------------|
+|  Called from cora.cc as fake modularisation         |
+|----------------------------------------------------*/
+
+/* ---------------------------------------|
+|  Interpreter of emp programs            |
+|----------------------------------------*/
+
+// An emp program is a sequence of statements, one per line:
+//     load_automaton <name>      binds <name> to the next input file
+//     load_automata <name>       binds <name> to all the remaining inputs
+//     <name> = (<op> <arg>...)   binds <name> to the result of <op>
+//     (<op> <arg>...)            outputs the result of <op>
+// The parentheses are optional and '#' starts a comment.  The input
+// arguments may be glob patterns; the input automata are loaded in parallel.
+// Only the statements on which an output depends are executed; every
+// executed statement is reported, with its wall time, the peak memory and
+// the size of its result, in a JSON document written on the standard error.
+
+struct emp_operation_t {
+  std::string name;
+  unsigned min_args;
+  unsigned max_args; // 0 if unbounded
+  bool is_predicate;
+};
+
+const std::vector<emp_operation_t> emp_operations = {
+  {"load_automaton", 0, 0, false},
+  {"load_automata", 0, 0, false},
+  {"inter", 2, 0, false},
+  {"union", 2, 0, false},
+  {"concat", 2, 0, false},
+  {"compl", 1, 1, false},
+  {"interall", 1, 0, false},
+  {"unionall", 1, 0, false},
+  {"incl", 2, 2, true},
+  {"is_empty", 1, 1, true}
+};
+
+struct emp_statement_t {
+  unsigned line;
+  std::string target;               // empty for outputs
+  emp_operation_t const* op;
+  std::vector<std::string> args;
+  std::vector<std::string> inputs;  // files of the load statements
+  bool live = false;
+};
+
+emp_operation_t const* find_emp_operation(std::string const& name)
+{
+  for (emp_operation_t const& op : emp_operations)
+    if (op.name == name)
+      return &op;
+  return nullptr;
+}
+
+std::string emp_error(std::string const& program, unsigned line,
+                      std::string const& msg)
+{
+  return program + ":" + std::to_string(line) + ": " + msg;
+}
+
+// parse_emp    parses <program>; the input files are assigned to the load
+//              statements in order.
+std::vector<emp_statement_t>
+parse_emp(std::string const& program, std::vector<std::string> const& inputs)
+{
+  std::ifstream fin(program);
+  if (!fin)
+    throw std::runtime_error("Cannot open program " + program);
+  std::vector<emp_statement_t> statements;
+  std::set<std::string> defined;
+  size_t next_input = 0;
+  std::string text;
+  for (unsigned line = 1; std::getline(fin, text); ++line) {
+    text = text.substr(0, text.find('#'));
+    for (char& c : text)
+      if (c == '(' || c == ')')
+        c = ' ';
+    std::istringstream words(text);
+    std::vector<std::string> w;
+    for (std::string s; words >> s; )
+      w.push_back(s);
+    if (w.empty())
+      continue;
+    emp_statement_t st;
+    st.line = line;
+    if (w.size() >= 2 && w[1] == "=") {
+      st.target = w[0];
+      w.erase(w.begin(), w.begin() + 2);
+      if (w.empty())
+        throw std::runtime_error(emp_error(program, line, "missing operation"));
+    }
+    st.op = find_emp_operation(w[0]);
+    if (st.op == nullptr)
+      throw std::runtime_error(emp_error(program, line,
+                                         "unknown operation " + w[0]));
+    st.args.assign(w.begin() + 1, w.end());
+    if (st.op->name == "load_automaton" || st.op->name == "load_automata") {
+      if (st.target.empty() && st.args.size() == 1) {
+        st.target = st.args[0];
+        st.args.clear();
+      }
+      if (st.target.empty() || !st.args.empty())
+        throw std::runtime_error(emp_error(program, line, "usage: "
+                                           + st.op->name + " <name>"));
+      if (defined.count(st.target) != 0)
+        throw std::runtime_error(emp_error(program, line, st.target
+                                           + " is already defined"));
+      if (next_input == inputs.size())
+        throw std::runtime_error(emp_error(program, line,
+                                           "not enough input files"));
+      if (st.op->name == "load_automaton")
+        st.inputs.push_back(inputs[next_input++]);
+      else
+        while (next_input < inputs.size())
+          st.inputs.push_back(inputs[next_input++]);
+    }
+    else {
+      if (st.args.size() < st.op->min_args
+          || (st.op->max_args != 0 && st.args.size() > st.op->max_args))
+        throw std::runtime_error(emp_error(program, line, "wrong number of "
+                                           "arguments for " + st.op->name));
+      if (st.op->is_predicate && !st.target.empty())
+        throw std::runtime_error(emp_error(program, line, st.op->name
+                                           + " does not produce an automaton"));
+      for (std::string const& a : st.args)
+        if (defined.count(a) == 0)
+          throw std::runtime_error(emp_error(program, line,
+                                             "undefined name " + a));
+    }
+    if (!st.target.empty())
+      defined.insert(st.target);
+    statements.push_back(std::move(st));
+  }
+  if (next_input < inputs.size())
+    throw std::runtime_error(program + ": " + std::to_string(inputs.size()
+                             - next_input) + " input file(s) not used");
+  return statements;
+}
+
+// eliminate_dead_statements    marks the statements on which an output
+//                              depends; if there is no output, the last
+//                              statement is considered as the output.
+void eliminate_dead_statements(std::vector<emp_statement_t>& statements)
+{
+  bool has_output = false;
+  for (emp_statement_t const& st : statements)
+    has_output |= st.target.empty();
+  std::set<std::string> needed;
+  for (size_t i = statements.size(); i-- > 0; ) {
+    emp_statement_t& st = statements[i];
+    st.live = st.target.empty() || needed.count(st.target) != 0
+              || (!has_output && i+1 == statements.size());
+    if (!st.live)
+      continue;
+    needed.erase(st.target);
+    for (std::string const& a : st.args)
+      needed.insert(a);
+  }
+}
+
+/* ---- Measures ---- */
+
+// On Linux, writing 5 in clear_refs resets the peak resident set size, so
+// that the peak of each operation is measured; otherwise the peak of the
+// process is reported.
+void reset_peak_memory()
+{
+  std::ofstream f("/proc/self/clear_refs");
+  if (f)
+    f << "5";
+}
+
+long peak_memory_kb()
+{
+  std::ifstream f("/proc/self/status");
+  std::string line;
+  while (std::getline(f, line))
+    if (line.compare(0, 6, "VmHWM:") == 0)
+      return std::stol(line.substr(6));
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+std::string json_string(std::string const& s)
+{
+  std::string r = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      r += '\\';
+    if (c == '\n')
+      r += "\\n";
+    else
+      r += c;
+  }
+  return r + '"';
+}
+
+struct emp_report_t {
+  std::ostringstream operations;
+  bool first = true;
+  long max_peak = 0;
+
+  // opens the record of an operation; the caller adds its result fields
+  std::ostream& record(unsigned line, std::string const& op,
+                       std::string const& target, double seconds, long peak)
+  {
+    operations << (first ? "\n    " : ",\n    ");
+    first = false;
+    max_peak = std::max(max_peak, peak);
+    operations << "{\"line\": " << line << ", \"op\": " << json_string(op);
+    if (!target.empty())
+      operations << ", \"target\": " << json_string(target);
+    operations << ", \"time_s\": " << seconds
+               << ", \"peak_rss_kb\": " << peak;
+    return operations;
+  }
+
+  std::ostream& record(emp_statement_t const& st, double seconds, long peak)
+  {
+    return record(st.line, st.op->name, st.target, seconds, peak);
+  }
+
+  void record_automaton(emp_statement_t const& st, double seconds, long peak,
+                        dyn::automaton_t aut)
+  {
+    record(st, seconds, peak) << ", \"states\": " << aut->num_states()
+                              << ", \"transitions\": "
+                              << aut->num_transitions() << '}';
+  }
+};
+
+/* ---- Execution ---- */
+
+// expand_glob    returns the files matching <pattern>, in alphabetical
+//                order; a name without wildcard is returned as it is.
+std::vector<std::string> expand_glob(std::string const& pattern)
+{
+  if (pattern.find_first_of("*?[") == std::string::npos)
+    return {pattern};
+  glob_t g;
+  if (glob(pattern.c_str(), 0, nullptr, &g) != 0) {
+    globfree(&g);
+    throw std::runtime_error("No file matches " + pattern);
+  }
+  std::vector<std::string> res(g.gl_pathv, g.gl_pathv + g.gl_pathc);
+  globfree(&g);
+  return res;
+}
+
+// check_not_mata    rejects the automata in the format of libmata (.mata
+//                   files, whose first line is a header like @NFA-explicit),
+//                   which cannot be read by Awali.
+void check_not_mata(std::string const& file)
+{
+  bool mata = file.size() > 5 && file.compare(file.size() - 5, 5, ".mata") == 0;
+  if (!mata) {
+    std::ifstream fin(file);
+    std::string line;
+    while (std::getline(fin, line)
+           && line.find_first_not_of(" \t\r") == std::string::npos)
+      ;
+    size_t i = line.find_first_not_of(" \t");
+    mata = i != std::string::npos && line.compare(i, 4, "@NFA") == 0;
+  }
+  if (mata)
+    throw std::runtime_error(file + ": the .mata format of libmata is not "
+                             "supported; convert the automaton to a format "
+                             "read by Awali (json, fado, grail) first.");
+}
+
+// load_all    loads the automata of <files> concurrently
+std::vector<dyn::automaton_t> load_all(std::vector<std::string> const& files)
+{
+  for (std::string const& f : files)
+    check_not_mata(f);
+  std::vector<dyn::automaton_t> auts
+    = dyn::load_all(files, {dyn::IO_FORMAT = input_format});
+  for (dyn::automaton_t& aut : auts)
+    aut = normalize_automaton_context(aut);
+  return auts;
+}
+
+using emp_env_t = std::map<std::string, std::vector<dyn::automaton_t>>;
+
+// check_emp_inputs    checks that the input automata are Boolean automata
+//                     over letters and extends their alphabets to the union
+//                     of the alphabets, so that complements are taken with
+//                     respect to the same alphabet.
+void check_emp_inputs(emp_env_t& env)
+{
+  std::set<char> chars;
+  std::set<int> ints;
+  bool has_char = false, has_int = false;
+  for (auto const& p : env)
+    for (dyn::automaton_t aut : p.second) {
+      if (aut->is_transducer()
+          || aut->get_context()->weightset_name() != "B")
+        throw std::runtime_error(p.first + ": Boolean automaton expected");
+      for (dyn::any_t l : aut->alphabet()) {
+        if (aut->is_int_automaton())
+          ints.insert((int) l);
+        else
+          chars.insert((char) l);
+      }
+      (aut->is_int_automaton() ? has_int : has_char) = true;
+    }
+  if (has_int && has_char)
+    throw std::runtime_error("The input automata have different types of "
+                             "letters.");
+  for (auto& p : env)
+    for (dyn::automaton_t aut : p.second) {
+      if (has_int) {
+        std::set<int> alphabet;
+        for (dyn::any_t l : aut->alphabet())
+          alphabet.insert((int) l);
+        if (alphabet != ints)
+          dyn::change_int_alphabet(aut, ints);
+      }
+      else {
+        std::set<char> alphabet;
+        for (dyn::any_t l : aut->alphabet())
+          alphabet.insert((char) l);
+        if (alphabet != chars)
+          dyn::change_alphabet(aut, std::string(chars.begin(), chars.end()));
+      }
+    }
+}
+
+dyn::automaton_t emp_fold(std::vector<dyn::automaton_t> const& auts,
+                          std::string const& op)
+{
+  dyn::options_t opts = {dyn::KEEP_HISTORY = false};
+  dyn::automaton_t res = auts[0];
+  // Once res is an intermediate result, nothing else refers to it: like
+  // a copy-on-write handle, it is then extended in place, not copied.
+  bool owned = false;
+  if (op == "concat") {
+    res = dyn::standard(res);
+    owned = true;
+  }
+  for (size_t i = 1; i < auts.size(); ++i) {
+    if (op == "inter" || op == "interall")
+      res = dyn::product(res, auts[i], opts);
+    else if (op == "union" || op == "unionall")
+      res = dyn::sum(res, auts[i], {dyn::IN_PLACE = owned});
+    else // concat
+      res = dyn::concatenate(res, dyn::standard(auts[i]),
+                             {dyn::IN_PLACE = owned});
+    owned = true;
+  }
+  return res;
+}
+
+// run_emp    entry point of 'cora run <program> <input>...'
+int run_emp(int argc, const char** argv)
+{
+  std::vector<std::string> files;
+  try {
+    for (int i = 2; i < argc; ++i) {
+      if (argv[i][0] == '-' && argv[i][1] != '\0')
+        process_option(argv[i]);
+      else if (files.empty())
+        files.push_back(argv[i]); // the program
+      else
+        for (std::string const& f : expand_glob(argv[i]))
+          files.push_back(f);
+    }
+    if (files.empty()) {
+      std::string error_msg1 = "Usage : run <program> <input>...";
+      std::string error_msg2 = "Type 'cora help run' for more information.";
+      error_print(error_msg1, error_msg2);
+      return 1;
+    }
+    std::string program = files[0];
+    files.erase(files.begin());
+    std::vector<emp_statement_t> statements = parse_emp(program, files);
+    eliminate_dead_statements(statements);
+
+    // the last statement which uses each name
+    std::map<std::string, size_t> last_use;
+    for (size_t i = 0; i < statements.size(); ++i)
+      if (statements[i].live)
+        for (std::string const& a : statements[i].args)
+          last_use[a] = i;
+
+    using clock = std::chrono::steady_clock;
+    auto seconds = [](clock::time_point t) {
+      return std::chrono::duration<double>(clock::now() - t).count();
+    };
+    clock::time_point start = clock::now();
+    emp_report_t report;
+    emp_env_t env;
+    // All the input automata are loaded first, in parallel; their
+    // alphabets are unified before any computation.
+    std::vector<std::string> input_files;
+    for (emp_statement_t const& st : statements)
+      if (st.live)
+        input_files.insert(input_files.end(), st.inputs.begin(),
+                           st.inputs.end());
+    if (!input_files.empty()) {
+      reset_peak_memory();
+      clock::time_point t = clock::now();
+      std::vector<dyn::automaton_t> auts = load_all(input_files);
+      double s = seconds(t);
+      size_t states = 0, transitions = 0;
+      for (dyn::automaton_t aut : auts) {
+        states += aut->num_states();
+        transitions += aut->num_transitions();
+      }
+      report.record(0, "load", "", s, peak_memory_kb())
+        << ", \"files\": " << input_files.size()
+        << ", \"states\": " << states
+        << ", \"transitions\": " << transitions << '}';
+      auto it = auts.begin();
+      for (emp_statement_t const& st : statements)
+        if (st.live && !st.inputs.empty()) {
+          env[st.target].assign(it, it + st.inputs.size());
+          it += st.inputs.size();
+        }
+    }
+    check_emp_inputs(env);
+    for (size_t i = 0; i < statements.size(); ++i) {
+      emp_statement_t const& st = statements[i];
+      if (!st.live || !st.inputs.empty())
+        continue;
+      std::vector<dyn::automaton_t> args;
+      for (std::string const& a : st.args) {
+        std::vector<dyn::automaton_t> const& v = env.at(a);
+        args.insert(args.end(), v.begin(), v.end());
+      }
+      if (args.size() < st.op->min_args
+          || (st.op->max_args != 0 && args.size() > st.op->max_args))
+        throw std::runtime_error(emp_error(program, st.line, "wrong number of "
+                                           "automata for " + st.op->name));
+      std::string const& op = st.op->name;
+      reset_peak_memory();
+      clock::time_point t = clock::now();
+      if (st.op->is_predicate) {
+        bool b;
+        if (op == "is_empty")
+          b = dyn::is_useless(args[0]);
+        else // incl
+          b = dyn::is_useless(dyn::product(args[0],
+                                           dyn::complement_nfa(args[1]),
+                                           {dyn::KEEP_HISTORY = false}));
+        double s = seconds(t);
+        report.record(st, s, peak_memory_kb())
+          << ", \"result\": " << (b ? "true" : "false") << '}';
+        std::cout << (b ? "true" : "false") << std::endl;
+      }
+      else {
+        dyn::automaton_t res;
+        if (op == "compl")
+          res = dyn::complement_nfa(args[0], {dyn::KEEP_HISTORY = false});
+        else
+          res = emp_fold(args, op);
+        double s = seconds(t);
+        report.record_automaton(st, s, peak_memory_kb(), res);
+        if (st.target.empty())
+          dyn::put(res, std::cout, {dyn::IO_FORMAT = output_format})
+            << std::endl;
+        else
+          env[st.target] = {res};
+      }
+      // the automata which are not used any more are freed
+      for (std::string const& a : st.args)
+        if (last_use[a] == i && a != st.target)
+          env.erase(a);
+    }
+
+    std::cerr << "{\"program\": " << json_string(program)
+              << ",\n  \"operations\": [" << report.operations.str()
+              << "\n  ],\n  \"eliminated\": [";
+    bool first = true;
+    for (emp_statement_t const& st : statements)
+      if (!st.live) {
+        std::cerr << (first ? "" : ", ") << st.line;
+        first = false;
+      }
+    std::cerr << "],\n  \"total_time_s\": " << seconds(start)
+              << ",\n  \"peak_rss_kb\": ";
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::cerr << std::max(report.max_peak, (long) usage.ru_maxrss) << "\n}"
+              << std::endl;
+  }
+  catch (const std::runtime_error& e) {
+    error_print(e.what());
+    return EXIT_FAILURE;
+  }
+  catch (const std::domain_error& e) {
+    error_print(e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -445,6 +445,63 @@ Option -B chooses the alphabet of the second tape (transducer only) -Bab (defaul
 )---"
 };
 
+std::string serve {
+R"---(Read command lines, one per line, and execute them in the same process,
+so that the modules are loaded only once.  The command lines are read on
+the standard input, or on the Unix domain socket )---"
+
+"" + arg_clr + "<socket>" + reset_clr + R"---( if it is given.  A socket left
+at this path by a previous server is replaced; any other existing file makes
+the command fail.
+
+A command line has the same syntax as the arguments of cora, without the
+leading 'cora'.  The line
+    <name> = <command line>
+keeps the automaton or ratexp computed by the command line in memory, under
+the name @<name>; it can then be used as argument of the next command lines.
+
+Besides, the following commands are available in this mode:
+    names              lists the automata and ratexps kept in memory;
+    drop <name>...     removes them from memory;
+    quit               stops the server.
+
+The reply to each command line is its output, followed by a line
+    @status <n>
+where <n> is the exit status that cora would have returned.
+)---"
+};
+
+std::string run {
+R"---(Run the emp program )---"
+"" + arg_clr + "<program>" + reset_clr + R"---( on the automata )---"
+"" + arg_clr + "<input>..." + reset_clr + R"---(.
+
+An emp program is a sequence of statements, one per line:
+    load_automaton <name>      binds <name> to the next input automaton;
+    load_automata <name>       binds <name> to all the remaining inputs;
+    <name> = (<op> <arg>...)   binds <name> to the result of <op>;
+    (<op> <arg>...)            outputs the result of <op>.
+The parentheses are optional and '#' starts a comment.  The operations are
+    inter, union, concat   on two automata or more;
+    interall, unionall     on any number of automata;
+    compl                  complement;
+    incl A B               whether the language of A is included in the one
+                           of B;
+    is_empty               whether the language is empty.
+The inputs may be given as glob patterns, like 'dir/instance-*.json'; they
+are loaded in parallel before any computation.  The input automata must be
+Boolean; their alphabets are extended to the union of the alphabets.  The
+.mata format of libmata is not supported.
+
+Only the statements on which an output depends are executed.  The outputs
+are written on the standard output.  A report, in JSON, is written on the
+standard error: for each executed statement, it gives the wall time, the
+peak resident memory and the size of the result; the loading of all the
+inputs is reported as a single operation 'load'.  The time of the first
+use of an operation may include the compilation of its module.
+)---"
+};
+
 std::string is {
 R"---()---"
 };
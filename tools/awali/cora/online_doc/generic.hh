@@ -187,11 +187,17 @@ Computes the strongly connected components and merge every connected component
 into a single state.
 
 (Use -H option with "display" to see which states were merged.)
+
+Option -M allows to choose the algorithm: 'tarjan-iterative' (default),
+'tarjan-recursive', or 'forward-backward'; the latter runs in parallel on all
+cores and is meant for very large automata.
 )---"
 };
 
 std::string is_strongly_connected {
 R"---(Tests whether the automaton <aut> is strongly connected.
+
+Option -M allows to choose the algorithm, as for "condensation".
 )---"
 };
 
@@ -483,7 +489,8 @@ A warning message is output if <aut> is already proper.
 std::string aut_to_exp {
 R"---(Converts an automaton into a ratexp with the state elimination method.
 
-Use with -M options : 'id-order' or 'min-inout-degree' (default) heuristics.
+Use with -M options : 'id-order', 'min-inout-degree' (default),
+'min-exp-size' or 'scc-min-inout-degree' heuristics.
 
 The 'id-order' heuristic consists in eliminating the states in the order of
 their id. An Awali user has no control on the id of a state and this option
@@ -498,6 +505,15 @@ if any, does not contribute to the in- and out-degrees). At every step of the
 procedure, the rank is computed again and the state chosen to be eliminated
 is the one with smallest rank in the lexicographic order (minimize  pd  and for
 equal  pd  take rather a state without loop).
+
+The 'min-exp-size' heuristic chooses the state whose elimination makes the
+expression grow the least: the sizes of the labels of the transitions which
+are created, minus the sizes of the labels of the transitions which are
+deleted.
+
+The 'scc-min-inout-degree' heuristic first eliminates the states of the
+strongly connected components with several states, component by component,
+then the other states; within each group, the 'min-inout-degree' rank is used.
 )---"
 };
 
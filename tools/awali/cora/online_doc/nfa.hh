@@ -73,8 +73,15 @@ In case of a weighted automaton, the result would be rather unpredictable.
 // };
 // 
 std::string complement {
-R"---(Complements the automaton <aut> which should be a complete and deterministic
-Boolean automaton.
+R"---(Complements the Boolean automaton <aut>.
+
+If <aut> is complete and deterministic, the final status of every state is
+swapped.  Otherwise, the result is a complete deterministic automaton built
+by a single subset construction, where the sink state and the final states are
+set on the fly, without computing the determinization of <aut>.
+
+If the '-Mminimal' option is set, the result is the minimal automaton of the
+complement.
 )---"
 };
 
@@ -105,16 +112,18 @@ automaton <aut> or denoted by the (Boolean) ratexp <exp>.
 The result may not be complete.
 	  
 In the case of a ratexp, the algorithm begins with the command 'exp-to-aut' 
-on <exp>, with the default option 'standard-and-quotient' which yields 
+on <exp>, with the default option 'derived-term' which yields 
 an <aut>.
 
 Option -M allows to choose the algorithm applied then to <aut>: 
-'moore' (default), 'hopcroft' or 'brzozowski'.
+'moore' (default), 'hopcroft', 'brzozowski' or 'incremental'.
 	  
 Both 'moore' and 'hopcroft' begin with the determinization of <aut>; then, 
 the minimal quotient of the result is computed by the corresponding algorithm.
 The 'brzozowski' algorithm is the sequence of transpose, determinization, 
 transpose, and determinisation.
+The 'incremental' algorithm merges equivalent states during the 
+determinization, so the whole deterministic automaton is never built.
 )---"
 };
 
@@ -144,7 +144,11 @@ it is modified (with commands 'characteristic' or 'promote').
 Choice among: 
 	  
 B, N, Z, Q, R, C, 
-F2, N-oo, Z-min-plus, Z-max-plus, R-max-prod, Fuzzy, Z/<int>Z, N<int>.         
+F2, N-oo, Z-min-plus, Z-max-plus, R-max-prod, Fuzzy, Z/<int>Z, N<int>,
+Z64, Q64.
+
+Z64 and Q64 compute on 64-bit integers and switch to arbitrary precision
+integers when a computation overflows.
 
 Default value: B (the Boolean semiring).                   
 
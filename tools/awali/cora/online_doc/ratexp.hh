@@ -71,12 +71,14 @@ The following methods are available in awali and yield the following automata:
 
 1. <glushov>=<standard>   the Glushkov (aka position, standard) automaton
 	  
-2. <derived-term>         the derived term (aka partial derivatives) automaton
+2. <derived-term>         is the default option;
+             the derived term (aka partial derivatives) automaton;
+             for expressions whose labels are not letters, it falls back
+             to <standard-and-quotient>
 	  
-3. <standard-and-quotient>   is the default option; 
-             it computes the minimal quotient of the standard automaton;
+3. <standard-and-quotient>   the minimal quotient of the standard automaton;
              it yields a small size automaton, often equal to the derived term 
-			 automaton, sometimes smaller, but often more efficiently.
+			 automaton, sometimes smaller.
 
 4. <breaking>                the broken derived term automaton
              this is a variant of the derived term automaton
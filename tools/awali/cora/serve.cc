@@ -0,0 +1,284 @@
+// This file is part of Awali.
+// Copyright 2016-2023 Sylvain Lombardy, Victor Marsault, Jacques Sakarovitch
+//
+// Awali is a free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+/* ---------------------------------------------------|
+|  Called from cora.cc as fake modularisation         |
+|----------------------------------------------------*/
+
+/* ---------------------------------------|
+|  Server mode                            |
+|----------------------------------------*/
+
+// In server mode, cora reads command lines, one per line, on the standard
+// input or on a Unix domain socket, and executes them in the same process:
+// the modules are loaded once and the automata or ratexps stored with
+//     <name> = <command line>
+// are kept in memory and can be used as @<name> in the next command lines.
+// Each reply is the output of the command line followed by the line
+//     @status <exit status of the command line>
+
+// split_command_line    splits <line> into words, like the shell does:
+//                       quotes group words and a backslash protects the
+//                       next character.
+std::vector<std::string> split_command_line(const std::string& line)
+{
+  std::vector<std::string> words;
+  std::string word;
+  bool in_word = false;
+  char quote = '\0';
+  for (size_t i = 0; i < line.size(); ++i) {
+    char c = line[i];
+    if (quote != '\0') {
+      if (c == quote)
+        quote = '\0';
+      else
+        word += c;
+    }
+    else if (c == '\'' || c == '"') {
+      quote = c;
+      in_word = true;
+    }
+    else if (c == '\\' && i+1 < line.size()) {
+      word += line[++i];
+      in_word = true;
+    }
+    else if (c == ' ' || c == '\t' || c == '\r') {
+      if (in_word)
+        words.push_back(word);
+      word.clear();
+      in_word = false;
+    }
+    else {
+      word += c;
+      in_word = true;
+    }
+  }
+  if (quote != '\0')
+    throw std::runtime_error("Unterminated quote.");
+  if (in_word)
+    words.push_back(word);
+  return words;
+}
+
+bool is_valid_resident_name(const std::string& s)
+{
+  if (s.empty())
+    return false;
+  for (char c : s)
+    if (!isalnum(c) && c != '_' && c != '-' && c != '.')
+      return false;
+  return true;
+}
+
+// Values of the options that are not reinitialised between the chunks of a
+// command line; they are reinitialised before each request.
+struct global_options_t {
+  std::string input_format = cora::input_format;
+  std::string output_format = cora::output_format;
+  bool shell = cora::shell;
+  bool verbose = cora::verbose;
+  bool history = cora::history;
+
+  void restore() const {
+    cora::input_format = input_format;
+    cora::output_format = output_format;
+    cora::shell = shell;
+    cora::verbose = verbose;
+    cora::history = history;
+  }
+};
+
+// serve_builtin    executes the commands proper to the server mode;
+//                  returns false if <words> is not such a command.
+bool serve_builtin(const std::vector<std::string>& words, int& status)
+{
+  if (words[0] == "names" && words.size() == 1) {
+    for (auto const& p : resident_objects)
+      std::cout << '@' << p.first << ' '
+                << (!p.second.is_aut ? "ratexp"
+                    : p.second.aut->is_transducer() ? "transducer"
+                    : "automaton") << std::endl;
+    status = EXIT_SUCCESS;
+    return true;
+  }
+  if (words[0] == "drop" && words.size() >= 2) {
+    status = EXIT_SUCCESS;
+    for (size_t i = 1; i < words.size(); ++i) {
+      std::string n = (words[i][0] == '@') ? words[i].substr(1) : words[i];
+      if (resident_objects.erase(n) == 0) {
+        error_print("No automaton or ratexp named @" + n + ".");
+        status = EXIT_FAILURE;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+// serve_request    executes the command line <line> and writes the reply
+//                  on <out>; returns false if the server should stop.
+bool serve_request(const std::string& line, std::ostream& out,
+                   global_options_t const& global_options)
+{
+  std::ostringstream captured;
+  std::streambuf* cout_buf = std::cout.rdbuf(captured.rdbuf());
+  std::streambuf* cerr_buf = std::cerr.rdbuf(captured.rdbuf());
+  int status = EXIT_SUCCESS;
+  bool go_on = true;
+  try {
+    std::vector<std::string> words = split_command_line(line);
+    std::string target;
+    if (words.size() >= 2 && words[1] == "=") {
+      target = (words[0][0] == '@') ? words[0].substr(1) : words[0];
+      if (!is_valid_resident_name(target))
+        throw std::runtime_error("Invalid name: " + words[0]);
+      words.erase(words.begin(), words.begin() + 2);
+    }
+    if (words.empty())
+      throw std::runtime_error("Please enter an Awali command.");
+    if (words[0] == "quit" && words.size() == 1 && target.empty())
+      go_on = false;
+    else if (!target.empty() || !serve_builtin(words, status)) {
+      global_options.restore();
+      final_output = NONE;
+      first_cmd = false; // '-' never refers to the standard input
+      std::vector<const char*> argv{"cora"};
+      for (std::string const& w : words)
+        argv.push_back(w.c_str());
+      status = run(argv.size(), argv.data(), target.empty());
+      if (status == EXIT_SUCCESS && !target.empty()) {
+        if (final_output == AUT || final_output == TDC)
+          resident_objects[target] = res;
+        else if (final_output == EXP)
+          resident_objects[target] = exp_res;
+        else
+          throw std::runtime_error("The command line produces neither an "
+                                   "automaton nor a ratexp.");
+        std::cout << '@' << target << std::endl;
+      }
+    }
+  }
+  catch (const std::exception& e) {
+    error_print(e.what());
+    status = EXIT_FAILURE;
+  }
+  std::cout.rdbuf(cout_buf);
+  std::cerr.rdbuf(cerr_buf);
+  if (go_on)
+    out << captured.str() << "@status " << status << std::endl;
+  return go_on;
+}
+
+// serve_socket    serves the clients connecting to the Unix domain socket
+//                 <path>, one after the other.
+int serve_socket(const std::string& path, global_options_t const& global_options)
+{
+  sockaddr_un addr;
+  if (path.size() >= sizeof(addr.sun_path))
+    throw std::runtime_error("Socket path too long: " + path);
+  // A socket left by a previous server is replaced; any other file is kept.
+  struct stat st;
+  if (lstat(path.c_str(), &st) == 0) {
+    if (!S_ISSOCK(st.st_mode))
+      throw std::runtime_error("Cannot listen on " + path
+                               + ": file exists and is not a socket");
+    if (unlink(path.c_str()) < 0)
+      throw std::runtime_error(std::string("Cannot remove ") + path + ": "
+                               + strerror(errno));
+  }
+  int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0)
+    throw std::runtime_error(std::string("socket: ") + strerror(errno));
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path.c_str());
+  if (bind(server, (sockaddr*) &addr, sizeof(addr)) < 0
+      || listen(server, 8) < 0) {
+    std::string msg = std::string("Cannot listen on ") + path + ": "
+                      + strerror(errno);
+    close(server);
+    throw std::runtime_error(msg);
+  }
+  // A client which disconnects must not kill the server.
+  signal(SIGPIPE, SIG_IGN);
+  bool go_on = true;
+  while (go_on) {
+    int client = accept(server, nullptr, nullptr);
+    if (client < 0) {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+    std::string pending;
+    char buf[4096];
+    ssize_t n;
+    while (go_on && (n = read(client, buf, sizeof(buf))) > 0) {
+      pending.append(buf, n);
+      size_t eol;
+      while (go_on && (eol = pending.find('\n')) != std::string::npos) {
+        std::string line = pending.substr(0, eol);
+        pending.erase(0, eol + 1);
+        if (line.find_first_not_of(" \t\r") == std::string::npos
+            || line[0] == '#')
+          continue;
+        std::ostringstream reply;
+        go_on = serve_request(line, reply, global_options);
+        std::string r = reply.str();
+        for (size_t done = 0; done < r.size(); ) {
+          ssize_t w = write(client, r.data() + done, r.size() - done);
+          if (w <= 0)
+            break;
+          done += w;
+        }
+      }
+    }
+    close(client);
+  }
+  close(server);
+  unlink(path.c_str());
+  return EXIT_SUCCESS;
+}
+
+// serve    entry point of 'cora serve [<socket>]'
+int serve(int argc, const char** argv)
+{
+  if (argc > 3) {
+    std::string error_msg1 = "Usage : serve [<socket>]";
+    std::string error_msg2 = "Type 'cora help serve' for more information.";
+    error_print(error_msg1, error_msg2);
+    return 1;
+  }
+  serving = true;
+  global_options_t global_options;
+  if (argc == 3) {
+    try {
+      return serve_socket(argv[2], global_options);
+    }
+    catch (const std::runtime_error& e) {
+      error_print(e.what());
+      return EXIT_FAILURE;
+    }
+  }
+  std::string line;
+  while (std::getline(std::cin, line)) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos
+        || line[0] == '#')
+      continue;
+    if (!serve_request(line, std::cout, global_options))
+      break;
+  }
+  return EXIT_SUCCESS;
+}